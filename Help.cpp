@@ -1,11 +1,95 @@
-#include "Help.h"
-
-qreal metersToQreal(double meters)
-{
-	return static_cast<qreal>(meters) * SCALE;
-}
-
-double qrealToMeters(qreal value)
-{
-	return static_cast<double>(value / SCALE);
-}
+#include "Help.h"
+#include <algorithm>
+
+qreal metersToQreal(double meters)
+{
+	return static_cast<qreal>(meters) * SCALE;
+}
+
+double qrealToMeters(qreal value)
+{
+	return static_cast<double>(value / SCALE);
+}
+
+int resolveConnectivity(std::vector<Core_of_Beam>& beams)
+{
+	int maxNode = -1;
+	for (size_t i = 0; i < beams.size(); ++i) {
+		Core_of_Beam& beam = beams[i];
+		if (beam.node_left < 0) beam.node_left = static_cast<int>(i);
+		if (beam.node_right < 0) beam.node_right = static_cast<int>(i) + 1;
+		maxNode = std::max({ maxNode, beam.node_left, beam.node_right, beam.gap_node });
+	}
+
+	// Зазор справа отделяет конец стержня от узла, к которому он примыкает:
+	// конец получает новый узел, прежний остается за соседом или опорой.
+	// Свободный конец без соседа и опоры не отделяется — зазору не во что упираться
+	std::vector<int> uses(maxNode + 1, 0);
+	for (const Core_of_Beam& beam : beams) {
+		uses[beam.node_left]++;
+		uses[beam.node_right]++;
+	}
+	for (Core_of_Beam& beam : beams) {
+		const Joint_info& joint = beam.Joint_right;
+		if (joint.gap < 0.0 || beam.gap_node >= 0) continue;
+		bool supported = joint.fixedSupport == 1 || joint.springStiffness > 0.0;
+		if (uses[beam.node_right] < 2 && !supported) continue;
+		beam.gap_node = beam.node_right;
+		beam.node_right = ++maxNode;
+	}
+	return maxNode + 1;
+}
+
+double barStiffness(const Core_of_Beam& beam)
+{
+	if (beam.section.isConstant()) {
+		return beam.mod_elasticity * beam.selectArea_A / beam.len_L;
+	}
+	SectionIntegrals integrals = integrateSection(beam.section, beam.mod_elasticity,
+		beam.selectArea_A, beam.len_L, LoadDistribution(), 0.0, beam.len_L);
+	return 1.0 / integrals.flexibility;
+}
+
+void barEquivalentLoads(const Core_of_Beam& beam, double& left, double& right)
+{
+	const LoadDistribution loads = beam.loads();
+	double L = beam.len_L;
+	double strain = beam.freeStrain();
+
+	if (beam.section.isConstant()) {
+		// Равномерная q дает q*L/2 на каждый узел; ε_T — пара сил ±EA·ε_T
+		double N_free = beam.mod_elasticity * beam.selectArea_A * strain;
+		left = loads.moment(L) / L - N_free;
+		right = loads.total(L) - left;
+		return;
+	}
+
+	SectionIntegrals integrals = integrateSection(beam.section, beam.mod_elasticity,
+		beam.selectArea_A, L, loads, 0.0, L);
+	double k = 1.0 / integrals.flexibility;
+	left = k * (integrals.loadIntegral - strain * L);
+	right = loads.total(L) - left;
+}
+
+void barMass(const Core_of_Beam& beam, bool lumped, double& m11, double& m12, double& m22)
+{
+	double rhoL = beam.density * beam.len_L;
+	if (beam.section.isConstant()) {
+		double m = rhoL * beam.selectArea_A;
+		m11 = m / 3.0;
+		m12 = m / 6.0;
+		m22 = m / 3.0;
+	}
+	else {
+		SectionMassMoments moments = sectionMassMoments(beam.section, beam.selectArea_A);
+		m11 = rhoL * moments.left;
+		m12 = rhoL * moments.coupled;
+		m22 = rhoL * moments.right;
+	}
+
+	if (lumped) {
+		m11 += m12;
+		m22 += m12;
+		m12 = 0.0;
+	}
+}
@@ -1,40 +1,104 @@
-﻿#pragma once
-#include <QtGlobal>
-#include <iostream>
-#include <vector>
-constexpr qreal SCALE = 150.0;
-
-qreal metersToQreal(double meters);
-
-double qrealToMeters(qreal value);
-
-struct Joint_info {
-    int fixedSupport; // 1 = exist, 0 = no exist
-    double lineLoad_q;
-    double force_f;
-};
-struct Core_of_Beam {
-    Joint_info Joint_left;
-    Joint_info Joint_right;
-
-    double len_L;
-    double selectArea_A;
-    double maxVoltage;
-    double mod_elasticity;
-};
-
-
-struct BeamResults {
-    int beamNum;
-    double E;              // Модуль упругости
-    double A;              // Площадь сечения
-    double L;              // Длина
-    double q;              // Распределенная нагрузка
-    double delta_left;     // Перемещение левого узла
-    double delta_right;    // Перемещение правого узла
-
-
-    std::vector<double> N_x; // Продольные силы N(x)
-    std::vector<double> U_x; // Перемещения u(x)
-    std::vector<double> sigma; // Напряжения σ(x)
+﻿#pragma once
+#include <QtGlobal>
+#include <iostream>
+#include <vector>
+#include "sectionProfile.h"
+constexpr qreal SCALE = 150.0;
+
+qreal metersToQreal(double meters);
+
+double qrealToMeters(qreal value);
+
+struct Joint_info {
+    int fixedSupport; // 1 = exist, 0 = no exist
+    double lineLoad_q;       // равномерная по всему стержню (для Joint_left)
+    double force_f;
+    double settlement = 0.0; // заданное перемещение опоры (осадка), м
+    double springStiffness = 0.0; // упругая опора узла на землю, Н/м; 0 — нет
+    double gap = -1.0;       // зазор до соседа справа (для Joint_right), м; < 0 — нет
+    LoadHistory forceHistory; // сила узла F(t), Н, в динамическом расчете; пусто — постоянная force_f
+};
+struct Core_of_Beam {
+    Joint_info Joint_left;
+    Joint_info Joint_right;
+
+    double len_L;
+    double selectArea_A;
+    double maxVoltage;
+    double mod_elasticity;
+
+    // Переменное сечение A(x); по умолчанию постоянное selectArea_A
+    SectionProfile section;
+
+    // Частичные и трапециевидные распределенные нагрузки, дополняют Joint_left.lineLoad_q
+    std::vector<LineLoad> lineLoads;
+
+    // Сосредоточенные силы внутри пролета; силы в узлах — в Joint_*.force_f
+    std::vector<PointLoad> pointLoads;
+
+    // Температурная и начальная деформации: свободное удлинение без напряжений
+    double thermalExpansion = 0.0;   // коэффициент линейного расширения α, 1/°C
+    double deltaT = 0.0;             // изменение температуры ΔT, °C
+    double initialStrain = 0.0;      // начальная деформация ε0 (натяг, усадка)
+
+    // Плотность материала ρ, кг/м³; нужна только для модального анализа
+    double density = 0.0;
+
+    // Билинейная диаграмма для упругопластического расчета: предел текучести —
+    // maxVoltage, после него модуль E_t < E; 0 — идеальная пластичность
+    double tangentModulus = 0.0;
+
+    // Узлы концов стержня; -1 — цепочка по порядку (стержень i между узлами i и i+1)
+    int node_left = -1;
+    int node_right = -1;
+
+    // Узел по другую сторону зазора справа; стержень тогда кончается в своем узле node_right
+    int gap_node = -1;
+
+    // Узел, к которому относятся опора и сила правого конца: при зазоре — сосед
+    int rightJointNode() const { return gap_node >= 0 ? gap_node : node_right; }
+
+    // Полная свободная деформация ε_T = α·ΔT + ε0
+    double freeStrain() const { return thermalExpansion * deltaT + initialStrain; }
+
+    double areaAt(double x) const { return section.area(x / len_L, selectArea_A); }
+
+    LoadDistribution loads() const { return { Joint_left.lineLoad_q, &lineLoads, &pointLoads }; }
+};
+
+// Заполняет незаданные узлы по цепочке, отделяет узлы зазоров
+// и возвращает число узлов (степеней свободы)
+int resolveConnectivity(std::vector<Core_of_Beam>& beams);
+
+// Жесткость стержня k = EA/L, при переменном сечении k = 1 / ∫ dx / EA(x)
+double barStiffness(const Core_of_Beam& beam);
+
+// Точные эквивалентные узловые нагрузки от распределенных нагрузок и ε_T.
+// N(x) = N0 - Q(x), условие u(L) - u(0) = ∫ (N/EA + ε_T) dx дает
+//   F_left = k·(∫ Q dx / EA - ε_T·L),  F_right = Q(L) - F_left;
+// сосредоточенные силы в пролете входят в Q и R так же, как q
+// при постоянном сечении F_left = R(L)/L - EA·ε_T, R = ∫ Q dx
+void barEquivalentLoads(const Core_of_Beam& beam, double& left, double& right);
+
+// Матрица масс стержня [m11 m12; m12 m22]. Согласованная — по линейным
+// функциям формы, m_ij = ρ ∫ A N_i N_j dx, при постоянном сечении ρAL/6·[2 1; 1 2];
+// сосредоточенная — суммы строк согласованной на диагонали
+void barMass(const Core_of_Beam& beam, bool lumped, double& m11, double& m12, double& m22);
+
+
+struct BeamResults {
+    int beamNum;
+    double E;              // Модуль упругости
+    double A;              // Площадь сечения
+    double L;              // Длина
+    double q;              // Распределенная нагрузка (средняя: Q(L) / L)
+    double freeStrain;     // Температурная и начальная деформация ε_T
+    double delta_left;     // Перемещение левого узла
+    double delta_right;    // Перемещение правого узла
+
+
+    std::vector<double> X;   // Точки x; в точке силы внутри стержня — дважды, слева и справа от скачка
+    std::vector<double> N_x; // Продольные силы N(x)
+    std::vector<double> U_x; // Перемещения u(x)
+    std::vector<double> sigma; // Напряжения σ(x)
 };
\ No newline at end of file
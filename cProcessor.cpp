@@ -1,774 +1,2016 @@
-#include "cProcessor.h"
-#include <QFuture>
-#include <QtConcurrent>
-#include <cmath>
-
-cProcessor::cProcessor(std::vector<Core_of_Beam>* beamData, QWidget* parent)
-    : QWidget(parent), m_beamData(beamData), m_watcher(nullptr)
-{
-    ui.setupUi(this);
-    setFixedSize(size());
-    MenuBar();
-
-    ui.textEdit_p_2->setText("30");
-    
-    //QFont font;
-    //font.setStyleHint(QFont::TypeWriter);  // Qt автоматически выберет моноширинный шрифт
-    //font.setPointSize(10);
-    //ui.textEdit_p_1->setFont(font);
-
-    QFont font("Consolas", 10);
-    ui.textEdit_p_1->setFont(font);
-}
-
-cProcessor::~cProcessor()
-{
-    if (m_watcher) {
-        m_watcher->waitForFinished();
-    }
-}
-
-void cProcessor::MenuBar()
-{
-    QMenuBar* menuBar = new QMenuBar(this);
-
-    QMenu* fileMenu = menuBar->addMenu("Настройки");
-  //  fileMenu->addAction("Сохранить");
-    QAction* save_action = fileMenu->addAction("Сохранить результаты расчета");
-    QAction* clear_action = fileMenu->addAction("Очистить");
-
-    /*QMenu* helpMenu = menuBar->addMenu("Справка");
-    helpMenu->addAction("О программе");*/
-
-    // Добавление menuBar в layout
-    QVBoxLayout* mainLayout = new QVBoxLayout(this);
-    mainLayout->setMenuBar(menuBar);  // Для QVBoxLayout
-    setLayout(mainLayout);
-
-    connect(clear_action, &QAction::triggered, this, &cProcessor::clear_textEdit);
-    connect(save_action, &QAction::triggered, this, &cProcessor::save_calc_results);
-}
-
-// ==================== СЛОТЫ ====================
-
-void cProcessor::on_pushButton_p_1_clicked()
-{
-    ui.pushButton_p_1->setEnabled(false);
-    m_watcher = new QFutureWatcher<void>(this);
-    connect(m_watcher, &QFutureWatcher<void>::finished,
-        this, &cProcessor::onCalculationFinished);
-
-    QFuture<void> future = QtConcurrent::run([this]() {
-        calculateData();
-        });
-
-    m_watcher->setFuture(future);
-    ui.textEdit_p_1->append("Расчет запущен...\n");
-}
-
-void cProcessor::onCalculationFinished()
-{
-    ui.textEdit_p_1->append("Расчет завершен!\n\n");
-    if (m_watcher) {
-        m_watcher->deleteLater();
-        m_watcher = nullptr;
-    }
-    ui.pushButton_p_1->setEnabled(true);
-}
-
-void cProcessor::on_pushButton_p_2_clicked()
-{
-    emit sendResults(results_force);
-
-    this->hide();
-}
-
-void cProcessor::on_pushButton_p_3_clicked()
-{
-    QString beamNumText = ui.textEdit_p_3->toPlainText().trimmed();
-    bool okBeam;
-    int beamNum = beamNumText.toInt(&okBeam);
-
-    // Считываем координату
-    QString coordinateText = ui.textEdit_p_4->toPlainText().trimmed();
-    bool okCoord;
-    double coordinate = coordinateText.toDouble(&okCoord);
-
-    // Проверка корректности ввода номера стержня
-    if (!okBeam || beamNumText.isEmpty()) {
-        QMessageBox::warning(this, "Ошибка ввода",
-            "Введите корректный номер стержня (целое число)");
-        return;
-    }
-
-    // Проверка корректности ввода координаты
-    if (!okCoord || coordinateText.isEmpty()) {
-        QMessageBox::warning(this, "Ошибка ввода",
-            "Введите корректное значение координаты (число)");
-        return;
-    }
-
-    // Проверка наличия результатов расчета
-    if (results_force.empty()) {
-        QMessageBox::warning(this, "Нет данных",
-            "Сначала выполните расчет (нажмите кнопку 'Рассчитать')");
-        return;
-    }
-
-    // Проверка диапазона номера стержня
-    if (beamNum < 1 || beamNum > static_cast<int>(results_force.size())) {
-        QMessageBox::warning(this, "Ошибка",
-            QString("Номер стержня должен быть от 1 до %1").arg(results_force.size()));
-        return;
-    }
-
-    // Получаем результаты для указанного стержня (индекс = beamNum - 1)
-    const BeamResults& res = results_force[beamNum - 1];
-
-    // Проверка диапазона координаты (от 0 до L)
-    if (coordinate < 0.0 || coordinate > res.L) {
-        QMessageBox::warning(this, "Ошибка",
-            QString("Координата должна быть в диапазоне от 0 до %1 м (длина стержня)")
-            .arg(res.L, 0, 'f', 4));
-        return;
-    }
-
-    // Получаем параметры в указанной точке
-    QString result = getBeamParametersAtPoint(beamNum, coordinate);
-
-    // Выводим результат
-    ui.textEdit_p_1->append(result);
-}
-
-// ==================== ОСНОВНОЙ РАСЧЕТ ====================
-
-std::vector<double> cProcessor::get_rangeLen(double start_L, double stop_L, double step)
-{
-    std::vector<double> range;
-
-    if (step <= 0.0) {
-        throw std::invalid_argument("Step must be positive");
-    }
-
-    if (start_L > stop_L) {
-        throw std::invalid_argument("start_L must be less than or equal to stop_L");
-    }
-
-    // Генерация диапазона
-    double current = start_L;
-    while (current <= stop_L) {
-        range.push_back(current);
-        current += step;
-    }
-
-    // Гарантируем, что последняя точка будет ровно stop_L
-    if (range.empty() || std::abs(range.back() - stop_L) > 1e-9) {
-        range.push_back(stop_L);
-    }
-
-    return range;
-
-}
-
-QString cProcessor::getBeamParametersAtPoint(int beamNum, double coordinate)
-{
-    const BeamResults& res = results_force[beamNum - 1];
-
-    // Вычисляем параметры в заданной точке
-    double Nx = calculateNormalForce(res.E, res.A, res.L,
-        res.delta_left, res.delta_right,
-        res.q, coordinate);
-
-    double Ux = calculateDisplacement(res.delta_left, res.delta_right,
-        res.E, res.A, res.L,
-        res.q, coordinate);
-
-    double sigma = calculateStress(Nx, res.A);
-
-    // Формируем выходную строку
-    QString output;
-    output += QString("=").repeated(60) + "\n";
-    output += QString("Параметры стержня №%1 в точке x = %2 м\n")
-        .arg(beamNum)
-        .arg(coordinate, 0, 'f', 4);
-    output += QString("=").repeated(60) + "\n";
-
-    output += QString("Длина стержня L = %1 м\n").arg(res.L, 0, 'f', 4);
-    output += QString("Площадь сечения A = %1 м²\n").arg(res.A, 0, 'e', 4);
-    output += QString("Модуль упругости E = %1 Па\n").arg(res.E, 0, 'e', 2);
-    output += QString("Распред. нагрузка q = %1 Н/м\n").arg(res.q, 0, 'f', 2);
-    output += "\n";
-
-    output += QString("Продольная сила N(x) = %1 Н\n").arg(Nx, 0, 'f', 2);
-    output += QString("Перемещение u(x) = %1 м\n").arg(Ux, 0, 'e', 6);
-    output += QString("Напряжение σ(x) = %1 Па\n").arg(sigma, 0, 'e', 4);
-
-    // Проверка прочности
-    const Core_of_Beam& beam = (*m_beamData)[beamNum - 1];
-    double maxVoltage = beam.maxVoltage;
-    output += "\n";
-    output += QString("Предельное напряжение σ_max = %1 Па\n").arg(maxVoltage, 0, 'e', 2);
-
-    if (std::abs(sigma) <= maxVoltage) {
-        output += QString("✓ Прочность обеспечена (|σ| ≤ σ_max)\n");
-    }
-    else {
-        output += QString("✗ ПРОЧНОСТЬ НЕ ОБЕСПЕЧЕНА! (|σ| > σ_max)\n");
-    }
-
-    output += QString("=").repeated(60) + "\n\n";
-
-    return output;
-
-}
-
-void cProcessor::clear_textEdit()
-{
-    ui.textEdit_p_1->clear();
-}
-
-void cProcessor::save_calc_results()
-{
-    QString fileName;
-    fileName = QFileDialog::getSaveFileName(
-        this,
-        tr("Сохранить файл"),
-        QDir::currentPath() + "/results.txt",
-        tr("TXT файлы (*.txt);;Все файлы (*.*)")
-    );
-
-    std::string out_result = ui.textEdit_p_1->toPlainText().toStdString();
-
-    std::ofstream file_result(fileName.toStdString());
-    if (file_result.is_open()) {
-
-        file_result << out_result;
-
-        file_result.close();
-    }
-}
-
-void cProcessor::calculateData()
-{
-    try {
-        // Параллельное создание матрицы A и вектора B
-        QFuture<std::vector<std::vector<double>>> futureA =
-            QtConcurrent::run([this]() {
-            return this->createMatrix_A();
-                });
-
-        QFuture<std::vector<double>> futureB =
-            QtConcurrent::run([this]() {
-            return this->createVector_B();
-                });
-
-        futureA.waitForFinished();
-        futureB.waitForFinished();
-
-        auto A = futureA.result();
-        auto B = futureB.result();
-
-        // Применение граничных условий
-        applyBoundaryConditions(A, B);
-
-        auto deltas = findDeltas(A, B);
-        m_deltas = deltas; // Сохраняем для пост-процессинга
-        displayResults(A, deltas);
-
-        // Пост-процессорные расчеты
-        auto postResults = calculatePostProcessing(deltas);
-	//	showPostProcessingResults(postResults);
-        showPostProcessingResultsAsTable(postResults);
-
-        /*output += QString("\n Проверка макс. напряжений σ(x): \n");
-        for (size_t j = 0; j < res.sigma.size(); j++) {
-            const Core_of_Beam& beam = (*m_beamData)[i];
-            double max_voltage = beam.maxVoltage;
-
-            if (std::abs(res.sigma[i]) > max_voltage) {
-
-            }
-        }*/
-
-        results_force = postResults;
-    }
-    catch (const std::exception& e) {
-        QString errorMsg = QString("Ошибка расчета: %1").arg(e.what());
-        QMetaObject::invokeMethod(this, [this, errorMsg]() {
-            ui.textEdit_p_1->append(errorMsg);
-            }, Qt::QueuedConnection);
-    }
-}
-
-void cProcessor::displayResults(const std::vector<std::vector<double>>& A,
-    const std::vector<double>& deltas)
-{
-    QString output;
-    output += QString(60, '=') + "\n";
-    output += "РЕЗУЛЬТАТЫ РАСЧЕТА ПРОЦЕССОРА\n";
-    output += QString(60, '=') + "\n\n";
-
-    /*output += "Матрица жесткости A:\n";
-    
-    for (size_t i = 0; i < A.size(); i++) {
-        for (size_t j = 0; j < A[i].size(); j++) {
-            output += QString("%1 ").arg(A[i][j], 9, 'f', 4);
-        }
-        output += "\n";
-    }*/
-
-    output += "\nУзловые перемещения Δ:\n";
-    for (size_t i = 0; i < deltas.size(); i++) {
-        output += QString("  Δ[%1] = %2\n").arg(i).arg(deltas[i]);
-    }
-
-    QMetaObject::invokeMethod(this, [this, output]() {
-        ui.textEdit_p_1->append(output);
-        }, Qt::QueuedConnection);
-}
-
-std::vector<std::vector<double>> cProcessor::createMatrix_A()
-{
-    if (!m_beamData || m_beamData->empty()) {
-        throw std::runtime_error("No beam data available");
-    }
-
-    int num_beams = m_beamData->size();
-    int num_dof = num_beams + 1;
-
-    std::vector<std::vector<double>> A(num_dof, std::vector<double>(num_dof, 0.0));
-
-    for (int i = 0; i < num_beams; ++i) {
-        const Core_of_Beam& beam = (*m_beamData)[i];
-        double E = beam.mod_elasticity;
-        double A_area = beam.selectArea_A;
-        double L = beam.len_L;
-
-        if (std::abs(L) < 1e-9) {
-            throw std::runtime_error("Beam has near-zero length");
-        }
-
-        // Локальная жесткость: k = EA/L
-        double k_local = (E * A_area) / L;
-
-        // Добавление вклада в глобальную матрицу
-        A[i][i] += k_local;
-        A[i][i + 1] += -k_local;
-        A[i + 1][i] += -k_local;
-        A[i + 1][i + 1] += k_local;
-    }
-
-    return A;
-}
-
-
-std::vector<double> cProcessor::createVector_B()
-{
-    int num_beams = m_beamData->size();
-    int num_dof = num_beams + 1;
-    std::vector<double> B(num_dof, 0.0);
-
-    //  Распределенные нагрузки
-    for (int i = 0; i < num_beams; ++i) {
-        const Core_of_Beam& beam = (*m_beamData)[i];
-        double L = beam.len_L;
-        double q = beam.Joint_left.lineLoad_q;
-
-        // Эквивалентные узловые силы: q*L/2 на каждый узел
-        double q_left = q * L / 2.0;
-        double q_right = q * L / 2.0;
-
-        B[i] += q_left;
-        B[i + 1] += q_right;
-    }
-
-    //  Сосредоточенные силы (избегаем дублирования)
-    B[0] += (*m_beamData)[0].Joint_left.force_f;
-
-    for (int i = 0; i < num_beams - 1; ++i) {
-        B[i + 1] += (*m_beamData)[i].Joint_right.force_f;
-    }
-
-    B[num_dof - 1] += (*m_beamData)[num_beams - 1].Joint_right.force_f;
-
-    return B;
-}
-
-
-void cProcessor::applyBoundaryConditions(
-    std::vector<std::vector<double>>& A,
-    std::vector<double>& B)
-{
-    int num_dof = A.size();
-
-    for (int i = 0; i < m_beamData->size(); ++i) {
-        const Core_of_Beam& beam = (*m_beamData)[i];
-
-        // Левое закрепление (первая балка)
-        if (i == 0 && beam.Joint_left.fixedSupport == 1) {
-            for (int j = 0; j < num_dof; ++j) {
-                A[0][j] = 0.0;
-                A[j][0] = 0.0;
-            }
-            A[0][0] = 1.0;
-            B[0] = 0.0;
-        }
-
-        // Правое закрепление (последняя балка)
-        if (i == m_beamData->size() - 1 && beam.Joint_right.fixedSupport == 1) {
-            int last = num_dof - 1;
-            for (int j = 0; j < num_dof; ++j) {
-                A[last][j] = 0.0;
-                A[j][last] = 0.0;
-            }
-            A[last][last] = 1.0;
-            B[last] = 0.0;
-        }
-    }
-}
-
-std::vector<double> cProcessor::findDeltas(
-    std::vector<std::vector<double>>& A,
-    std::vector<double>& B)
-{
-    int n = B.size();
-    if (A.size() != n || A[0].size() != n) {
-        throw std::runtime_error("Matrix A must be square");
-    }
-
-    // Создание расширенной матрицы [A|B]
-    std::vector<std::vector<double>> augmented(n, std::vector<double>(n + 1));
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            augmented[i][j] = A[i][j];
-        }
-        augmented[i][n] = B[i];
-    }
-
-    // Прямой ход метода Гаусса с выбором главного элемента
-    for (int k = 0; k < n; ++k) {
-        // Поиск строки с максимальным элементом
-        int pivotRow = k;
-        double maxPivot = std::abs(augmented[k][k]);
-        for (int i = k + 1; i < n; ++i) {
-            if (std::abs(augmented[i][k]) > maxPivot) {
-                maxPivot = std::abs(augmented[i][k]);
-                pivotRow = i;
-            }
-        }
-
-        // Проверка вырожденности
-        if (std::abs(maxPivot) < 1e-12) {
-            throw std::runtime_error("Matrix is singular");
-        }
-
-        // Перестановка строк
-        if (pivotRow != k) {
-            std::swap(augmented[k], augmented[pivotRow]);
-        }
-
-        // Исключение переменной
-        for (int i = k + 1; i < n; ++i) {
-            double factor = augmented[i][k] / augmented[k][k];
-            for (int j = k; j <= n; ++j) {
-                augmented[i][j] -= factor * augmented[k][j];
-            }
-        }
-    }
-
-    // Обратный ход
-    std::vector<double> delta(n);
-    for (int i = n - 1; i >= 0; --i) {
-        double sum = augmented[i][n];
-        for (int j = i + 1; j < n; ++j) {
-            sum -= augmented[i][j] * delta[j];
-        }
-        delta[i] = sum / augmented[i][i];
-    }
-
-    return delta;
-}
-
-//  ПОСТ-процессор
-
-std::vector<BeamResults> cProcessor::calculatePostProcessing(
-    const std::vector<double>& deltas)
-{
-    std::vector<BeamResults> results;
-    int num_beams = m_beamData->size();
-
-    for (int i = 0; i < num_beams; ++i) {
-        const Core_of_Beam& beam = (*m_beamData)[i];
-        BeamResults res;
-
-        // Исходные данные
-        res.beamNum = i + 1;
-        res.E = beam.mod_elasticity;
-        res.A = beam.selectArea_A;
-        res.L = beam.len_L;
-        res.q = beam.Joint_left.lineLoad_q;
-        res.delta_left = deltas[i];
-        res.delta_right = deltas[i + 1];
-
-        double step = ui.textEdit_p_2->toPlainText().toDouble();
-		std::vector<double> range = get_rangeLen(0.0, res.L, res.L / step);
-
-        for(double x : range) {
-            // Продольные силы N(x)
-            double N_x = calculateNormalForce(res.E, res.A, res.L,
-                res.delta_left, res.delta_right,
-                res.q, x);
-            res.N_x.push_back(N_x);
-            // Перемещения u(x)
-            double U_x = calculateDisplacement(res.delta_left, res.delta_right,
-                res.E, res.A, res.L,
-                res.q, x);
-            res.U_x.push_back(U_x);
-            // Напряжения σ(x)
-            double sigma_x = calculateStress(N_x, res.A);
-            res.sigma.push_back(sigma_x);
-		}
-
-
-        results.push_back(res);
-    }
-
-    return results;
-}
-
-void cProcessor::showPostProcessingResults(const std::vector<BeamResults>& results)
-{
-    QString output;
-    output += QString(60, '=') + "\n";
-    output += "РЕЗУЛЬТАТЫ РАСЧЕТА ПОСТ-ПРОЦЕССОРА\n";
-    output += QString(60, '=') + "\n\n";
-
-    for (int i = 0; i < results.size(); ++i) {
-        const BeamResults& res = results[i];
-        output += QString(30, '-') + "\n";
-        output += QString("Балка №%1:\n").arg(res.beamNum);
-        output += QString(30, '-') + "\n";
-
-        output += QString(" Продольные силы N(x): \n");
-        output += QString("N(0)=%1  ").arg(res.N_x[0]);
-        output += QString("N(%2L)=%1\n").arg(res.N_x[res.N_x.size()-1]).arg(res.L);
-
-        output += QString("\n Перемещения u(x): \n");
-        for(size_t j = 0; j < res.U_x.size(); j++) {
-            if(j % 5 == 0 || j == 0 || j == res.U_x.size()-1 ) {
-                output += QString("u(%1*L)=%2 \n").arg(j * (res.L / (res.U_x.size() - 1))).arg(res.U_x[j]);
-			}
-		}
-        output += QString("\n Напряжения σ(x): \n");
-        for (size_t j = 0; j < res.sigma.size(); j++) {
-            if (j % 5 == 0 || j == 0 || j == res.sigma.size() - 1) {
-                output += QString("σ(%1*L)=%2 \n").arg(j * (res.L / (res.sigma.size() - 1))).arg(res.sigma[j]);
-            }
-        }
-
-        output += QString("\n -------- Проверка макс. напряжений σ(x) на стержне №%1: --------\n").arg(i+1);
-        const Core_of_Beam& beam = (*m_beamData)[i];
-        double max_voltage = beam.maxVoltage;
-        output += QString("Макс. напряжение σ=%1 \n").arg(max_voltage);
-        for (size_t j = 0; j < res.sigma.size(); j++) {
-            
-
-            if (std::abs(res.sigma[j]) > max_voltage) {
-                output += QString("Сломается в σ(%1*L)=%2 \n").arg(j * (res.L / (res.sigma.size() - 1))).arg(res.sigma[j]);
-                break;
-            }
-            else {
-                if (j % 5 == 0) {
-                    output += QString("Всё хорошо σ(%1*L)=%2 \n").arg(j * (res.L / (res.sigma.size() - 1))).arg(res.sigma[j]);
-                }
-            }
-        }
-
-		output += QString("\n\n");
-
-    }
-    QMetaObject::invokeMethod(this, [this, output]() {
-        ui.textEdit_p_1->append(output);
-        }, Qt::QueuedConnection); 
-}
-
-void cProcessor::showPostProcessingResultsAsTable(const std::vector<BeamResults>& results)
-{
-    
-
-    bool strengthOk_full = true;
-    QString output;
-
-    
-    bool showAllValues = ui.checkBox_p1->isChecked();
-    int step = showAllValues ? 1 : 5;
-
-    output += QString(60, '=') + "\n";
-    output += "         РЕЗУЛЬТАТЫ РАСЧЕТА СТЕРЖНЕВОЙ КОНСТРУКЦИИ\n";
-    output += QString(60, '=') + "\n\n";
-
-    for (int i = 0; i < results.size(); ++i) {
-        const BeamResults& res = results[i];
-
-        
-        output += QString(60, '-') + "\n";
-        output += QString("  СТЕРЖЕНЬ №%1\n").arg(res.beamNum);
-        output += QString(60, '-') + "\n";
-
-        
-        output += "┌────────────────────────────────────────┬──────────────────┐\n";
-        output += "│ Параметр                               │ Значение         │\n";
-        output += "├────────────────────────────────────────┼──────────────────┤\n";
-        output += QString("│ Модуль упругости E, Па                 │ %1 │\n")
-            .arg(res.E, 16, 'e', 2, ' ');
-        output += QString("│ Площадь сечения A, м²                  │ %1 │\n")
-            .arg(res.A, 16, 'e', 4, ' ');
-        output += QString("│ Длина L, м                             │ %1 │\n")
-            .arg(res.L, 16, 'f', 4, ' ');
-        output += QString("│ Распред. нагрузка q, Н/м               │ %1 │\n")
-            .arg(res.q, 16, 'f', 2, ' ');
-        output += QString("│ Перемещение левого узла, м             │ %1 │\n")
-            .arg(res.delta_left, 16, 'e', 6, ' ');
-        output += QString("│ Перемещение правого узла, м            │ %1 │\n")
-            .arg(res.delta_right, 16, 'e', 6, ' ');
-        output += "└────────────────────────────────────────┴──────────────────┘\n";
-
-        /*output += "┌───────────────────────────────────────────────────────\n";
-        output += "│ Параметр                                  │ Значение         \n";
-        output += "|────────────────────────────────────────-──────────────\n";
-        output += QString("│ Модуль упругости E, Па                 │ %1  \n")
-            .arg(res.E, 16, 'e', 2, ' ');
-        output += QString("│ Площадь сечения A, м²                  │ %1  \n")
-            .arg(res.A, 16, 'e', 4, ' ');
-        output += QString("│ Длина L, м                                       │ %1  \n")
-            .arg(res.L);
-        output += "|────────────────────────────────-─────────────────────────|\n\n";*/
-
-        //  N(x)
-        output += "  ПРОДОЛЬНЫЕ СИЛЫ N(x), Н:\n";
-        output += "┌───────────────────┬───────────────────┐\n";
-        output += "│ Координата x, м   │ N(x), Н           │\n";
-        output += "|───────────────────┼───────────────────|\n";
-
-        for (size_t j = 0; j < res.N_x.size(); ++j) {
-            
-            if (j % step == 0 || j == 0 || j == res.N_x.size() - 1) {
-                double x = j * res.L / (res.N_x.size() - 1);
-                output += QString("│ %1 │ %2 │\n")
-                    .arg(x, 17, 'f', 4)
-                    .arg(res.N_x[j], 17, 'f', 2);
-            }
-        }
-        output += "|───────────────────-───────────────────|\n\n";
-
-        // u(x)
-        output += "  ПЕРЕМЕЩЕНИЯ u(x), м:\n";
-        output += "┌───────────────────┬───────────────────┐\n";
-        output += "│ Координата x, м   │ u(x), м           │\n";
-        output += "|───────────────────┼───────────────────|\n";
-
-        for (size_t j = 0; j < res.U_x.size(); ++j) {
-            if (j % step == 0 || j == 0 || j == res.U_x.size() - 1) {
-                double x = j * res.L / (res.U_x.size() - 1);
-                output += QString("│ %1 │ %2 │\n")
-                    .arg(x, 17, 'f', 4)
-                    .arg(res.U_x[j], 17, 'e', 6);
-            }
-        }
-        output += "|───────────────────-───────────────────|\n\n";
-
-        // σ(x)
-        const Core_of_Beam& beam = (*m_beamData)[i];
-        double max_voltage = beam.maxVoltage;
-
-        output += QString("  НАПРЯЖЕНИЯ σ(x), Па (Допустимое: %1 Па):\n")
-            .arg(max_voltage, 0, 'e', 2);
-        output += "┌───────────────────┬───────────────────┬──────────┐\n";
-        output += "│ Координата x, м   | σ(x), Па          │ Статус   │\n";
-        output += "|───────────────────┼───────────────────┼──────────|\n";
-
-        bool strengthOk = true;
-        for (size_t j = 0; j < res.sigma.size(); ++j) {
-            if (j % step == 0 || j == 0 || j == res.sigma.size() - 1) {
-                double x = j * res.L / (res.sigma.size() - 1);
-
-                QString status = " OK     ";
-                if (std::abs(res.sigma[j]) > max_voltage) {
-                    status = " FAIL!  ";
-                    strengthOk = false;
-                    strengthOk_full = false;
-                }
-
-                output += QString("│ %1 │ %2 │%3│\n")
-                    .arg(x, 17, 'f', 4)
-                    .arg(res.sigma[j], 17, 'e', 4)
-                    .arg(status);
-            }
-        }
-        output += "|───────────────────-───────────────────-──────────|\n";
-
-        // Вердикт по прочности одного стержня
-        if (strengthOk) {
-            output += "  ✓ УСЛОВИЕ ПРОЧНОСТИ ВЫПОЛНЕНО\n\n";
-        }
-        else {
-            output += "  ✗ УСЛОВИЕ ПРОЧНОСТИ НЕ ВЫПОЛНЕНО!\n\n";
-        }
-    }
-
-    output += QString(60, '=') + "\n";
-    output += "                        КОНЕЦ ОТЧЕТА\n";
-
-    std::string strongInfo;
-    strongInfo += "Условию прочности относительно всей балки: ";
-    strongInfo += (strengthOk_full == true) ? "✓ УСЛОВИЕ ПРОЧНОСТИ ВЫПОЛНЕНО \n" : "✗ УСЛОВИЕ ПРОЧНОСТИ НЕ ВЫПОЛНЕНО! \n";
-    output += strongInfo;
-    output += QString(60, '=') + "\n";
-
-    QMetaObject::invokeMethod(this, [this, output]() {
-        ui.textEdit_p_1->append(output);
-        }, Qt::QueuedConnection);
-}
-
-
-
-
-double cProcessor::calculateNormalForce(double E, double A, double L,
-    double delta_i, double delta_j,
-    double q, double x)
-{
-    // N(x) = (E*A/L)*(Δ_j - Δ_i) + (q*L/2)*(1 - 2*x/L)
-    if (std::abs(L) < 1e-12) {
-        return 0.0;
-    }
-
-    double EA_over_L = (E * A) / L;
-    double N_displacement = EA_over_L * (delta_j - delta_i);
-    double N_load = (q * L / 2.0) * (1.0 - 2.0 * x / L);
-
-    return N_displacement + N_load;
-}
-
-double cProcessor::calculateDisplacement(double delta_i, double delta_j,
-    double E, double A, double L,
-    double q, double x)
-{
-    // u(x) = Δ_i + (Δ_j - Δ_i)*(x/L) + (q*L²/(2*E*A))*(1 - x/L)*(x/L)
-    if (std::abs(E * A) < 1e-12 || std::abs(L) < 1e-12) {
-        return 0.0;
-    }
-
-    double u_linear = delta_i + (delta_j - delta_i) * (x / L);
-    double u_distributed = (q * L * L / (2.0 * E * A)) * (1.0 - x / L) * (x / L);
-
-    return u_linear + u_distributed;
-}
-
-double cProcessor::calculateStress(double N, double A)
-{
-    // σ = N / A
-    if (std::abs(A) < 1e-12) {
-        return 0.0;
-    }
-    return N / A;
-}
+#include "cProcessor.h"
+#include <QFuture>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <QElapsedTimer>
+
+cProcessor::cProcessor(std::vector<Core_of_Beam>* beamData, QWidget* parent)
+    : QWidget(parent), m_beamData(beamData), m_watcher(nullptr)
+{
+    ui.setupUi(this);
+    setFixedSize(size());
+    MenuBar();
+
+    ui.textEdit_p_2->setText("30");
+    
+    //QFont font;
+    //font.setStyleHint(QFont::TypeWriter);  // Qt автоматически выберет моноширинный шрифт
+    //font.setPointSize(10);
+    //ui.textEdit_p_1->setFont(font);
+
+    QFont font("Consolas", 10);
+    ui.textEdit_p_1->setFont(font);
+}
+
+cProcessor::~cProcessor()
+{
+    if (m_watcher) {
+        m_watcher->waitForFinished();
+    }
+}
+
+void cProcessor::MenuBar()
+{
+    QMenuBar* menuBar = new QMenuBar(this);
+
+    QMenu* fileMenu = menuBar->addMenu("Настройки");
+  //  fileMenu->addAction("Сохранить");
+    QAction* save_action = fileMenu->addAction("Сохранить результаты расчета");
+    QAction* clear_action = fileMenu->addAction("Очистить");
+
+    QMenu* solverMenu = menuBar->addMenu("Решатель");
+    m_solverMenu = solverMenu;
+    QActionGroup* solverGroup = new QActionGroup(this);
+    QAction* autoSolver = solverMenu->addAction("Автоматически по размеру");
+    QAction* directSolver = solverMenu->addAction("Прямой (RCM + Холецкий)");
+    QAction* iterativeSolver = solverMenu->addAction("Итерационный (PCG)");
+    for (QAction* action : { autoSolver, directSolver, iterativeSolver }) {
+        action->setCheckable(true);
+        solverGroup->addAction(action);
+    }
+    autoSolver->setChecked(true);
+
+    solverMenu->addSeparator();
+    QActionGroup* precondGroup = new QActionGroup(this);
+    QAction* icPrecond = solverMenu->addAction("PCG: предобусловливатель IC(0)");
+    QAction* jacobiPrecond = solverMenu->addAction("PCG: предобусловливатель Якоби");
+    for (QAction* action : { icPrecond, jacobiPrecond }) {
+        action->setCheckable(true);
+        precondGroup->addAction(action);
+    }
+    icPrecond->setChecked(true);
+    QAction* tolerance_action = solverMenu->addAction("PCG: точность...");
+    solverMenu->addSeparator();
+    QActionGroup* precisionGroup = new QActionGroup(this);
+    QAction* standardPrecision = solverMenu->addAction("Точность: обычная");
+    QAction* refinedPrecision = solverMenu->addAction("Точность: уточнение и обусловленность");
+    QAction* fastPrecision = solverMenu->addAction("Точность: быстрый float32 + уточнение");
+    for (QAction* action : { standardPrecision, refinedPrecision, fastPrecision }) {
+        action->setCheckable(true);
+        precisionGroup->addAction(action);
+    }
+    standardPrecision->setChecked(true);
+    solverMenu->addSeparator();
+    QAction* chainBench_action = solverMenu->addAction("Цепочка: масштабируемость по потокам...");
+
+    QMenu* analysisMenu = menuBar->addMenu("Анализ");
+    m_analysisMenu = analysisMenu;
+    QAction* modal_action = analysisMenu->addAction("Собственные частоты...");
+    QAction* transient_action = analysisMenu->addAction("Динамический расчет...");
+    QAction* plastic_action = analysisMenu->addAction("Упругопластический расчет...");
+    QAction* geometric_action = analysisMenu->addAction("Большие перемещения...");
+    QAction* sizing_action = analysisMenu->addAction("Подбор сечений...");
+    QAction* sensitivity_action = analysisMenu->addAction("Чувствительность...");
+    analysisMenu->addSeparator();
+    QActionGroup* massGroup = new QActionGroup(this);
+    QAction* consistentMass = analysisMenu->addAction("Матрица масс: согласованная");
+    QAction* lumpedMass = analysisMenu->addAction("Матрица масс: сосредоточенная");
+    for (QAction* action : { consistentMass, lumpedMass }) {
+        action->setCheckable(true);
+        massGroup->addAction(action);
+    }
+    consistentMass->setChecked(true);
+
+    // Режимы точности относятся к прямому решателю: при PCG они недоступны
+    connect(autoSolver, &QAction::triggered, this, [this, precisionGroup]() {
+        m_solverKind = SolverKind::Auto;
+        precisionGroup->setEnabled(true);
+        });
+    connect(directSolver, &QAction::triggered, this, [this, precisionGroup]() {
+        m_solverKind = SolverKind::Direct;
+        precisionGroup->setEnabled(true);
+        });
+    connect(iterativeSolver, &QAction::triggered, this, [this, precisionGroup]() {
+        m_solverKind = SolverKind::Iterative;
+        precisionGroup->setEnabled(false);
+        });
+    connect(icPrecond, &QAction::triggered, this, [this]() {
+        m_pcgOptions.preconditioner = Preconditioner::IncompleteCholesky;
+        });
+    connect(jacobiPrecond, &QAction::triggered, this, [this]() {
+        m_pcgOptions.preconditioner = Preconditioner::Jacobi;
+        });
+    connect(tolerance_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        double tol = QInputDialog::getDouble(this, "PCG", "Относительная невязка:",
+            m_pcgOptions.tolerance, 1e-16, 1e-2, 16, &ok);
+        if (ok) {
+            m_pcgOptions.tolerance = tol;
+        }
+        });
+    connect(standardPrecision, &QAction::triggered, this, [this]() { m_precisionMode = PrecisionMode::Standard; });
+    connect(refinedPrecision, &QAction::triggered, this, [this]() { m_precisionMode = PrecisionMode::Refined; });
+    connect(fastPrecision, &QAction::triggered, this, [this]() { m_precisionMode = PrecisionMode::Fast; });
+    connect(chainBench_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        int length = QInputDialog::getInt(this, "Прогонка", "Число узлов цепочки:",
+            4000000, 10000, 100000000, 100000, &ok);
+        if (ok) {
+            startTask([this, length]() { benchmarkChainSolver(length); });
+        }
+        });
+    connect(consistentMass, &QAction::triggered, this, [this]() { m_lumpedMass = false; });
+    connect(lumpedMass, &QAction::triggered, this, [this]() { m_lumpedMass = true; });
+    connect(modal_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        int count = QInputDialog::getInt(this, "Собственные частоты", "Число нижних частот:",
+            10, 1, 1000000, 1, &ok);
+        if (ok) {
+            startTask([this, count]() { modalAnalysis(count); });
+        }
+        });
+    connect(plastic_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        PlasticOptions options;
+        options.stepFraction = QInputDialog::getDouble(this, "Упругопластический расчет",
+            "Шаг λ в долях λ первой текучести:", options.stepFraction, 1e-3, 10.0, 4, &ok);
+        if (!ok) return;
+        options.maxLoadFactor = QInputDialog::getDouble(this, "Упругопластический расчет",
+            "Наибольший λ (0 — до разрушения):", 0.0, 0.0, 1e12, 6, &ok);
+        if (!ok) return;
+        startTask([this, options]() { plasticAnalysis(options); });
+        });
+    connect(geometric_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        GeometricOptions options;
+        options.loadSteps = QInputDialog::getInt(this, "Большие перемещения", "Шагов нагружения:",
+            options.loadSteps, 1, 100000, 1, &ok);
+        if (!ok) return;
+        startTask([this, options]() { largeDisplacementAnalysis(options); });
+        });
+    connect(sizing_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        SizingOptions options;
+        options.minArea = QInputDialog::getDouble(this, "Подбор сечений", "Наименьшая площадь, м²:",
+            options.minArea, 1e-12, 1e3, 12, &ok);
+        if (!ok) return;
+        // Узлы — как в Δ[i]
+        QString limitsText = QInputDialog::getText(this, "Подбор сечений",
+            "Ограничения перемещений узел:Δmax через пробел (пусто — нет):", QLineEdit::Normal, QString(), &ok);
+        if (!ok) return;
+        for (const QString& token : limitsText.split(' ', Qt::SkipEmptyParts)) {
+            QStringList pair = token.split(':');
+            if (pair.size() != 2) continue;
+            options.displacementLimits.push_back({ pair[0].toInt(), pair[1].toDouble() });
+        }
+        startTask([this, options]() { optimizeAreas(options); });
+        });
+    connect(sensitivity_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        const QStringList kinds = { "Перемещение узла", "Напряжение в стержне (более нагруженный конец)" };
+        QString kind = QInputDialog::getItem(this, "Чувствительность", "Отклик:", kinds, 0, false, &ok);
+        if (!ok) return;
+        SensitivityResponse response;
+        if (kind == kinds[0]) {
+            response.kind = ResponseKind::Displacement;
+            // Узлы — как в Δ[i]
+            response.index = QInputDialog::getInt(this, "Чувствительность", "Узел:", 0, 0, 2000000000, 1, &ok);
+        }
+        else {
+            response.kind = ResponseKind::Stress;
+            response.index = QInputDialog::getInt(this, "Чувствительность", "Стержень:", 1, 1, 2000000000, 1, &ok) - 1;
+        }
+        if (!ok) return;
+        // Отмена выбора файла — только вывод в окно
+        QString fileName = QFileDialog::getSaveFileName(this, "Файл производных",
+            QDir::currentPath() + "/sensitivity.csv", "CSV файлы (*.csv);;Все файлы (*.*)");
+        startTask([this, response, fileName]() {
+            sensitivityAnalysis(response, fileName);
+            });
+        });
+    connect(transient_action, &QAction::triggered, this, [this]() {
+        bool ok;
+        const QStringList schemes = { "Ньюмарк (неявная, β = 1/4)", "Центральные разности (явная)" };
+        QString scheme = QInputDialog::getItem(this, "Динамический расчет", "Схема:", schemes, 0, false, &ok);
+        if (!ok) return;
+        TransientOptions options;
+        options.integrator = (scheme == schemes[1]) ? TimeIntegrator::CentralDifference : TimeIntegrator::Newmark;
+        options.timeStep = QInputDialog::getDouble(this, "Динамический расчет",
+            "Шаг Δt, с (0 — 0.9 критического):", 0.0, 0.0, 1e6, 12, &ok);
+        if (!ok) return;
+        options.steps = QInputDialog::getInt(this, "Динамический расчет", "Число шагов:",
+            10000, 1, 2000000000, 1000, &ok);
+        if (!ok) return;
+        options.outputEvery = QInputDialog::getInt(this, "Динамический расчет", "Записывать каждый k-й шаг:",
+            1, 1, 1000000000, 1, &ok);
+        if (!ok) return;
+        // Узлы — как в Δ[i], стержни — с 1; пусто — последний узел и первый стержень
+        QString nodesText = QInputDialog::getText(this, "Динамический расчет",
+            "Узлы для u(t) через пробел (пусто — последний):", QLineEdit::Normal, QString(), &ok);
+        if (!ok) return;
+        QString barsText = QInputDialog::getText(this, "Динамический расчет",
+            "Стержни для N(t) через пробел (пусто — первый):", QLineEdit::Normal, QString(), &ok);
+        if (!ok) return;
+        for (const QString& token : nodesText.split(' ', Qt::SkipEmptyParts)) {
+            options.outputNodes.push_back(token.toInt());
+        }
+        std::vector<int> bars;
+        for (const QString& token : barsText.split(' ', Qt::SkipEmptyParts)) {
+            bars.push_back(token.toInt() - 1);
+        }
+        QString fileName = QFileDialog::getSaveFileName(this, "Файл истории",
+            QDir::currentPath() + "/transient.bin", "Бинарные файлы (*.bin);;Все файлы (*.*)");
+        if (fileName.isEmpty()) return;
+        startTask([this, options, bars, fileName]() {
+            transientAnalysis(options, bars, fileName);
+            });
+        });
+
+    /*QMenu* helpMenu = menuBar->addMenu("Справка");
+    helpMenu->addAction("О программе");*/
+
+    // Добавление menuBar в layout
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setMenuBar(menuBar);  // Для QVBoxLayout
+    setLayout(mainLayout);
+
+    connect(clear_action, &QAction::triggered, this, &cProcessor::clear_textEdit);
+    connect(save_action, &QAction::triggered, this, &cProcessor::save_calc_results);
+}
+
+// ==================== СЛОТЫ ====================
+
+void cProcessor::on_pushButton_p_1_clicked()
+{
+    if (m_watcher) return;
+    startTask([this]() { calculateData(); }, "Расчет завершен!\n\n",
+        [this]() { showCalculationResults(); });
+    ui.textEdit_p_1->append("Расчет запущен...\n");
+}
+
+void cProcessor::prepareRun()
+{
+    // Связность меняет номера узлов в m_beamData: разрешается здесь, в потоке
+    // интерфейса, а расчеты в пуле ее только читают
+    m_numNodes = m_beamData ? resolveConnectivity(*m_beamData) : 0;
+    m_pointsPerBar = ui.textEdit_p_2->toPlainText().toDouble();
+}
+
+void cProcessor::startTask(std::function<void()> task, QString finishedMessage,
+    std::function<void()> onFinished)
+{
+    if (m_watcher) return;
+
+    prepareRun();
+    m_finishedMessage = finishedMessage;
+    m_onFinished = std::move(onFinished);
+
+    // Пока расчет идет, модель, настройки решателя и results_force не меняются:
+    // второй расчет не запускается, результаты не отдаются
+    m_solverMenu->setEnabled(false);
+    m_analysisMenu->setEnabled(false);
+    ui.pushButton_p_1->setEnabled(false);
+    ui.pushButton_p_2->setEnabled(false);
+    ui.pushButton_p_3->setEnabled(false);
+
+    m_watcher = new QFutureWatcher<void>(this);
+    connect(m_watcher, &QFutureWatcher<void>::finished,
+        this, &cProcessor::onCalculationFinished);
+    m_watcher->setFuture(QtConcurrent::run(std::move(task)));
+}
+
+void cProcessor::onCalculationFinished()
+{
+    // Вывод и sendAreas расчета поставлены в очередь раньше, чем finished
+    if (m_onFinished) {
+        m_onFinished();
+        m_onFinished = nullptr;
+    }
+    if (!m_finishedMessage.isEmpty()) {
+        ui.textEdit_p_1->append(m_finishedMessage);
+    }
+    if (m_watcher) {
+        m_watcher->deleteLater();
+        m_watcher = nullptr;
+    }
+    m_solverMenu->setEnabled(true);
+    m_analysisMenu->setEnabled(true);
+    ui.pushButton_p_1->setEnabled(true);
+    ui.pushButton_p_2->setEnabled(true);
+    ui.pushButton_p_3->setEnabled(true);
+}
+
+void cProcessor::on_pushButton_p_2_clicked()
+{
+    emit sendResults(results_force);
+
+    this->hide();
+}
+
+void cProcessor::on_pushButton_p_3_clicked()
+{
+    QString beamNumText = ui.textEdit_p_3->toPlainText().trimmed();
+    bool okBeam;
+    int beamNum = beamNumText.toInt(&okBeam);
+
+    // Считываем координату
+    QString coordinateText = ui.textEdit_p_4->toPlainText().trimmed();
+    bool okCoord;
+    double coordinate = coordinateText.toDouble(&okCoord);
+
+    // Проверка корректности ввода номера стержня
+    if (!okBeam || beamNumText.isEmpty()) {
+        QMessageBox::warning(this, "Ошибка ввода",
+            "Введите корректный номер стержня (целое число)");
+        return;
+    }
+
+    // Проверка корректности ввода координаты
+    if (!okCoord || coordinateText.isEmpty()) {
+        QMessageBox::warning(this, "Ошибка ввода",
+            "Введите корректное значение координаты (число)");
+        return;
+    }
+
+    // Проверка наличия результатов расчета
+    if (results_force.empty()) {
+        QMessageBox::warning(this, "Нет данных",
+            "Сначала выполните расчет (нажмите кнопку 'Рассчитать')");
+        return;
+    }
+
+    // Проверка диапазона номера стержня
+    if (beamNum < 1 || beamNum > static_cast<int>(results_force.size())) {
+        QMessageBox::warning(this, "Ошибка",
+            QString("Номер стержня должен быть от 1 до %1").arg(results_force.size()));
+        return;
+    }
+
+    // Получаем результаты для указанного стержня (индекс = beamNum - 1)
+    const BeamResults& res = results_force[beamNum - 1];
+
+    // Проверка диапазона координаты (от 0 до L)
+    if (coordinate < 0.0 || coordinate > res.L) {
+        QMessageBox::warning(this, "Ошибка",
+            QString("Координата должна быть в диапазоне от 0 до %1 м (длина стержня)")
+            .arg(res.L, 0, 'f', 4));
+        return;
+    }
+
+    // Получаем параметры в указанной точке
+    QString result = getBeamParametersAtPoint(beamNum, coordinate);
+
+    // Выводим результат
+    ui.textEdit_p_1->append(result);
+}
+
+// ==================== ОСНОВНОЙ РАСЧЕТ ====================
+
+void cProcessor::get_rangeLen(double start_L, double stop_L, double step,
+    const std::vector<PointLoad>& jumps, std::vector<double>& range)
+{
+    range.clear();
+
+    if (step <= 0.0) {
+        throw std::invalid_argument("Step must be positive");
+    }
+
+    if (start_L > stop_L) {
+        throw std::invalid_argument("start_L must be less than or equal to stop_L");
+    }
+
+    // Генерация диапазона
+    double current = start_L;
+    while (current <= stop_L) {
+        range.push_back(current);
+        current += step;
+    }
+
+    // Гарантируем, что последняя точка будет ровно stop_L
+    if (range.empty() || std::abs(range.back() - stop_L) > 1e-9) {
+        range.push_back(stop_L);
+    }
+
+    // Точки скачков: близкая точка сетки заменяется парой точных координат
+    const double eps = 1e-9 * std::max(1.0, std::abs(stop_L));
+    for (const PointLoad& jump : jumps) {
+        double a = jump.position;
+        if (a <= start_L || a >= stop_L) continue;
+        auto it = std::lower_bound(range.begin(), range.end(), a - eps);
+        if (it != range.end() && std::abs(*it - a) <= eps) {
+            if (it + 1 != range.end() && *(it + 1) == a) continue; // пара уже есть
+            *it = a;
+            range.insert(it + 1, a);
+        }
+        else {
+            it = range.insert(it, a);
+            range.insert(it, a);
+        }
+    }
+}
+
+QString cProcessor::getBeamParametersAtPoint(int beamNum, double coordinate)
+{
+    const BeamResults& res = results_force[beamNum - 1];
+    const Core_of_Beam& beam = (*m_beamData)[beamNum - 1];
+
+    // Вычисляем параметры в заданной точке
+    const LoadDistribution loads = beam.loads();
+    double Nx = calculateNormalForce(res.E, res.A, res.L,
+        res.delta_left, res.delta_right,
+        loads, res.freeStrain, coordinate);
+
+    double Ux = calculateDisplacement(res.delta_left, res.delta_right,
+        res.E, res.A, res.L,
+        loads, coordinate);
+
+    double sigma = calculateStress(Nx, res.A);
+
+    double areaX = res.A;
+    if (!beam.section.isConstant()) {
+        std::vector<double> N, U, S;
+        evaluateVariableSection(beam, res, { coordinate }, N, U, S);
+        Nx = N[0];
+        Ux = U[0];
+        sigma = S[0];
+        areaX = beam.areaAt(coordinate);
+    }
+
+    // Формируем выходную строку
+    QString output;
+    output += QString("=").repeated(60) + "\n";
+    output += QString("Параметры стержня №%1 в точке x = %2 м\n")
+        .arg(beamNum)
+        .arg(coordinate, 0, 'f', 4);
+    output += QString("=").repeated(60) + "\n";
+
+    output += QString("Длина стержня L = %1 м\n").arg(res.L, 0, 'f', 4);
+    output += QString("Площадь сечения A = %1 м²\n").arg(areaX, 0, 'e', 4);
+    output += QString("Модуль упругости E = %1 Па\n").arg(res.E, 0, 'e', 2);
+    output += QString("Распред. нагрузка q = %1 Н/м\n").arg(res.q, 0, 'f', 2);
+    if (res.freeStrain != 0.0) {
+        output += QString("Температурная и начальная деформация ε_T = %1\n").arg(res.freeStrain, 0, 'e', 4);
+    }
+    output += "\n";
+
+    output += QString("Продольная сила N(x) = %1 Н\n").arg(Nx, 0, 'f', 2);
+    output += QString("Перемещение u(x) = %1 м\n").arg(Ux, 0, 'e', 6);
+    output += QString("Напряжение σ(x) = %1 Па\n").arg(sigma, 0, 'e', 4);
+
+    // Проверка прочности
+    double maxVoltage = beam.maxVoltage;
+    output += "\n";
+    output += QString("Предельное напряжение σ_max = %1 Па\n").arg(maxVoltage, 0, 'e', 2);
+
+    if (std::abs(sigma) <= maxVoltage) {
+        output += QString("✓ Прочность обеспечена (|σ| ≤ σ_max)\n");
+    }
+    else {
+        output += QString("✗ ПРОЧНОСТЬ НЕ ОБЕСПЕЧЕНА! (|σ| > σ_max)\n");
+    }
+
+    output += QString("=").repeated(60) + "\n\n";
+
+    return output;
+
+}
+
+void cProcessor::clear_textEdit()
+{
+    ui.textEdit_p_1->clear();
+}
+
+void cProcessor::save_calc_results()
+{
+    QString fileName;
+    fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Сохранить файл"),
+        QDir::currentPath() + "/results.txt",
+        tr("TXT файлы (*.txt);;Все файлы (*.*)")
+    );
+
+    std::string out_result = ui.textEdit_p_1->toPlainText().toStdString();
+
+    std::ofstream file_result(fileName.toStdString());
+    if (file_result.is_open()) {
+
+        file_result << out_result;
+
+        file_result.close();
+    }
+}
+
+void cProcessor::calculateData()
+{
+    m_calculationSucceeded = false;
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+
+        // Буферы процессора переживают расчет: повторный запуск модели того же
+        // размера не выделяет память. Отчет строится уже в потоке интерфейса,
+        // в showCalculationResults
+        SolverWorkspace& ws = m_workspace;
+
+        // Сборка A и B подряд: B собирается за O(n), отдельная задача пула
+        // для нее стоила бы дороже самой сборки
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createVector_B(ws.B, ws.forceApplied);
+
+        // Применение граничных условий
+        applyBoundaryConditions(ws);
+
+        findDeltas(ws);
+        computeReactions(ws);
+        m_deltas.assign(ws.deltas.begin(), ws.deltas.end()); // Сохраняем для пост-процессинга
+
+        // Пост-процессорные расчеты
+        calculatePostProcessing(ws.deltas, ws.results, ws.range);
+
+        /*output += QString("\n Проверка макс. напряжений σ(x): \n");
+        for (size_t j = 0; j < res.sigma.size(); j++) {
+            const Core_of_Beam& beam = (*m_beamData)[i];
+            double max_voltage = beam.maxVoltage;
+
+            if (std::abs(res.sigma[i]) > max_voltage) {
+
+            }
+        }*/
+
+        // Копирующее присваивание переиспользует векторы прошлого расчета
+        results_force = ws.results;
+        m_calculationSucceeded = true;
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка расчета: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+void cProcessor::showCalculationResults()
+{
+    if (!m_calculationSucceeded) return;
+
+    showSolveReport();
+    displayResults(m_workspace.A, m_deltas, m_workspace.constraints);
+	//	showPostProcessingResults(results_force);
+    showPostProcessingResultsAsTable(results_force);
+}
+
+void cProcessor::displayResults(const SparseMatrix& A,
+    const std::vector<double>& deltas, const SupportConstraints& constraints)
+{
+    QString output;
+    output += QString(60, '=') + "\n";
+    output += "РЕЗУЛЬТАТЫ РАСЧЕТА ПРОЦЕССОРА\n";
+    output += QString(60, '=') + "\n\n";
+
+    /*output += "Матрица жесткости A:\n";
+    
+    for (size_t i = 0; i < A.size(); i++) {
+        for (size_t j = 0; j < A[i].size(); j++) {
+            output += QString("%1 ").arg(A[i][j], 9, 'f', 4);
+        }
+        output += "\n";
+    }*/
+
+    output += "\nУзловые перемещения Δ:\n";
+    for (size_t i = 0; i < deltas.size(); i++) {
+        output += QString("  Δ[%1] = %2\n").arg(i).arg(deltas[i]);
+    }
+
+    // Реакции опор; сумма реакций и нагрузок — проверка равновесия
+    output += "\nРеакции опор R:\n";
+    double balance = 0.0;
+    for (size_t c = 0; c < constraints.nodes.size(); c++) {
+        output += QString("  R[%1] = %2").arg(constraints.nodes[c]).arg(constraints.reactions[c]);
+        if (constraints.values[c] != 0.0) {
+            output += QString("   (заданное перемещение %1)").arg(constraints.values[c]);
+        }
+        output += "\n";
+        balance += constraints.reactions[c];
+    }
+    for (size_t s = 0; s < constraints.springNodes.size(); s++) {
+        output += QString("  R[%1] = %2   (пружина k = %3)\n").arg(constraints.springNodes[s])
+            .arg(constraints.springReactions[s]).arg(constraints.springStiffness[s]);
+        balance += constraints.springReactions[s];
+    }
+    balance += constraints.totalLoad;
+    output += QString("  ΣR + ΣF = %1\n").arg(balance, 0, 'e', 3);
+
+    ui.textEdit_p_1->append(output);
+}
+
+void cProcessor::createMatrix_A(SparseBuilder& builder, SparseMatrix& A,
+    std::vector<char>& springApplied)
+{
+    if (!m_beamData || m_beamData->empty()) {
+        throw std::runtime_error("No beam data available");
+    }
+
+    int num_beams = m_beamData->size();
+    int num_dof = m_numNodes;
+
+    // Сборка по связности элемент-узел: матрица разреженная при любой топологии
+    builder.reset(num_dof);
+    builder.reserve(4 * static_cast<size_t>(num_beams));
+
+    for (int e = 0; e < num_beams; ++e) {
+        const Core_of_Beam& beam = (*m_beamData)[e];
+        double L = beam.len_L;
+
+        if (std::abs(L) < 1e-9) {
+            throw std::runtime_error("Beam has near-zero length");
+        }
+
+        // Локальная жесткость: k = EA/L, для переменного сечения — по квадратуре
+        double k_local = barStiffness(beam);
+        int i = beam.node_left;
+        int j = beam.node_right;
+
+        // Добавление вклада в глобальную матрицу
+        builder.add(i, i, k_local);
+        builder.add(i, j, -k_local);
+        builder.add(j, i, -k_local);
+        builder.add(j, j, k_local);
+    }
+
+    // Упругие опоры на землю: k на диагональ узла, в общем узле — один раз
+    springApplied.assign(num_dof, 0);
+    auto addSpring = [&](int node, const Joint_info& joint) {
+        if (joint.springStiffness <= 0.0 || springApplied[node]) return;
+        builder.add(node, node, joint.springStiffness);
+        springApplied[node] = 1;
+    };
+    for (const Core_of_Beam& beam : *m_beamData) {
+        addSpring(beam.node_left, beam.Joint_left);
+        addSpring(beam.rightJointNode(), beam.Joint_right);
+    }
+
+    builder.toCSR(A);
+}
+
+
+void cProcessor::createVector_B(std::vector<double>& B, std::vector<char>& forceApplied)
+{
+    int num_beams = m_beamData->size();
+    int num_dof = m_numNodes;
+    B.assign(num_dof, 0.0);
+
+    //  Распределенные нагрузки
+    for (int i = 0; i < num_beams; ++i) {
+        const Core_of_Beam& beam = (*m_beamData)[i];
+
+        // Эквивалентные узловые силы от q и стесненного свободного удлинения
+        // ε_T; при постоянном сечении q*L/2 ∓ EA·ε_T на каждый узел
+        double q_left, q_right;
+        barEquivalentLoads(beam, q_left, q_right);
+
+        B[beam.node_left] += q_left;
+        B[beam.node_right] += q_right;
+    }
+
+    //  Сосредоточенные силы: в общем узле сила видна со всех стержней,
+    //  учитываем ее один раз
+    forceApplied.assign(num_dof, 0);
+    for (int i = 0; i < num_beams; ++i) {
+        const Core_of_Beam& beam = (*m_beamData)[i];
+
+        if (!forceApplied[beam.node_left]) {
+            B[beam.node_left] += beam.Joint_left.force_f;
+            forceApplied[beam.node_left] = 1;
+        }
+        int right = beam.rightJointNode();
+        if (!forceApplied[right]) {
+            B[right] += beam.Joint_right.force_f;
+            forceApplied[right] = 1;
+        }
+    }
+}
+
+
+void cProcessor::markSupports(std::vector<char>& fixed, std::vector<double>& prescribed, int n)
+{
+    fixed.assign(n, 0);
+    prescribed.assign(n, 0.0);
+
+    // Опора может стоять в любом узле, в том числе промежуточном;
+    // узел, общий для двух стержней, виден с обеих сторон
+    auto markSupport = [&](int node, const Joint_info& joint) {
+        if (joint.fixedSupport != 1) return;
+        if (fixed[node] && prescribed[node] != joint.settlement) {
+            throw std::runtime_error("Conflicting prescribed displacements at one node");
+        }
+        fixed[node] = 1;
+        prescribed[node] = joint.settlement;
+    };
+    for (const Core_of_Beam& beam : *m_beamData) {
+        markSupport(beam.node_left, beam.Joint_left);
+        markSupport(beam.rightJointNode(), beam.Joint_right);
+    }
+}
+
+void cProcessor::applyBoundaryConditions(SolverWorkspace& ws)
+{
+    SparseMatrix& A = ws.A;
+    std::vector<double>& B = ws.B;
+    std::vector<char>& fixed = ws.fixedNodes;
+    std::vector<double>& prescribed = ws.prescribed;
+    SupportConstraints& sc = ws.constraints;
+    markSupports(fixed, prescribed, A.n);
+
+    // Пружины: жесткость уже в A, здесь — список для реакций
+    sc.springNodes.clear();
+    sc.springStiffness.clear();
+    for (const Core_of_Beam& beam : *m_beamData) {
+        for (auto [node, joint] : { std::pair{ beam.node_left, &beam.Joint_left },
+                                    std::pair{ beam.rightJointNode(), &beam.Joint_right } }) {
+            if (joint->springStiffness <= 0.0 || fixed[node]) continue;
+            if (std::find(sc.springNodes.begin(), sc.springNodes.end(), node) != sc.springNodes.end()) continue;
+            sc.springNodes.push_back(node);
+            sc.springStiffness.push_back(joint->springStiffness);
+        }
+    }
+
+    // Зазоры: замкнутый контакт — пружина-штраф, на несколько порядков
+    // жестче стержней по обе стороны зазора. Штраф по соседним, а не по
+    // самому жесткому стержню модели: иначе у мягких стержней рядом с
+    // контактом ведущий элемент разложения теряется на фоне штрафа
+    ws.gaps.clear();
+    for (const Core_of_Beam& beam : *m_beamData) {
+        if (beam.gap_node < 0) continue;
+        ws.gaps.push_back({ beam.node_right, beam.gap_node, beam.Joint_right.gap, 0.0 });
+    }
+    if (!ws.gaps.empty()) {
+        std::vector<double>& nodeStiffness = ws.nodeStiffness;
+        nodeStiffness.assign(A.n, 0.0);
+        for (const Core_of_Beam& beam : *m_beamData) {
+            double k = barStiffness(beam);
+            nodeStiffness[beam.node_left] = std::max(nodeStiffness[beam.node_left], k);
+            nodeStiffness[beam.node_right] = std::max(nodeStiffness[beam.node_right], k);
+        }
+        for (GapElement& gap : ws.gaps) {
+            gap.stiffness = GapPenaltyFactor
+                * std::max(nodeStiffness[gap.nodeA], nodeStiffness[gap.nodeB]);
+        }
+    }
+
+    // Исходные строки опорных узлов нужны для реакций
+    sc.totalLoad = 0.0;
+    for (double load : B) {
+        sc.totalLoad += load;
+    }
+    sc.nodes.clear();
+    sc.values.clear();
+    sc.loads.clear();
+    sc.rowPtr.assign(1, 0);
+    sc.cols.clear();
+    sc.coeffs.clear();
+    for (int node = 0; node < A.n; ++node) {
+        if (!fixed[node]) continue;
+        sc.nodes.push_back(node);
+        sc.values.push_back(prescribed[node]);
+        sc.loads.push_back(B[node]);
+        for (int k = A.rowPtr[node]; k < A.rowPtr[node + 1]; ++k) {
+            sc.cols.push_back(A.colIdx[k]);
+            sc.coeffs.push_back(A.values[k]);
+        }
+        sc.rowPtr.push_back(static_cast<int>(sc.cols.size()));
+    }
+
+    // Известные перемещения переносятся в правую часть свободных уравнений:
+    // B_j -= A_jc * u_c, по симметрии A_jc берется из строки c
+    for (size_t c = 0; c < sc.nodes.size(); ++c) {
+        double u = sc.values[c];
+        if (u == 0.0) continue;
+        for (int k = sc.rowPtr[c]; k < sc.rowPtr[c + 1]; ++k) {
+            int j = sc.cols[k];
+            if (!fixed[j]) {
+                B[j] -= sc.coeffs[k] * u;
+            }
+        }
+    }
+
+    // Исключение: строка и столбец опорного узла обнуляются, на диагонали 1,
+    // в правой части — заданное перемещение. Шаблон и симметрия сохраняются,
+    // поэтому работают все решатели, а стоимость — O(nnz)
+    for (size_t c = 0; c < sc.nodes.size(); ++c) {
+        int node = sc.nodes[c];
+        for (int k = A.rowPtr[node]; k < A.rowPtr[node + 1]; ++k) {
+            int col = A.colIdx[k];
+            if (col == node) {
+                A.values[k] = 1.0;
+                continue;
+            }
+            A.values[k] = 0.0;
+            if (double* sym = A.find(col, node)) {
+                *sym = 0.0;
+            }
+        }
+        B[node] = sc.values[c];
+    }
+}
+
+void cProcessor::computeReactions(SolverWorkspace& ws)
+{
+    SupportConstraints& sc = ws.constraints;
+    sc.reactions.resize(sc.nodes.size());
+    for (size_t c = 0; c < sc.nodes.size(); ++c) {
+        double sum = 0.0;
+        for (int k = sc.rowPtr[c]; k < sc.rowPtr[c + 1]; ++k) {
+            sum += sc.coeffs[k] * ws.deltas[sc.cols[k]];
+        }
+        sc.reactions[c] = sum - sc.loads[c];
+    }
+
+    // Замкнутый контакт передает усилие на опору, которой он касается
+    for (size_t g = 0; g < ws.gaps.size(); ++g) {
+        double force = ws.contact.forces[g];
+        if (force == 0.0) continue;
+        for (size_t c = 0; c < sc.nodes.size(); ++c) {
+            if (sc.nodes[c] == ws.gaps[g].nodeA) sc.reactions[c] += force;
+            if (sc.nodes[c] == ws.gaps[g].nodeB) sc.reactions[c] -= force;
+        }
+    }
+
+    sc.springReactions.resize(sc.springNodes.size());
+    for (size_t s = 0; s < sc.springNodes.size(); ++s) {
+        sc.springReactions[s] = -sc.springStiffness[s] * ws.deltas[sc.springNodes[s]];
+    }
+}
+
+void cProcessor::findDeltas(SolverWorkspace& ws)
+{
+    const SparseMatrix& A = ws.A;
+    const std::vector<double>& B = ws.B;
+    int n = B.size();
+    if (A.n != n) {
+        throw std::runtime_error("Matrix A must be square");
+    }
+
+    m_solveReport = SolveReport::None;
+
+    // Зазоры делают задачу односторонней: активное множество контактов
+    // с переиспользованием разложения, остальные решатели не применимы
+    if (!ws.gaps.empty()) {
+        ContactReport& report = ws.contact;
+        ws.deltas = solveWithGaps(A, B, ws.gaps, ws.fixedNodes, ws.prescribed, report);
+
+        m_solveReport = SolveReport::Contact;
+        return;
+    }
+
+    // Режимы точности: прямой решатель с масштабированием и уточнением,
+    // метрики точности идут в отчет. Быстрый режим — для серийных
+    // расчетов: без оценки обусловленности, и малые модели и цепочки идут
+    // своими прямыми путями, они и так точны
+    const bool refined = m_solverKind != SolverKind::Iterative && m_precisionMode == PrecisionMode::Refined;
+    const bool fast = m_solverKind != SolverKind::Iterative && m_precisionMode == PrecisionMode::Fast;
+    auto solveRefined = [&]() {
+        if (!ws.samePattern(A)) {
+            ws.perm.clear();
+        }
+        ws.deltas = solveWithRefinement(A, B, ws.perm, m_accuracyReport, 5,
+            fast ? FactorPrecision::Single : FactorPrecision::Double, refined);
+        m_solveReport = SolveReport::Accuracy;
+    };
+    if (refined) {
+        solveRefined();
+        return;
+    }
+
+    // Малые модели: разложение фиксированного размера без выделения памяти
+    if (m_solverKind != SolverKind::Iterative && n <= FixedSolverMaxSize) {
+        solveFixedSize(A, B, ws.deltas);
+        return;
+    }
+
+    // Цепочка без ветвлений дает трехдиагональную матрицу: прогонка точнее
+    // и быстрее любого другого решателя, длинные цепочки делятся по потокам
+    if (m_solverKind != SolverKind::Iterative && extractTridiagonal(A, ws.chain)) {
+        solveTridiagonalParallel(ws.chain, B, ws.deltas, ws.sweep);
+        return;
+    }
+
+    if (fast) {
+        solveRefined();
+        return;
+    }
+
+    bool iterative = m_solverKind == SolverKind::Iterative ||
+        (m_solverKind == SolverKind::Auto && n > IterativeSolverThreshold);
+
+    if (iterative) {
+        ws.deltas = solvePCG(A, B, m_pcgOptions, m_pcgReport);
+        m_solveReport = SolveReport::Pcg;
+        return;
+    }
+
+    // Перенумерация RCM сужает профиль, разложение Холецкого идет только по нему.
+    // Перестановка зависит только от шаблона, при том же шаблоне она переиспользуется
+    if (!ws.samePattern(A)) {
+        ws.perm = reverseCuthillMcKee(A);
+    }
+    ws.cholesky.factorize(A, ws.perm);
+    ws.cholesky.solve(B, ws.deltas);
+}
+
+// Отчет решателя последнего расчета: данные сохранены в findDeltas
+void cProcessor::showSolveReport()
+{
+    switch (m_solveReport) {
+    case SolveReport::Contact: {
+        const ContactReport& report = m_workspace.contact;
+        QString info = QString("Контакт: итераций %1, разложений %2, решений с поправкой ранга %3\n")
+            .arg(report.iterations).arg(report.factorizations).arg(report.lowRankUpdates);
+        for (size_t g = 0; g < m_workspace.gaps.size(); ++g) {
+            const GapElement& gap = m_workspace.gaps[g];
+            info += QString("  Зазор %1 между узлами %2 и %3: %4")
+                .arg(g + 1).arg(gap.nodeA).arg(gap.nodeB).arg(gap.clearance);
+            info += report.closed[g]
+                ? QString(" — замкнут, усилие %1\n").arg(report.forces[g])
+                : QString(" — открыт\n");
+        }
+        if (!report.converged) {
+            info += "Внимание: состояние контактов не установилось, результат неточен\n";
+        }
+        // Выбор решателя и режим точности к контактной задаче не применяются
+        if (m_solverKind != SolverKind::Auto || m_precisionMode != PrecisionMode::Standard) {
+            info += "Внимание: модель с зазорами решается прямым разложением, выбранные "
+                "решатель и режим точности не применены\n";
+        }
+        ui.textEdit_p_1->append(info);
+        break;
+    }
+    case SolveReport::Accuracy: {
+        const AccuracyReport& report = m_accuracyReport;
+        const bool refined = m_precisionMode == PrecisionMode::Refined;
+        QString info = QString("Режим точности: масштабирование диагональю, RCM + Холецкий (%1)\n")
+            .arg(report.precision == FactorPrecision::Single ? "float32, уточнение в double" : "double");
+        if (report.singleFallback) {
+            info += "  Разложение во float32 не обеспечило точности double, выполнено в double\n";
+        }
+        if (refined) {
+            info += QString("  Оценка числа обусловленности cond(A) = %1, после масштабирования %2\n")
+                .arg(report.conditionEstimate, 0, 'e', 2)
+                .arg(report.scaledConditionEstimate, 0, 'e', 2);
+        }
+        info += QString("  Шагов уточнения: %1, последняя поправка %2\n")
+            .arg(report.refinementSteps)
+            .arg(report.lastCorrection, 0, 'e', 2);
+        info += QString("  Обратная ошибка ||B - AΔ|| / (||A||·||Δ|| + ||B||) = %1\n")
+            .arg(report.backwardError, 0, 'e', 2);
+        if (refined) {
+            info += QString("  Оценка относительной ошибки Δ: %1\n")
+                .arg(std::max(report.conditionEstimate * report.backwardError,
+                    std::numeric_limits<double>::epsilon()), 0, 'e', 2);
+        }
+
+        // Без сходимости уточнения ошибка Δ — порядка cond * eps
+        if (!report.converged) {
+            info += "  Внимание: уточнение не сошлось";
+            if (refined) {
+                double expectedError = report.scaledConditionEstimate * std::numeric_limits<double>::epsilon();
+                info += QString(", в перемещениях верно лишь около %1 значащих цифр")
+                    .arg(std::max(0, static_cast<int>(-std::log10(std::max(expectedError, 1e-16)))));
+            }
+            info += "\n";
+        }
+        // Погрешность исходных E, A, L усиливается в перемещениях до cond раз
+        if (report.conditionEstimate > 1e8) {
+            info += "  Внимание: система плохо обусловлена, результаты чувствительны "
+                "к погрешности исходных данных\n";
+        }
+        ui.textEdit_p_1->append(info);
+        break;
+    }
+    case SolveReport::Pcg: {
+        const PcgReport& report = m_pcgReport;
+        QString info = QString("PCG (%1): итераций %2, относительная невязка %3\n")
+            .arg(m_pcgOptions.preconditioner == Preconditioner::Jacobi ? "Якоби" : "IC(0)")
+            .arg(report.iterations)
+            .arg(report.relativeResidual, 0, 'e', 3);
+        if (!report.converged) {
+            info += QString("Внимание: заданная точность %1 не достигнута\n")
+                .arg(m_pcgOptions.tolerance, 0, 'e', 1);
+        }
+        if (m_solverKind == SolverKind::Iterative && m_precisionMode != PrecisionMode::Standard) {
+            info += "Режим точности прямого решателя при PCG не применяется\n";
+        }
+        ui.textEdit_p_1->append(info);
+        break;
+    }
+    case SolveReport::None:
+        break;
+    }
+}
+
+// Замер прогонки на однородной цепочке с заделом слева: 1, 2, 4 ... потоков
+void cProcessor::benchmarkChainSolver(int numNodes)
+{
+    TridiagonalMatrix chain;
+    chain.lower.assign(numNodes, -1.0);
+    chain.diag.assign(numNodes, 2.0);
+    chain.upper.assign(numNodes, -1.0);
+    chain.diag[numNodes - 1] = 1.0;
+    std::vector<double> B(numNodes, 1.0);
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<double> reference = solveThomas(chain, B);
+    double serialMs = timer.nsecsElapsed() / 1e6;
+
+    QString output = QString("Прогонка цепочки из %1 узлов\n").arg(numNodes);
+    output += QString("  %1 %2 %3\n").arg("Потоков", 8).arg("Время, мс", 12).arg("Ускорение", 10);
+    output += QString("  %1 %2 %3\n").arg("Томас", 8).arg(serialMs, 12, 'f', 2).arg(1.0, 10, 'f', 2);
+
+    // Степени двойки меньше числа потоков пула, затем само это число
+    const int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(std::max(1, maxThreads));
+    for (int threads : threadCounts) {
+        timer.restart();
+        std::vector<double> x = solveTridiagonalParallel(chain, B, threads);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        double error = 0.0;
+        for (int i = 0; i < numNodes; ++i) {
+            error = std::max(error, std::abs(x[i] - reference[i]));
+        }
+        output += QString("  %1 %2 %3   (отклонение %4)\n")
+            .arg(threads, 8).arg(ms, 12, 'f', 2).arg(serialMs / ms, 10, 'f', 2)
+            .arg(error / std::abs(reference.back()), 0, 'e', 1);
+    }
+
+    QMetaObject::invokeMethod(this, [this, output]() {
+        ui.textEdit_p_1->append(output);
+        }, Qt::QueuedConnection);
+}
+
+// ==================== МОДАЛЬНЫЙ АНАЛИЗ ====================
+
+void cProcessor::createMatrix_M(SparseBuilder& builder, SparseMatrix& M, bool lumped)
+{
+    builder.reset(m_numNodes);
+    builder.reserve(4 * m_beamData->size());
+
+    for (const Core_of_Beam& beam : *m_beamData) {
+        if (!(beam.density > 0.0)) {
+            throw std::runtime_error("Bar density must be set for modal analysis");
+        }
+        double m11, m12, m22;
+        barMass(beam, lumped, m11, m12, m22);
+        int i = beam.node_left;
+        int j = beam.node_right;
+
+        builder.add(i, i, m11);
+        builder.add(i, j, m12);
+        builder.add(j, i, m12);
+        builder.add(j, j, m22);
+    }
+
+    builder.toCSR(M);
+}
+
+void cProcessor::modalAnalysis(int count)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+
+        // Жесткость с пружинами, масса; опорные узлы исключаются,
+        // зазоры считаются открытыми
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createMatrix_M(ws.builder, ws.M, m_lumpedMass);
+        markSupports(ws.fixedNodes, ws.prescribed, ws.A.n);
+        if (!extractChainPair(ws.A, ws.M, ws.fixedNodes, ws.chain, ws.chainMass, ws.modalNodes)) {
+            throw std::runtime_error("Modal analysis supports chains of bars without branches");
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        ModalResult modal = solveTridiagonalModes(ws.chain, ws.chainMass, count,
+            std::min(count, ModalShapesShown));
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "СОБСТВЕННЫЕ ПРОДОЛЬНЫЕ КОЛЕБАНИЯ\n";
+        output += QString(60, '=') + "\n";
+        output += QString("Матрица масс: %1, свободных узлов: %2\n")
+            .arg(m_lumpedMass ? "сосредоточенная" : "согласованная").arg(ws.chain.size());
+        output += QString("Время %1 мс: проходов Штурма %2, шагов обратной итерации %3, невязка форм %4\n\n")
+            .arg(ms, 0, 'f', 2).arg(modal.sturmCounts).arg(modal.inverseIterations)
+            .arg(modal.maxResidual, 0, 'e', 1);
+
+        output += QString("%1 %2 %3 %4\n").arg("№", 6).arg("ω, рад/с", 16).arg("f, Гц", 16).arg("T, с", 16);
+        for (size_t k = 0; k < modal.eigenvalues.size(); ++k) {
+            // Нулевая частота — смещение цепочки без опор как целого
+            double omega = std::sqrt(std::max(modal.eigenvalues[k], 0.0));
+            double f = omega / (2.0 * std::numbers::pi);
+            output += QString("%1 %2 %3 %4\n").arg(k + 1, 6)
+                .arg(omega, 16, 'g', 10).arg(f, 16, 'g', 10)
+                .arg(f > 0.0 ? QString::number(1.0 / f, 'g', 10) : QString("∞"), 16);
+        }
+
+        // Формы в исходной нумерации узлов, опорные узлы — нули
+        if (!modal.modes.empty() && m_numNodes <= ModalShapeRowsLimit) {
+            output += "\nФормы колебаний (нормированы φᵀMφ = 1):\n";
+            output += QString("%1").arg("Узел", 6);
+            for (size_t k = 0; k < modal.modes.size(); ++k) {
+                output += QString(" %1").arg(QString("φ%1").arg(k + 1), 16);
+            }
+            output += "\n";
+            std::vector<int> row(m_numNodes, -1);
+            for (size_t p = 0; p < ws.modalNodes.size(); ++p) {
+                row[ws.modalNodes[p]] = static_cast<int>(p);
+            }
+            for (int node = 0; node < m_numNodes; ++node) {
+                output += QString("%1").arg(node, 6);
+                for (const std::vector<double>& mode : modal.modes) {
+                    output += QString(" %1").arg(row[node] < 0 ? 0.0 : mode[row[node]], 16, 'g', 8);
+                }
+                output += "\n";
+            }
+        }
+        output += "\n";
+
+        QMetaObject::invokeMethod(this, [this, output]() {
+            ui.textEdit_p_1->append(output);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка модального анализа: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+// ==================== УПРУГОПЛАСТИЧЕСКИЙ РАСЧЕТ ====================
+
+void cProcessor::plasticAnalysis(PlasticOptions options)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+
+        // Все нагрузки, ε_T и осадки растут пропорционально λ; зазоры открыты
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createVector_B(ws.B, ws.forceApplied);
+        markSupports(ws.fixedNodes, ws.prescribed, ws.A.n);
+
+        // Стержень — один элемент с постоянным N: течет по среднему усилию,
+        // предел — σ_т по наименьшему сечению
+        std::vector<PlasticBar> bars;
+        bool hasGaps = false;
+        for (const Core_of_Beam& beam : *m_beamData) {
+            hasGaps = hasGaps || beam.gap_node >= 0;
+            double left, right;
+            barEquivalentLoads(beam, left, right);
+            double ratio = beam.tangentModulus > 0.0 ? beam.tangentModulus / beam.mod_elasticity : 0.0;
+            bars.push_back({ beam.node_left, beam.node_right, barStiffness(beam), 0.5 * (left - right),
+                beam.maxVoltage * beam.section.minArea(beam.selectArea_A), ratio });
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        PlasticReport report;
+        solvePlastic(ws.A, ws.B, bars, ws.fixedNodes, ws.prescribed, options, report);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "УПРУГОПЛАСТИЧЕСКИЙ РАСЧЕТ\n";
+        output += QString(60, '=') + "\n";
+        if (hasGaps) {
+            output += "Внимание: зазоры в упругопластическом расчете считаются открытыми\n";
+        }
+        if (report.firstYieldBar < 0) {
+            output += "Ни один стержень не достигает текучести (σ_т не задан или N = 0)\n";
+        }
+        else {
+            output += QString("Первая текучесть: λ = %1, стержень %2\n")
+                .arg(report.firstYieldFactor, 0, 'g', 8).arg(report.firstYieldBar + 1);
+            if (report.collapsed) {
+                output += QString("Разрушение (механизм): λ = %1, при λ = %2 равновесия уже нет\n")
+                    .arg(report.collapseFactor, 0, 'g', 8).arg(report.collapseBracket, 0, 'g', 8);
+                output += QString("Запас после первой текучести: %1\n")
+                    .arg(report.collapseFactor / report.firstYieldFactor, 0, 'f', 4);
+            }
+            else {
+                output += QString("Разрушение не достигнуто до λ = %1\n").arg(report.loadFactor, 0, 'g', 8);
+            }
+        }
+        output += QString("Время %1 мс: итераций Ньютона %2, делений шага %3, разложений %4, "
+            "решений с поправкой Вудбери %5\n\n")
+            .arg(ms, 0, 'f', 2).arg(report.newtonIterations).arg(report.cutbacks)
+            .arg(report.factorizations).arg(report.lowRankSolves);
+
+        output += "История нагружения:\n";
+        output += QString("%1 %2 %3 %4 %5 %6\n").arg("Шаг", 6).arg("λ", 14).arg("Итераций", 9)
+            .arg("Текут", 7).arg("max |Δ|", 14).arg("Невязка", 10);
+        const int numSteps = static_cast<int>(report.history.size());
+        for (int s = 0; s < numSteps; ++s) {
+            if (numSteps > PlasticHistoryRowsLimit && s == PlasticHistoryRowsLimit / 2) {
+                output += QString("%1\n").arg("...", 6);
+                s = numSteps - PlasticHistoryRowsLimit / 2;
+            }
+            const PlasticStep& step = report.history[s];
+            output += QString("%1 %2 %3 %4 %5 %6\n").arg(s, 6).arg(step.loadFactor, 14, 'g', 8)
+                .arg(step.iterations, 9).arg(step.yieldedBars, 7)
+                .arg(step.maxDisplacement, 14, 'g', 6).arg(step.residual, 10, 'e', 1);
+        }
+
+        output += QString("\nСостояние при λ = %1:\n").arg(report.loadFactor, 0, 'g', 8);
+        output += QString("%1 %2 %3 %4 %5\n").arg("Стерж.", 6).arg("N", 14).arg("N_т", 14)
+            .arg("δ_пл", 14).arg("Состояние", 10);
+        for (size_t b = 0; b < bars.size(); ++b) {
+            output += QString("%1 %2 %3 %4 %5\n").arg(b + 1, 6)
+                .arg(report.forces[b], 14, 'g', 8)
+                .arg(bars[b].yieldForce > 0.0 ? QString::number(bars[b].yieldForce, 'g', 8) : QString("—"), 14)
+                .arg(report.plasticElongation[b], 14, 'g', 6)
+                .arg(report.yielding[b] ? "текучесть" : "упруго", 10);
+        }
+        output += "\n";
+
+        QMetaObject::invokeMethod(this, [this, output]() {
+            ui.textEdit_p_1->append(output);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка упругопластического расчета: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+// ==================== БОЛЬШИЕ ПЕРЕМЕЩЕНИЯ ====================
+
+void cProcessor::largeDisplacementAnalysis(GeometricOptions options)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+
+        // Пролетные нагрузки — узловыми эквивалентами, не следящие; зазоры открыты
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createVector_B(ws.B, ws.forceApplied);
+        markSupports(ws.fixedNodes, ws.prescribed, ws.A.n);
+
+        std::vector<GeometricBar> bars;
+        bool hasGaps = false;
+        for (const Core_of_Beam& beam : *m_beamData) {
+            hasGaps = hasGaps || beam.gap_node >= 0;
+            double left, right;
+            barEquivalentLoads(beam, left, right);
+            bars.push_back({ beam.node_left, beam.node_right, barStiffness(beam), beam.len_L,
+                0.5 * (left - right) });
+        }
+
+        // Разложение и перестановка — из рабочего места прямого решателя
+        if (!ws.samePattern(ws.A)) {
+            ws.perm.clear();
+        }
+        QElapsedTimer timer;
+        timer.start();
+        GeometricReport report;
+        std::vector<double> deltas = solveLargeDisplacement(ws.A, ws.B, bars, ws.fixedNodes,
+            ws.prescribed, options, ws.cholesky, ws.perm, report);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "РАСЧЕТ С БОЛЬШИМИ ПЕРЕМЕЩЕНИЯМИ\n";
+        output += QString(60, '=') + "\n";
+        output += "Деформация ln(l/L), касательная жесткость EA/l по текущей длине\n";
+        if (hasGaps) {
+            output += "Внимание: зазоры в нелинейном расчете считаются открытыми\n";
+        }
+        output += QString("Время %1 мс: итераций %2, разложений %3, пересобрано вкладов стержней %4, "
+            "делений шага %5\n\n")
+            .arg(ms, 0, 'f', 2).arg(report.iterations).arg(report.factorizations)
+            .arg(report.barUpdates).arg(report.cutbacks);
+
+        output += "Шаги нагружения (невязка ||r||/||F|| по итерациям):\n";
+        for (size_t s = 0; s < report.steps.size(); ++s) {
+            const GeometricStep& step = report.steps[s];
+            QStringList residuals;
+            for (double value : step.residuals) {
+                residuals << QString::number(value, 'e', 1);
+            }
+            output += QString("  λ = %1: итераций %2, разложений %3 | %4\n")
+                .arg(step.loadFactor, 0, 'f', 4).arg(step.iterations).arg(step.factorizations)
+                .arg(residuals.join(" "));
+        }
+
+        if (m_numNodes <= LargeDisplacementRowsLimit) {
+            output += QString("\n%1 %2 %3 %4\n").arg("Узел", 6).arg("Δ", 16).arg("Δ линейн.", 16)
+                .arg("Разница, %", 12);
+            for (int node = 0; node < m_numNodes; ++node) {
+                double linear = report.linearDisplacements[node];
+                output += QString("%1 %2 %3 %4\n").arg(node, 6).arg(deltas[node], 16, 'g', 10)
+                    .arg(linear, 16, 'g', 10)
+                    .arg(linear != 0.0 ? QString::number(100.0 * (deltas[node] - linear) / std::abs(linear), 'f', 3)
+                        : QString("—"), 12);
+            }
+            output += QString("\n%1 %2 %3 %4\n").arg("Стерж.", 6).arg("N", 16).arg("l/L", 16)
+                .arg("ln(l/L)", 12);
+            for (size_t b = 0; b < bars.size(); ++b) {
+                output += QString("%1 %2 %3 %4\n").arg(b + 1, 6).arg(report.forces[b], 16, 'g', 10)
+                    .arg(report.stretches[b], 16, 'g', 10)
+                    .arg(std::log(report.stretches[b]), 12, 'g', 6);
+            }
+        }
+        output += "\n";
+
+        QMetaObject::invokeMethod(this, [this, output]() {
+            ui.textEdit_p_1->append(output);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка расчета с большими перемещениями: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+// ==================== ПОДБОР СЕЧЕНИЙ ====================
+
+void cProcessor::optimizeAreas(SizingOptions options)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+        createVector_B(ws.B, ws.forceApplied);
+        markSupports(ws.fixedNodes, ws.prescribed, m_numNodes);
+
+        // Узловые силы — B без эквивалентных нагрузок стержней: у проектных
+        // стержней пара от ε_T пересчитывается по новой площади
+        std::vector<SizingBar> bars;
+        std::vector<double> loads = ws.B;
+        bool hasGaps = false;
+        for (const Core_of_Beam& beam : *m_beamData) {
+            hasGaps = hasGaps || beam.gap_node >= 0;
+            double left, right;
+            barEquivalentLoads(beam, left, right);
+            loads[beam.node_left] -= left;
+            loads[beam.node_right] -= right;
+
+            SizingBar bar{ beam.node_left, beam.node_right, beam.len_L, beam.mod_elasticity,
+                beam.selectArea_A, beam.maxVoltage, left, right, beam.freeStrain() };
+            if (beam.section.isConstant()) {
+                double thermal = beam.mod_elasticity * beam.selectArea_A * beam.freeStrain();
+                bar.loadLeft += thermal;
+                bar.loadRight -= thermal;
+            }
+            else {
+                bar.designable = false;
+                bar.stiffness = barStiffness(beam);
+            }
+            bars.push_back(bar);
+        }
+
+        // Пружины на землю, в общем узле — одна, как в createMatrix_A
+        std::vector<double> springs(m_numNodes, 0.0);
+        auto addSpring = [&springs](int node, const Joint_info& joint) {
+            if (joint.springStiffness > 0.0 && springs[node] == 0.0) springs[node] = joint.springStiffness;
+        };
+        for (const Core_of_Beam& beam : *m_beamData) {
+            addSpring(beam.node_left, beam.Joint_left);
+            addSpring(beam.rightJointNode(), beam.Joint_right);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        SizingReport report;
+        std::vector<double> areas = optimizeSections(bars, m_numNodes, loads, springs,
+            ws.fixedNodes, ws.prescribed, options, report);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "ПОДБОР СЕЧЕНИЙ\n";
+        output += QString(60, '=') + "\n";
+        if (hasGaps) {
+            output += "Внимание: зазоры при подборе сечений считаются открытыми\n";
+        }
+        output += QString("Объем %1 → %2 м³ (%3%)\n").arg(report.initialVolume, 0, 'g', 8)
+            .arg(report.volume, 0, 'g', 8)
+            .arg(100.0 * (report.volume - report.initialVolume) / report.initialVolume, 0, 'f', 2);
+        output += report.converged ? QString("Сошлось за %1 итераций").arg(report.history.size())
+            : QString("Не сошлось за %1 итераций, проект может нарушать ограничения").arg(report.history.size());
+        output += QString(", время %1 мс: разложений %2, сопряженных решений %3\n\n")
+            .arg(ms, 0, 'f', 2).arg(report.factorizations).arg(report.adjointSolves);
+
+        output += QString("%1 %2 %3 %4 %5\n").arg("Итер.", 6).arg("Объем", 14).arg("max σ/σ_max", 12)
+            .arg("max Δ/Δmax", 12).arg("max ΔA/A", 10);
+        for (size_t k = 0; k < report.history.size(); ++k) {
+            const SizingIteration& it = report.history[k];
+            output += QString("%1 %2 %3 %4 %5\n").arg(k + 1, 6).arg(it.volume, 14, 'g', 8)
+                .arg(it.maxStressRatio, 12, 'f', 4)
+                .arg(options.displacementLimits.empty() ? QString("—") : QString::number(it.maxDisplacementRatio, 'f', 4), 12)
+                .arg(it.maxChange, 10, 'e', 1);
+        }
+
+        if (static_cast<int>(bars.size()) <= SizingRowsLimit) {
+            output += QString("\n%1 %2 %3 %4\n").arg("Стерж.", 6).arg("A было", 14).arg("A стало", 14)
+                .arg("σ/σ_max", 10);
+            for (size_t b = 0; b < bars.size(); ++b) {
+                output += QString("%1 %2 %3 %4%5\n").arg(b + 1, 6).arg(bars[b].area, 14, 'g', 6)
+                    .arg(areas[b], 14, 'g', 6).arg(report.stressRatios[b], 10, 'f', 4)
+                    .arg(bars[b].designable ? "" : "  (переменное сечение, не подбирается)");
+            }
+        }
+        output += "\nПлощади записаны в модель\n\n";
+
+        QMetaObject::invokeMethod(this, [this, output, areas]() {
+            ui.textEdit_p_1->append(output);
+            emit sendAreas(areas);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка подбора сечений: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+// ==================== ЧУВСТВИТЕЛЬНОСТЬ ====================
+
+void cProcessor::sensitivityAnalysis(SensitivityResponse response, QString fileName)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createVector_B(ws.B, ws.forceApplied);
+        markSupports(ws.fixedNodes, ws.prescribed, ws.A.n);
+
+        // Производные вкладов стержней. k и эквивалентные нагрузки:
+        // k ~ E, пара от ε_T равна ∓k·ε_T·L; A стержня задает только постоянное сечение;
+        // при изменении L нагрузки в пролете сохраняют положение в долях длины,
+        // тогда k ~ 1/L, а от L зависит лишь часть нагрузок от распределенной q
+        std::vector<SensitivityBar> bars;
+        bool hasGaps = false;
+        for (const Core_of_Beam& beam : *m_beamData) {
+            hasGaps = hasGaps || beam.gap_node >= 0;
+            double k = barStiffness(beam);
+            double left, right;
+            barEquivalentLoads(beam, left, right);
+            double L = beam.len_L;
+            double thermal = k * beam.freeStrain() * L;
+
+            Core_of_Beam distributed = beam;
+            distributed.pointLoads.clear();
+            distributed.thermalExpansion = 0.0;
+            distributed.initialStrain = 0.0;
+            double spreadLeft, spreadRight;
+            barEquivalentLoads(distributed, spreadLeft, spreadRight);
+
+            SensitivityBar bar{ beam.node_left, beam.node_right, k, left, right,
+                beam.areaAt(0.0), beam.areaAt(L), {} };
+            double E = beam.mod_elasticity, A = beam.selectArea_A;
+            bar.derivatives[static_cast<int>(BarParameter::Modulus)] = { k / E, -thermal / E, thermal / E, 0.0 };
+            if (beam.section.isConstant()) {
+                bar.derivatives[static_cast<int>(BarParameter::Area)] = { k / A, -thermal / A, thermal / A, 1.0 };
+            }
+            bar.derivatives[static_cast<int>(BarParameter::Length)] = { -k / L, spreadLeft / L, spreadRight / L, 0.0 };
+            bar.derivatives[static_cast<int>(BarParameter::FreeStrain)] = { 0.0, -k * L, k * L, 0.0 };
+            bars.push_back(bar);
+        }
+
+        if (!ws.samePattern(ws.A)) {
+            ws.perm.clear();
+        }
+        QElapsedTimer timer;
+        timer.start();
+        SensitivityAnalysis analysis(ws.A, ws.B, bars, ws.fixedNodes, ws.prescribed, ws.cholesky, ws.perm);
+        double solveMs = timer.nsecsElapsed() / 1e6;
+        timer.restart();
+        SensitivityResult result = analysis.gradient(response);
+        double gradientMs = timer.nsecsElapsed() / 1e6;
+        if (!fileName.isEmpty()) {
+            writeSensitivityCsv(fileName.toStdString(), result);
+        }
+
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "ЧУВСТВИТЕЛЬНОСТЬ\n";
+        output += QString(60, '=') + "\n";
+        if (hasGaps) {
+            output += "Внимание: зазоры при расчете чувствительности считаются открытыми\n";
+        }
+        output += response.kind == ResponseKind::Displacement
+            ? QString("Отклик: Δ[%1] = %2 м\n").arg(response.index).arg(result.value, 0, 'g', 10)
+            : QString("Отклик: σ стержня %1 у %2 конца = %3 Па\n").arg(response.index + 1)
+                .arg(result.end ? "правого" : "левого").arg(result.value, 0, 'g', 10);
+        output += QString("Расчет с разложением %1 мс, все производные — %2 мс (обратных подстановок %3)\n")
+            .arg(solveMs, 0, 'f', 2).arg(gradientMs, 0, 'f', 2).arg(analysis.backSubstitutions());
+        if (!fileName.isEmpty()) {
+            output += QString("Производные записаны в %1\n").arg(fileName);
+        }
+
+        if (static_cast<int>(bars.size()) <= SensitivityRowsLimit) {
+            output += QString("\n%1 %2 %3 %4 %5\n").arg("Стерж.", 6).arg("dR/dE", 14).arg("dR/dA", 14)
+                .arg("dR/dL", 14).arg("dR/dε_T", 14);
+            for (size_t b = 0; b < bars.size(); ++b) {
+                const auto& d = result.bars[b];
+                output += QString("%1 %2 %3 %4 %5\n").arg(b + 1, 6).arg(d[0], 14, 'e', 5)
+                    .arg(d[1], 14, 'e', 5).arg(d[2], 14, 'e', 5).arg(d[3], 14, 'e', 5);
+            }
+        }
+        if (m_numNodes <= SensitivityRowsLimit) {
+            output += QString("\n%1 %2 %3\n").arg("Узел", 6).arg("dR/dF", 14).arg("dR/dΔ опоры", 14);
+            for (int i = 0; i < m_numNodes; ++i) {
+                output += QString("%1 %2 %3\n").arg(i, 6).arg(result.loads[i], 14, 'e', 5)
+                    .arg(ws.fixedNodes[i] ? QString::number(result.settlements[i], 'e', 5) : QString("—"), 14);
+            }
+        }
+        output += "\n";
+
+        QMetaObject::invokeMethod(this, [this, output]() {
+            ui.textEdit_p_1->append(output);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка расчета чувствительности: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+// ==================== ДИНАМИЧЕСКИЙ РАСЧЕТ ====================
+
+void cProcessor::transientAnalysis(TransientOptions options, std::vector<int> bars, QString fileName)
+{
+    try {
+        if (!m_beamData || m_beamData->empty()) {
+            throw std::runtime_error("No beam data available");
+        }
+        SolverWorkspace& ws = m_workspace;
+
+        // Центральные разности требуют диагональной массы
+        bool lumped = m_lumpedMass || options.integrator == TimeIntegrator::CentralDifference;
+        createMatrix_A(ws.builder, ws.A, ws.springApplied);
+        createMatrix_M(ws.builder, ws.M, lumped);
+        createVector_B(ws.B, ws.forceApplied);
+        markSupports(ws.fixedNodes, ws.prescribed, ws.A.n);
+
+        // Узел с таблицей F(t): постоянная сила узла заменяется таблицей
+        std::vector<NodalForceHistory> histories;
+        std::vector<char> historyApplied(m_numNodes, 0);
+        bool hasGaps = false;
+        for (const Core_of_Beam& beam : *m_beamData) {
+            hasGaps = hasGaps || beam.gap_node >= 0;
+            for (auto [node, joint] : { std::pair{ beam.node_left, &beam.Joint_left },
+                                        std::pair{ beam.rightJointNode(), &beam.Joint_right } }) {
+                // Как в createVector_B: в общем узле действует сила первого шарнира
+                if (historyApplied[node]) continue;
+                historyApplied[node] = 1;
+                if (joint->forceHistory.empty()) continue;
+                ws.B[node] -= joint->force_f;
+                histories.push_back({ node, joint->forceHistory });
+            }
+        }
+
+        if (options.outputNodes.empty()) {
+            options.outputNodes.push_back(m_numNodes - 1);
+        }
+        if (bars.empty()) {
+            bars.push_back(0);
+        }
+        // Среднее N по стержню: N(0) = kΔ + F_left, N(L) = kΔ - F_right
+        std::vector<BarForceProbe> probes;
+        for (int b : bars) {
+            if (b < 0 || b >= static_cast<int>(m_beamData->size())) {
+                throw std::runtime_error("Output bar number is out of range");
+            }
+            const Core_of_Beam& beam = (*m_beamData)[b];
+            double left, right;
+            barEquivalentLoads(beam, left, right);
+            probes.push_back({ b, beam.node_left, beam.node_right, barStiffness(beam), 0.5 * (left - right) });
+        }
+
+        std::ofstream file(fileName.toStdString(), std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open the output file");
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        TransientReport report;
+        runTransient(ws.A, ws.M, ws.B, histories, ws.fixedNodes, ws.prescribed, probes,
+            options, file, report);
+        double ms = timer.nsecsElapsed() / 1e6;
+        file.close();
+
+        bool explicitScheme = options.integrator == TimeIntegrator::CentralDifference;
+        QString output;
+        output += QString(60, '=') + "\n";
+        output += "ДИНАМИЧЕСКИЙ РАСЧЕТ\n";
+        output += QString(60, '=') + "\n";
+        output += QString("Схема: %1, матрица масс: %2\n")
+            .arg(explicitScheme ? "центральные разности" : QString("Ньюмарк, β = %1, γ = %2")
+                .arg(options.beta).arg(options.gamma))
+            .arg(lumped ? "сосредоточенная" : "согласованная");
+        output += QString("Δt = %1 с, критический шаг центральных разностей %2 с\n")
+            .arg(report.timeStep, 0, 'g', 6).arg(report.criticalStep, 0, 'g', 6);
+        output += QString("Шагов %1, t = %2 с, время счета %3 мс (%4 мкс на шаг)\n")
+            .arg(report.steps).arg(report.steps * report.timeStep, 0, 'g', 6)
+            .arg(ms, 0, 'f', 1).arg(report.steps > 0 ? 1e3 * ms / report.steps : 0.0, 0, 'f', 2);
+        output += QString("Файл %1: записей %2\n").arg(fileName).arg(report.records);
+        if (hasGaps) {
+            output += "Внимание: зазоры в динамическом расчете считаются открытыми\n";
+        }
+        output += "\nМаксимумы |u|:\n";
+        for (size_t k = 0; k < options.outputNodes.size(); ++k) {
+            output += QString("  узел %1: %2 при t = %3\n").arg(options.outputNodes[k])
+                .arg(report.peakDisplacement[k]).arg(report.peakDisplacementTime[k]);
+        }
+        output += "Максимумы |N| (среднее по стержню):\n";
+        for (size_t k = 0; k < probes.size(); ++k) {
+            output += QString("  стержень %1: %2 при t = %3\n").arg(probes[k].bar + 1)
+                .arg(report.peakForce[k]).arg(report.peakForceTime[k]);
+        }
+        output += "\n";
+
+        QMetaObject::invokeMethod(this, [this, output]() {
+            ui.textEdit_p_1->append(output);
+            }, Qt::QueuedConnection);
+    }
+    catch (const std::exception& e) {
+        QString errorMsg = QString("Ошибка динамического расчета: %1").arg(e.what());
+        QMetaObject::invokeMethod(this, [this, errorMsg]() {
+            ui.textEdit_p_1->append(errorMsg);
+            }, Qt::QueuedConnection);
+    }
+}
+
+//  ПОСТ-процессор
+
+void cProcessor::calculatePostProcessing(const std::vector<double>& deltas,
+    std::vector<BeamResults>& results, std::vector<double>& range)
+{
+    int num_beams = m_beamData->size();
+    // Векторы N, u, σ прошлого расчета очищаются, но сохраняют емкость
+    results.resize(num_beams);
+
+    for (int i = 0; i < num_beams; ++i) {
+        const Core_of_Beam& beam = (*m_beamData)[i];
+        BeamResults& res = results[i];
+        res.X.clear();
+        res.N_x.clear();
+        res.U_x.clear();
+        res.sigma.clear();
+
+        // Исходные данные
+        res.beamNum = i + 1;
+        res.E = beam.mod_elasticity;
+        res.A = beam.areaAt(0.0);
+        res.L = beam.len_L;
+        const LoadDistribution loads = beam.loads();
+        res.q = LoadDistribution{ loads.uniform, loads.segments }.resultant(res.L) / res.L;
+        res.freeStrain = beam.freeStrain();
+        res.delta_left = deltas[beam.node_left];
+        res.delta_right = deltas[beam.node_right];
+
+		get_rangeLen(0.0, res.L, res.L / m_pointsPerBar, beam.pointLoads, range);
+        res.X.assign(range.begin(), range.end());
+
+        if (!beam.section.isConstant()) {
+            evaluateVariableSection(beam, res, range, res.N_x, res.U_x, res.sigma);
+            continue;
+        }
+
+        for (size_t k = 0; k < range.size(); ++k) {
+            double x = range[k];
+            // Продольные силы N(x); повтор точки — значение справа от скачка
+            bool rightLimit = k > 0 && range[k - 1] == x;
+            double N_x = calculateNormalForce(res.E, res.A, res.L,
+                res.delta_left, res.delta_right,
+                loads, res.freeStrain, x, rightLimit);
+            res.N_x.push_back(N_x);
+            // Перемещения u(x)
+            double U_x = calculateDisplacement(res.delta_left, res.delta_right,
+                res.E, res.A, res.L,
+                loads, x);
+            res.U_x.push_back(U_x);
+            // Напряжения σ(x)
+            double sigma_x = calculateStress(N_x, res.A);
+            res.sigma.push_back(sigma_x);
+		}
+    }
+}
+
+void cProcessor::showPostProcessingResults(const std::vector<BeamResults>& results)
+{
+    QString output;
+    output += QString(60, '=') + "\n";
+    output += "РЕЗУЛЬТАТЫ РАСЧЕТА ПОСТ-ПРОЦЕССОРА\n";
+    output += QString(60, '=') + "\n\n";
+
+    for (int i = 0; i < results.size(); ++i) {
+        const BeamResults& res = results[i];
+        output += QString(30, '-') + "\n";
+        output += QString("Балка №%1:\n").arg(res.beamNum);
+        output += QString(30, '-') + "\n";
+
+        output += QString(" Продольные силы N(x): \n");
+        output += QString("N(0)=%1  ").arg(res.N_x[0]);
+        output += QString("N(%2L)=%1\n").arg(res.N_x[res.N_x.size()-1]).arg(res.L);
+
+        output += QString("\n Перемещения u(x): \n");
+        for(size_t j = 0; j < res.U_x.size(); j++) {
+            if(j % 5 == 0 || j == 0 || j == res.U_x.size()-1 ) {
+                output += QString("u(%1)=%2 \n").arg(res.X[j]).arg(res.U_x[j]);
+			}
+		}
+        output += QString("\n Напряжения σ(x): \n");
+        for (size_t j = 0; j < res.sigma.size(); j++) {
+            if (j % 5 == 0 || j == 0 || j == res.sigma.size() - 1) {
+                output += QString("σ(%1)=%2 \n").arg(res.X[j]).arg(res.sigma[j]);
+            }
+        }
+
+        output += QString("\n -------- Проверка макс. напряжений σ(x) на стержне №%1: --------\n").arg(i+1);
+        const Core_of_Beam& beam = (*m_beamData)[i];
+        double max_voltage = beam.maxVoltage;
+        output += QString("Макс. напряжение σ=%1 \n").arg(max_voltage);
+        for (size_t j = 0; j < res.sigma.size(); j++) {
+            
+
+            if (std::abs(res.sigma[j]) > max_voltage) {
+                output += QString("Сломается в σ(%1)=%2 \n").arg(res.X[j]).arg(res.sigma[j]);
+                break;
+            }
+            else {
+                if (j % 5 == 0) {
+                    output += QString("Всё хорошо σ(%1)=%2 \n").arg(res.X[j]).arg(res.sigma[j]);
+                }
+            }
+        }
+
+		output += QString("\n\n");
+
+    }
+    ui.textEdit_p_1->append(output);
+}
+
+void cProcessor::showPostProcessingResultsAsTable(const std::vector<BeamResults>& results)
+{
+    
+
+    bool strengthOk_full = true;
+    QString output;
+
+    
+    bool showAllValues = ui.checkBox_p1->isChecked();
+    int step = showAllValues ? 1 : 5;
+
+    output += QString(60, '=') + "\n";
+    output += "         РЕЗУЛЬТАТЫ РАСЧЕТА СТЕРЖНЕВОЙ КОНСТРУКЦИИ\n";
+    output += QString(60, '=') + "\n\n";
+
+    for (int i = 0; i < results.size(); ++i) {
+        const BeamResults& res = results[i];
+
+        
+        output += QString(60, '-') + "\n";
+        output += QString("  СТЕРЖЕНЬ №%1\n").arg(res.beamNum);
+        output += QString(60, '-') + "\n";
+
+        
+        output += "┌────────────────────────────────────────┬──────────────────┐\n";
+        output += "│ Параметр                               │ Значение         │\n";
+        output += "├────────────────────────────────────────┼──────────────────┤\n";
+        output += QString("│ Модуль упругости E, Па                 │ %1 │\n")
+            .arg(res.E, 16, 'e', 2, ' ');
+        output += QString("│ Площадь сечения A, м²                  │ %1 │\n")
+            .arg(res.A, 16, 'e', 4, ' ');
+        output += QString("│ Длина L, м                             │ %1 │\n")
+            .arg(res.L, 16, 'f', 4, ' ');
+        output += QString("│ Распред. нагрузка q, Н/м               │ %1 │\n")
+            .arg(res.q, 16, 'f', 2, ' ');
+        output += QString("│ Перемещение левого узла, м             │ %1 │\n")
+            .arg(res.delta_left, 16, 'e', 6, ' ');
+        output += QString("│ Перемещение правого узла, м            │ %1 │\n")
+            .arg(res.delta_right, 16, 'e', 6, ' ');
+        output += "└────────────────────────────────────────┴──────────────────┘\n";
+
+        /*output += "┌───────────────────────────────────────────────────────\n";
+        output += "│ Параметр                                  │ Значение         \n";
+        output += "|────────────────────────────────────────-──────────────\n";
+        output += QString("│ Модуль упругости E, Па                 │ %1  \n")
+            .arg(res.E, 16, 'e', 2, ' ');
+        output += QString("│ Площадь сечения A, м²                  │ %1  \n")
+            .arg(res.A, 16, 'e', 4, ' ');
+        output += QString("│ Длина L, м                                       │ %1  \n")
+            .arg(res.L);
+        output += "|────────────────────────────────-─────────────────────────|\n\n";*/
+
+        // Обе стороны скачка от силы внутри стержня выводятся всегда
+        auto isJump = [&res](size_t j) {
+            return (j > 0 && res.X[j] == res.X[j - 1]) ||
+                (j + 1 < res.X.size() && res.X[j] == res.X[j + 1]);
+        };
+
+        //  N(x)
+        output += "  ПРОДОЛЬНЫЕ СИЛЫ N(x), Н:\n";
+        output += "┌───────────────────┬───────────────────┐\n";
+        output += "│ Координата x, м   │ N(x), Н           │\n";
+        output += "|───────────────────┼───────────────────|\n";
+
+        for (size_t j = 0; j < res.N_x.size(); ++j) {
+            
+            if (j % step == 0 || j == 0 || j == res.N_x.size() - 1 || isJump(j)) {
+                double x = res.X[j];
+                output += QString("│ %1 │ %2 │\n")
+                    .arg(x, 17, 'f', 4)
+                    .arg(res.N_x[j], 17, 'f', 2);
+            }
+        }
+        output += "|───────────────────-───────────────────|\n\n";
+
+        // u(x)
+        output += "  ПЕРЕМЕЩЕНИЯ u(x), м:\n";
+        output += "┌───────────────────┬───────────────────┐\n";
+        output += "│ Координата x, м   │ u(x), м           │\n";
+        output += "|───────────────────┼───────────────────|\n";
+
+        for (size_t j = 0; j < res.U_x.size(); ++j) {
+            if (j % step == 0 || j == 0 || j == res.U_x.size() - 1 || isJump(j)) {
+                double x = res.X[j];
+                output += QString("│ %1 │ %2 │\n")
+                    .arg(x, 17, 'f', 4)
+                    .arg(res.U_x[j], 17, 'e', 6);
+            }
+        }
+        output += "|───────────────────-───────────────────|\n\n";
+
+        // σ(x)
+        const Core_of_Beam& beam = (*m_beamData)[i];
+        double max_voltage = beam.maxVoltage;
+
+        output += QString("  НАПРЯЖЕНИЯ σ(x), Па (Допустимое: %1 Па):\n")
+            .arg(max_voltage, 0, 'e', 2);
+        output += "┌───────────────────┬───────────────────┬──────────┐\n";
+        output += "│ Координата x, м   | σ(x), Па          │ Статус   │\n";
+        output += "|───────────────────┼───────────────────┼──────────|\n";
+
+        bool strengthOk = true;
+        for (size_t j = 0; j < res.sigma.size(); ++j) {
+            if (j % step == 0 || j == 0 || j == res.sigma.size() - 1 || isJump(j)) {
+                double x = res.X[j];
+
+                QString status = " OK     ";
+                if (std::abs(res.sigma[j]) > max_voltage) {
+                    status = " FAIL!  ";
+                    strengthOk = false;
+                    strengthOk_full = false;
+                }
+
+                output += QString("│ %1 │ %2 │%3│\n")
+                    .arg(x, 17, 'f', 4)
+                    .arg(res.sigma[j], 17, 'e', 4)
+                    .arg(status);
+            }
+        }
+        output += "|───────────────────-───────────────────-──────────|\n";
+
+        // Вердикт по прочности одного стержня
+        if (strengthOk) {
+            output += "  ✓ УСЛОВИЕ ПРОЧНОСТИ ВЫПОЛНЕНО\n\n";
+        }
+        else {
+            output += "  ✗ УСЛОВИЕ ПРОЧНОСТИ НЕ ВЫПОЛНЕНО!\n\n";
+        }
+    }
+
+    output += QString(60, '=') + "\n";
+    output += "                        КОНЕЦ ОТЧЕТА\n";
+
+    std::string strongInfo;
+    strongInfo += "Условию прочности относительно всей балки: ";
+    strongInfo += (strengthOk_full == true) ? "✓ УСЛОВИЕ ПРОЧНОСТИ ВЫПОЛНЕНО \n" : "✗ УСЛОВИЕ ПРОЧНОСТИ НЕ ВЫПОЛНЕНО! \n";
+    output += strongInfo;
+    output += QString(60, '=') + "\n";
+
+    ui.textEdit_p_1->append(output);
+}
+
+
+
+
+double cProcessor::calculateNormalForce(double E, double A, double L,
+    double delta_i, double delta_j,
+    const LoadDistribution& loads, double freeStrain, double x, bool rightLimit)
+{
+    // N(x) = (E*A/L)*(Δ_j - Δ_i) + R(L)/L - Q(x) - E*A*ε_T,
+    // Q(x) = ∫ q ds, R(x) = ∫ Q ds; для равномерной q: (q*L/2)*(1 - 2*x/L).
+    // Напряжения дает только упругая часть деформации
+    if (std::abs(L) < 1e-12) {
+        return 0.0;
+    }
+
+    double EA_over_L = (E * A) / L;
+    double N_displacement = EA_over_L * (delta_j - delta_i);
+    double N_load = loads.moment(L) / L - loads.resultant(x, rightLimit);
+    double N_free = E * A * freeStrain;
+
+    return N_displacement + N_load - N_free;
+}
+
+double cProcessor::calculateDisplacement(double delta_i, double delta_j,
+    double E, double A, double L,
+    const LoadDistribution& loads, double x)
+{
+    // u(x) = Δ_i + (Δ_j - Δ_i)*(x/L) + (R(L)*x/L - R(x)) / (E*A);
+    // для равномерной q: (q*L²/(2*E*A))*(1 - x/L)*(x/L)
+    if (std::abs(E * A) < 1e-12 || std::abs(L) < 1e-12) {
+        return 0.0;
+    }
+
+    double u_linear = delta_i + (delta_j - delta_i) * (x / L);
+    double u_distributed = (loads.moment(L) * x / L - loads.moment(x)) / (E * A);
+
+    return u_linear + u_distributed;
+}
+
+void cProcessor::evaluateVariableSection(const Core_of_Beam& beam, const BeamResults& res,
+    const std::vector<double>& range, std::vector<double>& N_x,
+    std::vector<double>& U_x, std::vector<double>& sigma)
+{
+    const LoadDistribution loads = beam.loads();
+    SectionIntegrals whole = integrateSection(beam.section, res.E, beam.selectArea_A,
+        res.L, loads, 0.0, res.L);
+
+    // Продольная сила в начале стержня из условия u(L) = Δ_j
+    double N0 = (res.delta_right - res.delta_left - res.freeStrain * res.L
+        + whole.loadIntegral) / whole.flexibility;
+
+    N_x.clear();
+    U_x.clear();
+    sigma.clear();
+    SectionIntegrals accumulated;
+    double previous = 0.0;
+    for (size_t k = 0; k < range.size(); ++k) {
+        double x = range[k];
+        bool rightLimit = k > 0 && range[k - 1] == x;
+        SectionIntegrals part = integrateSection(beam.section, res.E, beam.selectArea_A,
+            res.L, loads, previous, x);
+        accumulated.flexibility += part.flexibility;
+        accumulated.loadIntegral += part.loadIntegral;
+        previous = x;
+
+        double N = N0 - loads.resultant(x, rightLimit);
+        N_x.push_back(N);
+        U_x.push_back(res.delta_left + N0 * accumulated.flexibility
+            - accumulated.loadIntegral + res.freeStrain * x);
+        sigma.push_back(calculateStress(N, beam.areaAt(x)));
+    }
+}
+
+double cProcessor::calculateStress(double N, double A)
+{
+    // σ = N / A
+    if (std::abs(A) < 1e-12) {
+        return 0.0;
+    }
+    return N / A;
+}
@@ -1,76 +1,168 @@
-#pragma once
-
-#include <vector>
-#include <QWidget>
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrent>
-#include <QString>
-#include <QMetaObject>
-#include <QMessageBox>
-#include <QMenuBar>
-#include <QVBoxLayout>
-#include <QFileDialog>
-#include <fstream>
-#include "ui_cProcessor.h"
-#include "Help.h"
-
-class cProcessor : public QWidget
-{
-    Q_OBJECT
-
-public:
-    cProcessor(std::vector<Core_of_Beam>* beamData, QWidget* parent = nullptr);
-    ~cProcessor();
-    void MenuBar();
-signals:
-    void sendResults(std::vector<BeamResults> results);
-
-private slots:
-    void on_pushButton_p_1_clicked();
-    void onCalculationFinished();
-    void on_pushButton_p_2_clicked();
-    void on_pushButton_p_3_clicked();
-private:
-    
-    QFutureWatcher<void>* m_watcher;
-    Ui::cProcessorClass ui;
-    std::vector<Core_of_Beam>* m_beamData;
-    std::vector<BeamResults> results_force;
-    // Сохраненные результаты для пост-процессинга
-    std::vector<double> m_deltas;
-    std::vector<double> get_rangeLen(double start_L, double stop_L, double step);
-    QString getBeamParametersAtPoint(int beamNum, double coordinate);
-
-    // Основные методы расчета
-    void clear_textEdit();
-    void save_calc_results();
-
-    void calculateData();
-    void displayResults(const std::vector<std::vector<double>>& A,
-        const std::vector<double>& deltas);
-    std::vector<std::vector<double>> createMatrix_A();
-    std::vector<double> createVector_B();
-    void applyBoundaryConditions(
-        std::vector<std::vector<double>>& A,
-        std::vector<double>& B);
-    std::vector<double> findDeltas(
-        std::vector<std::vector<double>>& A,
-        std::vector<double>& B);
-
-    // Пост-процессорные методы
-    
-
-    std::vector<BeamResults> calculatePostProcessing(const std::vector<double>& deltas);
-    void showPostProcessingResults(const std::vector<BeamResults>& results);
-    void showPostProcessingResultsAsTable(const std::vector<BeamResults>& results);
-
-    // Вспомогательные функции расчета (только N, u, σ)
-    double calculateNormalForce(double E, double A, double L,
-        double delta_i, double delta_j,
-        double q, double x);
-    double calculateDisplacement(double delta_i, double delta_j,
-        double E, double A, double L,
-        double q, double x);
-    double calculateStress(double N, double A);
-};
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <QWidget>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QString>
+#include <QMetaObject>
+#include <QMessageBox>
+#include <QMenuBar>
+#include <QVBoxLayout>
+#include <QFileDialog>
+#include <QActionGroup>
+#include <QInputDialog>
+#include <fstream>
+#include "ui_cProcessor.h"
+#include "Help.h"
+#include "sparseSolver.h"
+#include "tridiagSolver.h"
+#include "fixedSolver.h"
+#include "solverWorkspace.h"
+#include "modalSolver.h"
+#include "transientSolver.h"
+#include "plasticSolver.h"
+#include "geometricSolver.h"
+#include "sizingOptimizer.h"
+#include "sensitivitySolver.h"
+
+class cProcessor : public QWidget
+{
+    Q_OBJECT
+    // Тест выделений памяти вызывает этапы расчета напрямую
+    friend class AllocationTest;
+
+public:
+    cProcessor(std::vector<Core_of_Beam>* beamData, QWidget* parent = nullptr);
+    ~cProcessor();
+    void MenuBar();
+signals:
+    void sendResults(std::vector<BeamResults> results);
+    // Подобранные площади сечений по стержням m_beamData
+    void sendAreas(std::vector<double> areas);
+
+private slots:
+    void on_pushButton_p_1_clicked();
+    void onCalculationFinished();
+    void on_pushButton_p_2_clicked();
+    void on_pushButton_p_3_clicked();
+private:
+    
+    // Текущий расчет в пуле потоков; nullptr — расчета нет
+    QFutureWatcher<void>* m_watcher;
+    QString m_finishedMessage;
+    // Вызывается в потоке интерфейса по окончании, до finishedMessage
+    std::function<void()> m_onFinished;
+    QMenu* m_solverMenu = nullptr;
+    QMenu* m_analysisMenu = nullptr;
+    Ui::cProcessorClass ui;
+    std::vector<Core_of_Beam>* m_beamData;
+    std::vector<BeamResults> results_force;
+    // Сохраненные результаты для пост-процессинга
+    std::vector<double> m_deltas;
+    int m_numNodes = 0;
+    // Буферы расчетов; расчеты идут по одному под m_watcher
+    SolverWorkspace m_workspace;
+    bool m_calculationSucceeded = false;
+    // Число участков стержня для пост-процессора; читается из поля при запуске
+    double m_pointsPerBar = 30.0;
+
+    // Выбор решателя: малые модели считаются на стеке, цепочки — прогонкой,
+    // в режиме "авто" остальные большие модели — PCG
+    enum class SolverKind { Auto, Direct, Iterative };
+    static constexpr int IterativeSolverThreshold = 200000;
+    // Жесткость замкнутого зазора относительно стержней по обе его стороны
+    static constexpr double GapPenaltyFactor = 1e6;
+    SolverKind m_solverKind = SolverKind::Auto;
+    PcgOptions m_pcgOptions;
+    // Точность прямого решения: обычная; масштабирование и уточнение
+    // с оценкой обусловленности; разложение во float с уточнением в double
+    enum class PrecisionMode { Standard, Refined, Fast };
+    PrecisionMode m_precisionMode = PrecisionMode::Standard;
+    // Отчет решателя последнего расчета; выводится в потоке интерфейса
+    enum class SolveReport { None, Contact, Accuracy, Pcg };
+    SolveReport m_solveReport = SolveReport::None;
+    AccuracyReport m_accuracyReport;
+    PcgReport m_pcgReport;
+    // Модальный анализ: сосредоточенная матрица масс вместо согласованной
+    bool m_lumpedMass = false;
+    // Формы выводятся для нескольких нижних мод и не слишком длинных моделей
+    static constexpr int ModalShapesShown = 3;
+    static constexpr int ModalShapeRowsLimit = 200;
+    // Упругопластический расчет: строк истории нагружения в выводе
+    static constexpr int PlasticHistoryRowsLimit = 100;
+    // Большие перемещения: узлы и стержни выводятся для не слишком длинных моделей
+    static constexpr int LargeDisplacementRowsLimit = 200;
+    // Подбор сечений: строк по стержням в выводе
+    static constexpr int SizingRowsLimit = 200;
+    // Чувствительность: строк по стержням и узлам в выводе, полностью — в CSV
+    static constexpr int SensitivityRowsLimit = 200;
+    // Сетка точек с шагом step; каждая точка скачка (сила внутри стержня) входит
+    // дважды — для значений слева и справа от нее
+    void get_rangeLen(double start_L, double stop_L, double step,
+        const std::vector<PointLoad>& jumps, std::vector<double>& range);
+    QString getBeamParametersAtPoint(int beamNum, double coordinate);
+
+    // Основные методы расчета
+    void clear_textEdit();
+    void save_calc_results();
+    // Связность и число участков — в потоке интерфейса перед расчетом
+    void prepareRun();
+    // Запуск расчета в пуле под m_watcher; finishedMessage — в вывод по окончании
+    void startTask(std::function<void()> task, QString finishedMessage = QString(),
+        std::function<void()> onFinished = nullptr);
+
+    // Расчет в пуле без вывода; отчет — showCalculationResults по окончании
+    void calculateData();
+    void showCalculationResults();
+    void showSolveReport();
+    void displayResults(const SparseMatrix& A,
+        const std::vector<double>& deltas, const SupportConstraints& constraints);
+    void createMatrix_A(SparseBuilder& builder, SparseMatrix& A, std::vector<char>& springApplied);
+    void createVector_B(std::vector<double>& B, std::vector<char>& forceApplied);
+    void markSupports(std::vector<char>& fixed, std::vector<double>& prescribed, int n);
+    void applyBoundaryConditions(SolverWorkspace& ws);
+    void findDeltas(SolverWorkspace& ws);
+    void computeReactions(SolverWorkspace& ws);
+    void benchmarkChainSolver(int numNodes);
+
+    // Модальный анализ: K φ = ω² M φ по свободным узлам цепочки
+    void createMatrix_M(SparseBuilder& builder, SparseMatrix& M, bool lumped);
+    void modalAnalysis(int count);
+    // Динамический расчет M ü + K u = F(t); bars — номера стержней для N(t),
+    // история пишется в fileName по мере счета
+    void transientAnalysis(TransientOptions options, std::vector<int> bars, QString fileName);
+    // Упругопластический расчет: нагружение λ·(F, осадки) до разрушения
+    void plasticAnalysis(PlasticOptions options);
+    // Большие перемещения: жесткость по текущей длине, нагрузка шагами
+    void largeDisplacementAnalysis(GeometricOptions options);
+    // Подбор сечений: минимум объема при |σ| <= σ_max и ограничениях перемещений
+    void optimizeAreas(SizingOptions options);
+    // Производные отклика по E, A, L, ε_T стержней и узловым нагрузкам; fileName — CSV, пусто — без файла
+    void sensitivityAnalysis(SensitivityResponse response, QString fileName);
+
+    // Пост-процессорные методы
+    
+
+    void calculatePostProcessing(const std::vector<double>& deltas,
+        std::vector<BeamResults>& results, std::vector<double>& range);
+    void showPostProcessingResults(const std::vector<BeamResults>& results);
+    void showPostProcessingResultsAsTable(const std::vector<BeamResults>& results);
+
+    // Вспомогательные функции расчета (только N, u, σ)
+    double calculateNormalForce(double E, double A, double L,
+        double delta_i, double delta_j,
+        const LoadDistribution& loads, double freeStrain, double x, bool rightLimit = false);
+    double calculateDisplacement(double delta_i, double delta_j,
+        double E, double A, double L,
+        const LoadDistribution& loads, double x);
+    double calculateStress(double N, double A);
+
+    // Переменное сечение: N(x) = N0 - Q(x), u(x) = Δ_i + N0·F(x) - G(x) + ε_T·x,
+    // F = ∫ dx/EA, G = ∫ Q dx/EA от 0 до x, накапливаются по точкам range
+    void evaluateVariableSection(const Core_of_Beam& beam, const BeamResults& res,
+        const std::vector<double>& range, std::vector<double>& N_x,
+        std::vector<double>& U_x, std::vector<double>& sigma);
+};
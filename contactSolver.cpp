@@ -0,0 +1,244 @@
+#include "contactSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Зазор в виде e^T u >= g: опорные узлы исключены, их перемещение
+// перенесено в зазор
+struct GapRow {
+    int a = -1;          // свободный узел с коэффициентом +1, или -1
+    int b = -1;          // свободный узел с коэффициентом -1, или -1
+    double gap = 0.0;
+    double stiffness = 0.0;
+};
+
+double gapOpening(const GapRow& row, const std::vector<double>& u)
+{
+    double eu = 0.0;
+    if (row.a >= 0) eu += u[row.a];
+    if (row.b >= 0) eu -= u[row.b];
+    return eu - row.gap;   // > 0 — проникание, контакт сжат
+}
+
+// Базовое разложение K + сумма замкнутых в базе контактов и кэш F^-1 e_g
+class ContactFactor {
+public:
+    ContactFactor(const SparseMatrix& K, const std::vector<GapRow>& rows)
+        : m_K(K), m_rows(rows), m_columns(rows.size()) {}
+
+    void factorize(const std::vector<char>& baseClosed)
+    {
+        SparseMatrix A = m_K;
+        for (size_t g = 0; g < m_rows.size(); ++g) {
+            if (baseClosed[g]) addContact(A, m_rows[g], 1.0);
+        }
+        if (m_perm.empty()) {
+            m_perm = reverseCuthillMcKee(A);
+        }
+        // При вырожденности прежнее разложение остается рабочим
+        SkylineCholesky cholesky;
+        cholesky.factorize(A, m_perm);
+        m_cholesky = std::move(cholesky);
+        m_baseClosed = baseClosed;
+        for (auto& column : m_columns) column.clear();
+    }
+
+    const std::vector<char>& baseClosed() const { return m_baseClosed; }
+
+    // (K + сумма замкнутых) u = b через базовое разложение и поправку ранга m
+    std::vector<double> solve(const std::vector<char>& closed, const std::vector<double>& b,
+        int& rank) const
+    {
+        std::vector<int> changed;
+        for (size_t g = 0; g < m_rows.size(); ++g) {
+            if (closed[g] != m_baseClosed[g]) changed.push_back(static_cast<int>(g));
+        }
+        rank = static_cast<int>(changed.size());
+
+        std::vector<double> y = m_cholesky.solve(b);
+        if (changed.empty()) return y;
+
+        // Вудбери: (F + U C U^T)^-1 b = y - Z (C^-1 + U^T Z)^-1 U^T y, Z = F^-1 U
+        const int m = rank;
+        std::vector<double> S(m * m, 0.0), t(m);
+        for (int i = 0; i < m; ++i) {
+            const GapRow& ri = m_rows[changed[i]];
+            const std::vector<double>& zi = column(changed[i]);
+            double sign = closed[changed[i]] ? 1.0 : -1.0;
+            S[i * m + i] += 1.0 / (sign * ri.stiffness);
+            for (int j = 0; j < m; ++j) {
+                S[j * m + i] += applyRow(m_rows[changed[j]], zi);
+            }
+            t[i] = applyRow(ri, y);
+        }
+        std::vector<double> w = solveDense(S, t, m);
+        for (int i = 0; i < m; ++i) {
+            const std::vector<double>& zi = column(changed[i]);
+            for (size_t k = 0; k < y.size(); ++k) {
+                y[k] -= zi[k] * w[i];
+            }
+        }
+        return y;
+    }
+
+    static void addContact(SparseMatrix& A, const GapRow& row, double sign)
+    {
+        double k = sign * row.stiffness;
+        if (row.a >= 0) *A.find(row.a, row.a) += k;
+        if (row.b >= 0) *A.find(row.b, row.b) += k;
+        if (row.a >= 0 && row.b >= 0) {
+            *A.find(row.a, row.b) -= k;
+            *A.find(row.b, row.a) -= k;
+        }
+    }
+
+private:
+    static double applyRow(const GapRow& row, const std::vector<double>& v)
+    {
+        double value = 0.0;
+        if (row.a >= 0) value += v[row.a];
+        if (row.b >= 0) value -= v[row.b];
+        return value;
+    }
+
+    // F^-1 e_g считается один раз на базовое разложение
+    const std::vector<double>& column(int g) const
+    {
+        std::vector<double>& z = m_columns[g];
+        if (z.empty()) {
+            std::vector<double> e(m_K.n, 0.0);
+            if (m_rows[g].a >= 0) e[m_rows[g].a] = 1.0;
+            if (m_rows[g].b >= 0) e[m_rows[g].b] = -1.0;
+            m_cholesky.solve(e, z);
+        }
+        return z;
+    }
+
+    const SparseMatrix& m_K;
+    const std::vector<GapRow>& m_rows;
+    SkylineCholesky m_cholesky;
+    std::vector<int> m_perm;
+    std::vector<char> m_baseClosed;
+    mutable std::vector<std::vector<double>> m_columns;
+};
+
+} // namespace
+
+std::vector<double> solveWithGaps(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<GapElement>& gaps, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, ContactReport& report, int maxIterations)
+{
+    const int n = K.n;
+    const int numGaps = static_cast<int>(gaps.size());
+    report = ContactReport();
+    report.closed.assign(numGaps, 0);
+    report.forces.assign(numGaps, 0.0);
+
+    // Контакты свободных узлов; оба узла опорные — зазор ни на что не влияет
+    std::vector<GapRow> rows(numGaps);
+    for (int g = 0; g < numGaps; ++g) {
+        const GapElement& gap = gaps[g];
+        GapRow& row = rows[g];
+        row.gap = gap.clearance;
+        row.stiffness = gap.stiffness;
+        if (fixed[gap.nodeA]) row.gap -= prescribed[gap.nodeA];
+        else row.a = gap.nodeA;
+        if (fixed[gap.nodeB]) row.gap += prescribed[gap.nodeB];
+        else row.b = gap.nodeB;
+    }
+
+    // Шаблон A должен содержать связи a-b, даже если стержни их не дают
+    SparseBuilder builder(n);
+    builder.reserve(K.nonZeros() + 2 * static_cast<size_t>(numGaps));
+    for (int i = 0; i < n; ++i) {
+        for (int k = K.rowPtr[i]; k < K.rowPtr[i + 1]; ++k) {
+            builder.add(i, K.colIdx[k], K.values[k]);
+        }
+    }
+    for (const GapRow& row : rows) {
+        if (row.a >= 0 && row.b >= 0) {
+            builder.add(row.a, row.b, 0.0);
+            builder.add(row.b, row.a, 0.0);
+        }
+    }
+    SparseMatrix pattern = builder.toCSR();
+
+    // База — все зазоры открыты; если без контактов система — механизм,
+    // база — все закрыты
+    ContactFactor factor(pattern, rows);
+    std::vector<char> closed(numGaps, 0);
+    try {
+        factor.factorize(closed);
+    }
+    catch (const std::runtime_error&) {
+        std::fill(closed.begin(), closed.end(), 1);
+        factor.factorize(closed);
+    }
+    report.factorizations = 1;
+
+    // Изменений больше этого — дешевле разложить заново
+    const int maxRank = 16;
+    std::vector<double> u, b(n);
+    for (int iter = 1; iter <= maxIterations; ++iter) {
+        report.iterations = iter;
+
+        // Правая часть замкнутых контактов: k * g * e
+        b = B;
+        for (int g = 0; g < numGaps; ++g) {
+            if (!closed[g]) continue;
+            if (rows[g].a >= 0) b[rows[g].a] += rows[g].stiffness * rows[g].gap;
+            if (rows[g].b >= 0) b[rows[g].b] -= rows[g].stiffness * rows[g].gap;
+        }
+
+        int rank = 0;
+        u = factor.solve(closed, b, rank);
+        if (rank > maxRank) {
+            // Открытые зазоры могут оставить части без опоры: такое состояние
+            // в базу не годится, решение продолжается с поправкой
+            try {
+                factor.factorize(closed);
+                report.factorizations++;
+                u = factor.solve(closed, b, rank);
+            }
+            catch (const std::runtime_error&) {
+            }
+        }
+        if (rank > 0) report.lowRankUpdates++;
+
+        // Проникание открытого зазора закрывает его, растяжение замкнутого —
+        // открывает. Пока есть проникания, зазоры только закрываются; затем
+        // открывается один, самый растянутый: одновременное раскрытие
+        // нескольких может оставить тело без опоры, и итерации зацикливаются
+        bool changed = false;
+        int mostStretched = -1;
+        double maxTension = 0.0;
+        for (int g = 0; g < numGaps; ++g) {
+            double opening = gapOpening(rows[g], u);
+            double tolerance = 1e-12 * std::max(1.0, std::abs(rows[g].gap));
+            if (!closed[g] && opening > tolerance) {
+                closed[g] = 1;
+                changed = true;
+            }
+            else if (closed[g] && opening < -tolerance && -opening * rows[g].stiffness > maxTension) {
+                maxTension = -opening * rows[g].stiffness;
+                mostStretched = g;
+            }
+        }
+        if (!changed && mostStretched >= 0) {
+            closed[mostStretched] = 0;
+            changed = true;
+        }
+        if (!changed) {
+            report.converged = true;
+            break;
+        }
+    }
+
+    for (int g = 0; g < numGaps; ++g) {
+        report.closed[g] = closed[g];
+        report.forces[g] = closed[g] ? rows[g].stiffness * gapOpening(rows[g], u) : 0.0;
+    }
+    return u;
+}
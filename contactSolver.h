@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+
+// Контактный элемент (зазор) между узлами a и b: замыкается, когда
+// u_a - u_b достигает clearance, и тогда работает как жесткая пружина
+struct GapElement {
+    int nodeA;            // конец стержня слева от зазора
+    int nodeB;            // начало стержня (или опора) справа
+    double clearance;     // начальный зазор, м
+    double stiffness;     // жесткость замкнутого контакта (штраф), Н/м
+};
+
+struct ContactReport {
+    int iterations = 0;          // итераций активного множества
+    int factorizations = 0;      // полных разложений
+    int lowRankUpdates = 0;      // решений через поправку Вудбери
+    bool converged = false;
+    std::vector<char> closed;    // состояние каждого зазора
+    std::vector<double> forces;  // сжимающее усилие в контакте, Н
+};
+
+// Решение K u = B с односторонними контактами методом активного множества.
+// K и B — после учета опор: fixed/prescribed задают опорные узлы, их
+// компоненты в контакте заменяются известным перемещением. Разложение
+// базового состояния переиспользуется: смена состояния нескольких зазоров
+// учитывается поправкой Шермана — Моррисона — Вудбери, полное
+// разложение повторяется, только когда отличий от базы становится много
+std::vector<double> solveWithGaps(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<GapElement>& gaps, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, ContactReport& report, int maxIterations = 50);
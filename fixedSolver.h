@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "sparseSolver.h"
+
+// Малые модели (до 16 узлов) считаются на стеке: размер известен при
+// компиляции, циклы разворачиваются, куча не используется
+constexpr int FixedSolverMaxSize = 16;
+
+// LDLᵀ-разложение симметричной матрицы N×N (по строкам) и решение A x = b.
+// Без корней, поэтому пригодно и для вычисления при компиляции
+template<int N>
+constexpr std::array<double, N> solveFixed(std::array<double, N * N> A, std::array<double, N> b)
+{
+    // Под диагональю — L, на диагонали — D
+    for (int j = 0; j < N; ++j) {
+        const double diagonal = A[j * N + j];
+        double d = diagonal;
+        for (int k = 0; k < j; ++k) {
+            d -= A[j * N + k] * A[j * N + k] * A[k * N + k];
+        }
+        // Вырожденность — относительно исходного A(j,j), как в разложении
+        // Холецкого: у модели без опор d выходит порядка ошибки округления
+        const double magnitude = d < 0.0 ? -d : d;
+        const double scale = diagonal < 0.0 ? -diagonal : diagonal;
+        if (!(magnitude > 1e-12 * scale) || magnitude < 1e-300) {
+            throw std::runtime_error("Matrix is singular");
+        }
+        A[j * N + j] = d;
+
+        for (int i = j + 1; i < N; ++i) {
+            double s = A[i * N + j];
+            for (int k = 0; k < j; ++k) {
+                s -= A[i * N + k] * A[j * N + k] * A[k * N + k];
+            }
+            A[i * N + j] = s / d;
+        }
+    }
+
+    for (int i = 1; i < N; ++i) {
+        for (int k = 0; k < i; ++k) {
+            b[i] -= A[i * N + k] * b[k];
+        }
+    }
+    for (int i = 0; i < N; ++i) {
+        b[i] /= A[i * N + i];
+    }
+    for (int i = N - 2; i >= 0; --i) {
+        for (int k = i + 1; k < N; ++k) {
+            b[i] -= A[k * N + i] * b[k];
+        }
+    }
+    return b;
+}
+
+// Копирует CSR-матрицу в массив на стеке и решает систему размера N
+template<int N>
+void solveFixedFromSparse(const SparseMatrix& A, const double* b, double* x)
+{
+    std::array<double, N * N> dense{};
+    std::array<double, N> rhs{};
+    for (int i = 0; i < N; ++i) {
+        for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+            dense[i * N + A.colIdx[k]] = A.values[k];
+        }
+        rhs[i] = b[i];
+    }
+    std::array<double, N> result = solveFixed<N>(dense, rhs);
+    for (int i = 0; i < N; ++i) {
+        x[i] = result[i];
+    }
+}
+
+// Диспетчер по размеру: false, если система больше FixedSolverMaxSize.
+// Решение пишется в буфер вызывающего (ws.deltas): его размер доводится до
+// A.n, и при повторных расчетах память не выделяется
+inline bool solveFixedSize(const SparseMatrix& A, const std::vector<double>& b, std::vector<double>& x)
+{
+    using Solver = void (*)(const SparseMatrix&, const double*, double*);
+    static constexpr auto table = []<int... I>(std::integer_sequence<int, I...>) {
+        return std::array<Solver, sizeof...(I)>{ &solveFixedFromSparse<I + 1>... };
+    }(std::make_integer_sequence<int, FixedSolverMaxSize>{});
+
+    if (A.n < 1 || A.n > FixedSolverMaxSize) {
+        return false;
+    }
+    x.resize(A.n);
+    table[A.n - 1](A, b.data(), x.data());
+    return true;
+}
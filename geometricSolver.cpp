@@ -0,0 +1,204 @@
+#include "geometricSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Положения элементов стержня в CSR касательной матрицы; -1 — опорный узел
+struct BarEntries {
+    int ll = -1;
+    int rr = -1;
+    int lr = -1;
+    int rl = -1;
+};
+
+int entryIndex(SparseMatrix& A, int row, int col)
+{
+    double* entry = A.find(row, col);
+    if (!entry) {
+        throw std::runtime_error("Bar entry is missing from the stiffness pattern");
+    }
+    return static_cast<int>(entry - A.values.data());
+}
+
+} // namespace
+
+std::vector<double> solveLargeDisplacement(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<GeometricBar>& bars, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const GeometricOptions& options,
+    SkylineCholesky& factor, std::vector<int>& perm, GeometricReport& report)
+{
+    const int n = K.n;
+    const int numBars = static_cast<int>(bars.size());
+    report = GeometricReport();
+
+    // Касательная матрица: начальная K, строки и столбцы опорных узлов — единичные
+    SparseMatrix tangent = K;
+    for (int i = 0; i < n; ++i) {
+        for (int k = tangent.rowPtr[i]; k < tangent.rowPtr[i + 1]; ++k) {
+            int j = tangent.colIdx[k];
+            if (fixed[i] || fixed[j]) {
+                tangent.values[k] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+    std::vector<BarEntries> entries(numBars);
+    std::vector<double> assembled(numBars);
+    for (int b = 0; b < numBars; ++b) {
+        const GeometricBar& bar = bars[b];
+        int l = bar.nodeLeft, r = bar.nodeRight;
+        if (!fixed[l]) entries[b].ll = entryIndex(tangent, l, l);
+        if (!fixed[r]) entries[b].rr = entryIndex(tangent, r, r);
+        if (!fixed[l] && !fixed[r]) {
+            entries[b].lr = entryIndex(tangent, l, r);
+            entries[b].rl = entryIndex(tangent, r, l);
+        }
+        assembled[b] = bar.stiffness;
+    }
+
+    if (static_cast<int>(perm.size()) != n) {
+        perm = reverseCuthillMcKee(tangent);
+    }
+    factor.factorize(tangent, perm);
+    report.factorizations = 1;
+
+    std::vector<double> forces(numBars), stiffness(numBars);
+    std::vector<double> Ku(n), r(n), du(n);
+
+    // Усилия, касательные жесткости и невязка λ·B - f_int(u),
+    // f_int = K u + сумма (N - k·Δ - λ·offset)·e; false — стержень вывернут
+    auto evaluate = [&](double lambda, const std::vector<double>& u, double& relative) {
+        double scale = 0.0;
+        K.multiply(u, Ku);
+        for (int i = 0; i < n; ++i) {
+            r[i] = fixed[i] ? 0.0 : lambda * B[i] - Ku[i];
+            scale = std::max(scale, std::abs(lambda * B[i]));
+        }
+        for (int b = 0; b < numBars; ++b) {
+            const GeometricBar& bar = bars[b];
+            double elongation = u[bar.nodeRight] - u[bar.nodeLeft];
+            if (!(bar.length + elongation > 0.0)) return false;
+            double axial = bar.stiffness * bar.length * std::log1p(elongation / bar.length);
+            forces[b] = axial + lambda * bar.offset;
+            stiffness[b] = bar.stiffness * bar.length / (bar.length + elongation);
+            scale = std::max(scale, std::abs(forces[b]));
+
+            double excess = axial - bar.stiffness * elongation;
+            if (!fixed[bar.nodeRight]) r[bar.nodeRight] -= excess;
+            if (!fixed[bar.nodeLeft]) r[bar.nodeLeft] += excess;
+        }
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i) norm = std::max(norm, std::abs(r[i]));
+        relative = norm / std::max(1e-300, scale);
+        return true;
+    };
+
+    // Линейное решение при λ = 1 — для сравнения
+    std::vector<double> u(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        if (fixed[i]) u[i] = prescribed[i];
+    }
+    K.multiply(u, Ku);
+    for (int i = 0; i < n; ++i) {
+        r[i] = fixed[i] ? 0.0 : B[i] - Ku[i];
+    }
+    factor.solve(r, du);
+    report.linearDisplacements = u;
+    for (int i = 0; i < n; ++i) {
+        if (!fixed[i]) report.linearDisplacements[i] += du[i];
+    }
+
+    double lambda = 0.0;
+    double step = 1.0 / std::max(1, options.loadSteps);
+    int cutbacksInRow = 0;
+    std::vector<double> uNext(n);
+    while (lambda < 1.0) {
+        double target = std::min(1.0, lambda + step);
+        if (1.0 - target < 1e-12) target = 1.0;
+        uNext = u;
+        for (int i = 0; i < n; ++i) {
+            if (fixed[i]) uNext[i] = target * prescribed[i];
+        }
+
+        GeometricStep record{ target, 0, 0, 0, {} };
+        bool converged = false;
+        for (int iteration = 0;; ++iteration) {
+            double relative = 0.0;
+            if (!evaluate(target, uNext, relative) || !std::isfinite(relative)) break;
+            record.residuals.push_back(relative);
+            if (relative <= options.tolerance) {
+                converged = true;
+                break;
+            }
+            if (iteration == options.maxIterations) break;
+
+            // Пересборка только стержней, чья жесткость заметно изменилась
+            int updates = 0;
+            for (int b = 0; b < numBars; ++b) {
+                double change = stiffness[b] - assembled[b];
+                if (std::abs(change) <= options.updateTolerance * bars[b].stiffness) continue;
+                const BarEntries& e = entries[b];
+                if (e.ll >= 0) tangent.values[e.ll] += change;
+                if (e.rr >= 0) tangent.values[e.rr] += change;
+                if (e.lr >= 0) {
+                    tangent.values[e.lr] -= change;
+                    tangent.values[e.rl] -= change;
+                }
+                assembled[b] = stiffness[b];
+                ++updates;
+            }
+            if (updates > 0) {
+                factor.factorize(tangent, perm);
+                record.factorizations++;
+                record.barUpdates += updates;
+            }
+            factor.solve(r, du);
+
+            // Шаг укорачивается, пока ни один стержень не сжимается в точку
+            double alpha = 1.0;
+            for (int halving = 0; halving < 30; ++halving) {
+                bool valid = true;
+                for (const GeometricBar& bar : bars) {
+                    double elongation = uNext[bar.nodeRight] + alpha * du[bar.nodeRight]
+                        - uNext[bar.nodeLeft] - alpha * du[bar.nodeLeft];
+                    if (!(bar.length + elongation > 0.0)) {
+                        valid = false;
+                        break;
+                    }
+                }
+                if (valid) break;
+                alpha *= 0.5;
+            }
+            for (int i = 0; i < n; ++i) {
+                if (!fixed[i]) uNext[i] += alpha * du[i];
+            }
+            record.iterations = iteration + 1;
+        }
+
+        report.iterations += record.iterations;
+        report.factorizations += record.factorizations;
+        report.barUpdates += record.barUpdates;
+        if (!converged) {
+            step *= 0.5;
+            report.cutbacks++;
+            if (++cutbacksInRow > options.maxCutbacks) {
+                throw std::runtime_error("Large-displacement iterations did not converge");
+            }
+            continue;
+        }
+        cutbacksInRow = 0;
+        u.swap(uNext);
+        lambda = target;
+        report.steps.push_back(std::move(record));
+    }
+
+    double relative = 0.0;
+    evaluate(1.0, u, relative);
+    report.forces = forces;
+    report.stretches.resize(numBars);
+    for (int b = 0; b < numBars; ++b) {
+        report.stretches[b] = 1.0 + (u[bars[b].nodeRight] - u[bars[b].nodeLeft]) / bars[b].length;
+    }
+    return u;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+
+// Стержень с большими удлинениями: логарифмическая деформация ln(l / L),
+// l = L + u_right - u_left, усилие N = k·L·ln(l / L) + λ·offset.
+// Касательная жесткость dN/dl = k·L / l — жесткость по текущей длине
+struct GeometricBar {
+    int nodeLeft;
+    int nodeRight;
+    double stiffness;    // k = EA/L в исходном состоянии
+    double length;       // L
+    double offset;       // пролетные нагрузки и ε_T при λ = 1, как в линейном расчете
+};
+
+struct GeometricOptions {
+    int loadSteps = 10;             // равные шаги по λ до 1
+    int maxIterations = 30;
+    double tolerance = 1e-10;       // ||r||∞ / max(||λF||∞, max |N|)
+    // Вклад стержня пересобирается, если его касательная жесткость ушла
+    // от собранной больше чем на updateTolerance·k; иначе остается прежним
+    double updateTolerance = 1e-8;
+    int maxCutbacks = 8;            // делений шага пополам подряд
+};
+
+struct GeometricStep {
+    double loadFactor;
+    int iterations;
+    int factorizations;
+    int barUpdates;                 // пересобранных вкладов стержней
+    std::vector<double> residuals;  // относительная невязка до каждой итерации и после последней
+};
+
+struct GeometricReport {
+    std::vector<GeometricStep> steps;
+    int iterations = 0;
+    int factorizations = 0;
+    int barUpdates = 0;
+    int cutbacks = 0;
+    std::vector<double> linearDisplacements;   // решение K u = F для сравнения
+    std::vector<double> forces;                // N по стержням при λ = 1
+    std::vector<double> stretches;             // l / L
+};
+
+// Нагружение λ·(B, prescribed), λ от 0 до 1, методом Ньютона. K и B — как
+// собраны, до учета опор. Касательная матрица хранится собранной, на итерации
+// меняются только элементы стержней с заметно изменившейся жесткостью, и
+// разложение пересчитывается в factor и perm — буферах рабочего места
+// прямого решателя; perm пересчитывается, если не подходит по размеру
+std::vector<double> solveLargeDisplacement(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<GeometricBar>& bars, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const GeometricOptions& options,
+    SkylineCholesky& factor, std::vector<int>& perm, GeometricReport& report);
@@ -0,0 +1,68 @@
+#include "lineLoad.h"
+#include <algorithm>
+
+// На участке [a, b] длины h с t = x - a:
+//   Q = qa·t + (qb - qa)·t² / (2h),  R = qa·t² / 2 + (qb - qa)·t³ / (6h),
+// правее участка Q постоянна, R растет линейно
+
+double LoadDistribution::intensity(double x) const
+{
+    double q = uniform;
+    if (!segments) return q;
+    for (const LineLoad& load : *segments) {
+        if (x < load.start || x > load.end) continue;
+        double h = load.end - load.start;
+        double t = h > 0.0 ? (x - load.start) / h : 0.0;
+        q += load.qStart + (load.qEnd - load.qStart) * t;
+    }
+    return q;
+}
+
+double LoadDistribution::resultant(double x, bool rightLimit) const
+{
+    double Q = uniform * x;
+    if (points) {
+        for (const PointLoad& load : *points) {
+            if (load.position < x || (rightLimit && load.position == x)) Q += load.force;
+        }
+    }
+    if (!segments) return Q;
+    for (const LineLoad& load : *segments) {
+        if (x <= load.start || load.end <= load.start) continue;
+        double h = load.end - load.start;
+        double t = (x < load.end ? x : load.end) - load.start;
+        Q += load.qStart * t + (load.qEnd - load.qStart) * t * t / (2.0 * h);
+    }
+    return Q;
+}
+
+double LoadDistribution::moment(double x) const
+{
+    double R = uniform * x * x / 2.0;
+    if (points) {
+        for (const PointLoad& load : *points) {
+            if (load.position < x) R += load.force * (x - load.position);
+        }
+    }
+    if (!segments) return R;
+    for (const LineLoad& load : *segments) {
+        if (x <= load.start || load.end <= load.start) continue;
+        double h = load.end - load.start;
+        double t = (x < load.end ? x : load.end) - load.start;
+        double dq = load.qEnd - load.qStart;
+        R += load.qStart * t * t / 2.0 + dq * t * t * t / (6.0 * h);
+        if (x > load.end) {
+            R += (load.qStart + load.qEnd) * h / 2.0 * (x - load.end);
+        }
+    }
+    return R;
+}
+
+double LoadHistory::at(double t) const
+{
+    if (t <= times.front()) return values.front();
+    if (t >= times.back()) return values.back();
+    size_t k = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    double s = (t - times[k - 1]) / (times[k] - times[k - 1]);
+    return values[k - 1] + (values[k] - values[k - 1]) * s;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+
+// Участок распределенной нагрузки: q меняется линейно от qStart в точке start
+// до qEnd в точке end, координаты в метрах от левого конца стержня
+struct LineLoad {
+    double start;
+    double end;
+    double qStart;
+    double qEnd;
+};
+
+// Сосредоточенная сила внутри стержня, position — м от левого конца
+struct PointLoad {
+    double position;
+    double force;
+};
+
+// Закон изменения нагрузки во времени: кусочно-линейная таблица,
+// times по возрастанию, вне таблицы — крайние значения
+struct LoadHistory {
+    std::vector<double> times;
+    std::vector<double> values;
+
+    bool empty() const { return times.empty(); }
+    double at(double t) const;
+};
+
+// Все пролетные нагрузки стержня: равномерная по всей длине, список
+// участков и сосредоточенные силы. Интегралы берутся в замкнутом виде,
+// без дробления стержня
+struct LoadDistribution {
+    double uniform = 0.0;
+    const std::vector<LineLoad>* segments = nullptr;
+    const std::vector<PointLoad>* points = nullptr;
+
+    double intensity(double x) const;   // q(x)
+    // Q(x) = ∫ q ds от 0 до x плюс силы левее x; в точке силы Q скачет,
+    // rightLimit = true — значение справа от скачка
+    double resultant(double x, bool rightLimit = false) const;
+    double moment(double x) const;      // R(x) = ∫ Q ds от 0 до x, непрерывна
+    double total(double L) const { return resultant(L, true); }
+    bool empty() const
+    {
+        return uniform == 0.0 && (!segments || segments->empty()) && (!points || points->empty());
+    }
+};
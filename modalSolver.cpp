@@ -0,0 +1,427 @@
+#include "modalSolver.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <QtConcurrent>
+
+bool extractChainPair(const SparseMatrix& K, const SparseMatrix& M, const std::vector<char>& fixed,
+    TridiagonalMatrix& Kt, TridiagonalMatrix& Mt, std::vector<int>& nodes)
+{
+    // Свободные узлы: опорные строки и столбцы просто выбрасываются
+    std::vector<int> reducedIndex(K.n, -1);
+    std::vector<int> freeNodes;
+    for (int i = 0; i < K.n; ++i) {
+        if (!fixed[i]) {
+            reducedIndex[i] = static_cast<int>(freeNodes.size());
+            freeNodes.push_back(i);
+        }
+    }
+    const int n = static_cast<int>(freeNodes.size());
+
+    SparseBuilder builder(n);
+    builder.reserve(K.nonZeros());
+    for (int i = 0; i < K.n; ++i) {
+        if (reducedIndex[i] < 0) continue;
+        for (int k = K.rowPtr[i]; k < K.rowPtr[i + 1]; ++k) {
+            int j = K.colIdx[k];
+            if (reducedIndex[j] >= 0) builder.add(reducedIndex[i], reducedIndex[j], K.values[k]);
+        }
+    }
+    SparseMatrix reduced = builder.toCSR();
+
+    // Для цепочки RCM начинает с конца куска и нумерует узлы подряд
+    std::vector<int> perm = reverseCuthillMcKee(reduced);
+    std::vector<int> position(K.n, -1);
+    nodes.resize(n);
+    for (int p = 0; p < n; ++p) {
+        nodes[p] = freeNodes[perm[p]];
+        position[nodes[p]] = p;
+    }
+
+    auto fill = [&](const SparseMatrix& A, TridiagonalMatrix& T) {
+        T.lower.assign(n, 0.0);
+        T.diag.assign(n, 0.0);
+        T.upper.assign(n, 0.0);
+        for (int i = 0; i < A.n; ++i) {
+            int p = position[i];
+            if (p < 0) continue;
+            for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+                int q = position[A.colIdx[k]];
+                if (q < 0) continue;
+                if (q == p - 1) T.lower[p] += A.values[k];
+                else if (q == p) T.diag[p] += A.values[k];
+                else if (q == p + 1) T.upper[p] += A.values[k];
+                else if (A.values[k] != 0.0) return false;
+            }
+        }
+        return true;
+    };
+    return fill(K, Kt) && fill(M, Mt);
+}
+
+namespace {
+
+// Порог ведущего элемента: нулевой D заменяется малым отрицательным,
+// как в LAPACK (dstebz), чтобы следующий шаг не делил на ноль
+double pivotThreshold(const TridiagonalMatrix& K, const TridiagonalMatrix& M, double sigma)
+{
+    double maxOff = 1.0;
+    for (int i = 1; i < K.size(); ++i) {
+        double b = K.lower[i] - sigma * M.lower[i];
+        maxOff = std::max(maxOff, b * b);
+    }
+    return std::numeric_limits<double>::min() * maxOff;
+}
+
+int countBelow(const TridiagonalMatrix& K, const TridiagonalMatrix& M, double sigma, double pivmin)
+{
+    const int n = K.size();
+    int negatives = 0;
+    double d = 1.0;
+    for (int i = 0; i < n; ++i) {
+        double a = K.diag[i] - sigma * M.diag[i];
+        if (i > 0) {
+            double b = K.lower[i] - sigma * M.lower[i];
+            a -= b * b / d;
+        }
+        if (std::abs(a) < pivmin) a = -pivmin;
+        if (a < 0.0) ++negatives;
+        d = a;
+    }
+    return negatives;
+}
+
+// Число Штурма сразу для ShiftLanes сдвигов: цепочки делений независимы
+// и векторизуются, поэтому проход по матрице стоит почти как для одного сдвига
+constexpr int ShiftLanes = 8;
+
+void countBelowBatch(const TridiagonalMatrix& K, const TridiagonalMatrix& M,
+    const double* sigma, double pivmin, int* counts)
+{
+    const int n = K.size();
+    double d[ShiftLanes];
+    double negatives[ShiftLanes];
+    for (int s = 0; s < ShiftLanes; ++s) {
+        d[s] = 1.0;
+        negatives[s] = 0.0;
+    }
+    for (int i = 0; i < n; ++i) {
+        const double kd = K.diag[i], md = M.diag[i];
+        const double kl = i > 0 ? K.lower[i] : 0.0, ml = i > 0 ? M.lower[i] : 0.0;
+        for (int s = 0; s < ShiftLanes; ++s) {
+            double b = kl - sigma[s] * ml;
+            double a = kd - sigma[s] * md - b * b / d[s];
+            a = std::abs(a) < pivmin ? -pivmin : a;
+            negatives[s] += a < 0.0 ? 1.0 : 0.0;
+            d[s] = a;
+        }
+    }
+    for (int s = 0; s < ShiftLanes; ++s) {
+        counts[s] = static_cast<int>(negatives[s]);
+    }
+}
+
+// Бисекция интервалов (lo, hi], в каждом лежат значения с номерами [countLo, countHi).
+// Интервал делится пополам, пока в нем есть значения из [first, last) и он шире
+// допуска; середины до ShiftLanes интервалов считаются одним проходом
+struct Bisection {
+    struct Interval {
+        double lo;
+        double hi;
+        int countLo;
+        int countHi;
+    };
+
+    const TridiagonalMatrix& K;
+    const TridiagonalMatrix& M;
+    double pivmin;
+    double relTol;
+    double absTol;
+    int first;
+    int last;
+    std::vector<double>& eigenvalues;
+    long long counts = 0;
+
+    void run(const Interval& initial)
+    {
+        std::vector<Interval> work;
+        push(work, initial);
+
+        Interval batch[ShiftLanes];
+        double mids[ShiftLanes];
+        int midCounts[ShiftLanes];
+        while (!work.empty()) {
+            int lanes = 0;
+            while (lanes < ShiftLanes && !work.empty()) {
+                batch[lanes] = work.back();
+                work.pop_back();
+                mids[lanes] = 0.5 * (batch[lanes].lo + batch[lanes].hi);
+                ++lanes;
+            }
+            for (int s = lanes; s < ShiftLanes; ++s) {
+                mids[s] = mids[0];
+            }
+            countBelowBatch(K, M, mids, pivmin, midCounts);
+            ++counts;
+
+            for (int s = 0; s < lanes; ++s) {
+                const Interval& v = batch[s];
+                push(work, { v.lo, mids[s], v.countLo, midCounts[s] });
+                push(work, { mids[s], v.hi, midCounts[s], v.countHi });
+            }
+        }
+    }
+
+    // Пустые и чужие интервалы отбрасываются, узкие сразу дают значения
+    void push(std::vector<Interval>& work, const Interval& v)
+    {
+        if (v.countHi <= first || v.countLo >= last || v.countLo == v.countHi) return;
+
+        double mid = 0.5 * (v.lo + v.hi);
+        double width = v.hi - v.lo;
+        if (width <= relTol * std::max(std::abs(v.lo), std::abs(v.hi)) + absTol || mid <= v.lo || mid >= v.hi) {
+            for (int k = std::max(v.countLo, first); k < std::min(v.countHi, last); ++k) {
+                eigenvalues[k] = mid;
+            }
+            return;
+        }
+        work.push_back(v);
+    }
+};
+
+// LU-разложение трехдиагональной K - σM с выбором ведущего элемента по строкам
+// (как dgttrf): U имеет две наддиагонали
+struct ShiftedFactor {
+    std::vector<double> lower, diag, upper, upper2;
+    std::vector<char> swapped;
+
+    void factorize(const TridiagonalMatrix& K, const TridiagonalMatrix& M, double sigma, double pivmin)
+    {
+        const int n = K.size();
+        lower.assign(n, 0.0);
+        diag.resize(n);
+        upper.assign(n, 0.0);
+        upper2.assign(n, 0.0);
+        swapped.assign(n, 0);
+        for (int i = 0; i < n; ++i) {
+            diag[i] = K.diag[i] - sigma * M.diag[i];
+            if (i + 1 < n) upper[i] = K.upper[i] - sigma * M.upper[i];
+        }
+        for (int i = 0; i + 1 < n; ++i) {
+            double sub = K.lower[i + 1] - sigma * M.lower[i + 1];
+            if (std::abs(diag[i]) >= std::abs(sub)) {
+                if (std::abs(diag[i]) < pivmin) diag[i] = pivmin;
+                double l = sub / diag[i];
+                lower[i] = l;
+                diag[i + 1] -= l * upper[i];
+            }
+            else {
+                // Перестановка строк i и i+1
+                double l = diag[i] / sub;
+                swapped[i] = 1;
+                lower[i] = l;
+                diag[i] = sub;
+                double next = diag[i + 1];
+                double nextUpper = (i + 2 < n) ? upper[i + 1] : 0.0;
+                diag[i + 1] = upper[i] - l * next;
+                upper[i] = next;
+                upper2[i] = nextUpper;
+                if (i + 2 < n) upper[i + 1] = -l * nextUpper;
+            }
+        }
+        if (n > 0 && std::abs(diag[n - 1]) < pivmin) diag[n - 1] = pivmin;
+    }
+
+    void solve(std::vector<double>& x) const
+    {
+        const int n = static_cast<int>(diag.size());
+        for (int i = 0; i + 1 < n; ++i) {
+            if (swapped[i]) {
+                std::swap(x[i], x[i + 1]);
+            }
+            x[i + 1] -= lower[i] * x[i];
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double s = x[i];
+            if (i + 1 < n) s -= upper[i] * x[i + 1];
+            if (i + 2 < n) s -= upper2[i] * x[i + 2];
+            x[i] = s / diag[i];
+        }
+    }
+};
+
+void multiply(const TridiagonalMatrix& T, const std::vector<double>& x, std::vector<double>& y)
+{
+    const int n = T.size();
+    y.resize(n);
+    for (int i = 0; i < n; ++i) {
+        double s = T.diag[i] * x[i];
+        if (i > 0) s += T.lower[i] * x[i - 1];
+        if (i + 1 < n) s += T.upper[i] * x[i + 1];
+        y[i] = s;
+    }
+}
+
+double dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+}
+
+double maxNorm(const std::vector<double>& x)
+{
+    double norm = 0.0;
+    for (double v : x) norm = std::max(norm, std::abs(v));
+    return norm;
+}
+
+} // namespace
+
+int sturmCount(const TridiagonalMatrix& K, const TridiagonalMatrix& M, double sigma)
+{
+    return countBelow(K, M, sigma, pivotThreshold(K, M, sigma));
+}
+
+ModalResult solveTridiagonalModes(const TridiagonalMatrix& K, const TridiagonalMatrix& M,
+    int count, int shapes, double tolerance, int threads)
+{
+    const int n = K.size();
+    if (M.size() != n) {
+        throw std::invalid_argument("Mass and stiffness matrices differ in size");
+    }
+    count = std::clamp(count, 0, n);
+    shapes = std::clamp(shapes, 0, count);
+
+    ModalResult result;
+    result.eigenvalues.assign(count, 0.0);
+    if (count == 0) return result;
+
+    // Масштаб спектра и нормы: max K_ii / M_ii, ||K||_∞
+    double scale = 0.0;
+    double normK = 0.0;
+    for (int i = 0; i < n; ++i) {
+        if (!(M.diag[i] > 0.0)) {
+            throw std::runtime_error("Mass matrix is not positive definite");
+        }
+        scale = std::max(scale, std::abs(K.diag[i]) / M.diag[i]);
+        double row = std::abs(K.diag[i]) + std::abs(K.lower[i]) + (i + 1 < n ? std::abs(K.upper[i]) : 0.0);
+        normK = std::max(normK, row);
+    }
+    if (scale == 0.0) scale = 1.0;
+
+    // K неотрицательно определена, поэтому ниже -scale значений нет;
+    // верхнюю границу удваиваем, пока под ней не окажется count значений
+    const double pivmin = pivotThreshold(K, M, scale);
+    double lo = -scale;
+    double hi = scale;
+    int countHi = countBelow(K, M, hi, pivmin);
+    while (countHi < count && std::isfinite(hi)) {
+        hi *= 2.0;
+        countHi = countBelow(K, M, hi, pivmin);
+    }
+    if (countHi < count) {
+        throw std::runtime_error("Mass matrix is not positive definite");
+    }
+    const int countLo = countBelow(K, M, lo, pivmin);
+    if (countLo > 0) {
+        throw std::runtime_error("Stiffness matrix is not positive semidefinite");
+    }
+
+    if (threads <= 0) {
+        threads = QThreadPool::globalInstance()->maxThreadCount();
+    }
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double absTol = eps * eps * scale;
+
+    // 1. Собственные значения: номера делятся между потоками поровну,
+    //    каждый поток бисекцирует свой диапазон независимо
+    const int chunks = std::max(1, std::min(threads, count / 16));
+    std::vector<int> chunkIds(chunks);
+    std::iota(chunkIds.begin(), chunkIds.end(), 0);
+    std::atomic<long long> counts{ 0 };
+    QtConcurrent::blockingMap(chunkIds, [&](int c) {
+        Bisection bisection{ K, M, pivmin, std::max(tolerance, 2.0 * eps), absTol,
+            static_cast<int>(static_cast<long long>(count) * c / chunks),
+            static_cast<int>(static_cast<long long>(count) * (c + 1) / chunks),
+            result.eigenvalues };
+        bisection.run({ lo, hi, countLo, countHi });
+        counts += bisection.counts;
+        });
+    result.sturmCounts = counts + 2;
+
+    if (shapes == 0) return result;
+
+    // 2. Формы. Близкие значения образуют группу: ее векторы ортогонализуются
+    //    друг к другу по M, поэтому группа целиком считается в одном потоке
+    const double clusterTol = 1e-8;
+    std::vector<int> clusterStart{ 0 };
+    for (int k = 1; k < shapes; ++k) {
+        double gap = result.eigenvalues[k] - result.eigenvalues[k - 1];
+        if (gap > clusterTol * std::abs(result.eigenvalues[k]) + 1e3 * eps * scale) {
+            clusterStart.push_back(k);
+        }
+    }
+    clusterStart.push_back(shapes);
+
+    result.modes.assign(shapes, std::vector<double>());
+    std::vector<int> clusterIds(clusterStart.size() - 1);
+    std::iota(clusterIds.begin(), clusterIds.end(), 0);
+    std::atomic<int> iterations{ 0 };
+    std::vector<double> residuals(shapes, 0.0);
+    const int maxIterations = 8;
+
+    QtConcurrent::blockingMap(clusterIds, [&](int c) {
+        ShiftedFactor factor;
+        std::vector<double> x(n), y(n), Mx(n), Ky(n), My(n);
+        for (int k = clusterStart[c]; k < clusterStart[c + 1]; ++k) {
+            const double lambda = result.eigenvalues[k];
+            factor.factorize(K, M, lambda, std::max(pivmin, eps * normK));
+
+            // Псевдослучайный начальный вектор, свой для каждой моды
+            unsigned state = 2654435761u * static_cast<unsigned>(k + 1);
+            for (int i = 0; i < n; ++i) {
+                state = state * 1664525u + 1013904223u;
+                x[i] = static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+            }
+
+            for (int it = 0; it < maxIterations; ++it) {
+                multiply(M, x, Mx);
+                y = Mx;
+                factor.solve(y);
+                ++iterations;
+
+                // Ортогонализация по M к уже найденным формам группы
+                multiply(M, y, My);
+                for (int j = clusterStart[c]; j < k; ++j) {
+                    const std::vector<double>& phi = result.modes[j];
+                    double proj = dot(phi, My);
+                    for (int i = 0; i < n; ++i) y[i] -= proj * phi[i];
+                }
+                multiply(M, y, My);
+                double norm = std::sqrt(std::max(dot(y, My), 0.0));
+                if (!(norm > 0.0) || !std::isfinite(norm)) {
+                    throw std::runtime_error("Inverse iteration failed");
+                }
+                for (int i = 0; i < n; ++i) y[i] /= norm;
+                x.swap(y);
+
+                // Невязка K φ - λ M φ относительно ||K|| ||φ||
+                multiply(K, x, Ky);
+                multiply(M, x, My);
+                double residual = 0.0;
+                for (int i = 0; i < n; ++i) {
+                    residual = std::max(residual, std::abs(Ky[i] - lambda * My[i]));
+                }
+                residuals[k] = residual / (std::max(normK, eps) * maxNorm(x));
+                if (residuals[k] <= 1e3 * eps * std::sqrt(static_cast<double>(n)) && it > 0) break;
+            }
+            result.modes[k] = x;
+        }
+        });
+
+    result.inverseIterations = iterations;
+    result.maxResidual = *std::max_element(residuals.begin(), residuals.end());
+    return result;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+#include "tridiagSolver.h"
+
+// Собственные пары обобщенной задачи K φ = λ M φ, λ = ω²
+struct ModalResult {
+    std::vector<double> eigenvalues;            // по возрастанию
+    std::vector<std::vector<double>> modes;     // формы, нормированы φᵀ M φ = 1
+    long long sturmCounts = 0;                  // вычислений числа Штурма
+    int inverseIterations = 0;                  // шагов обратной итерации, всего
+    double maxResidual = 0.0;                   // max ||K φ - λ M φ|| / (||K|| ||φ||)
+};
+
+// Трехдиагональная форма пары (K, M) по свободным узлам. Перестановка RCM
+// выстраивает цепочку по порядку; опоры и зазоры рвут ее на куски, куски
+// идут друг за другом. nodes[i] — исходный узел строки i.
+// false — система разветвленная и трехдиагональной формы не имеет
+bool extractChainPair(const SparseMatrix& K, const SparseMatrix& M, const std::vector<char>& fixed,
+    TridiagonalMatrix& Kt, TridiagonalMatrix& Mt, std::vector<int>& nodes);
+
+// Число собственных значений меньше sigma: по закону инерции Сильвестра —
+// число отрицательных элементов D в разложении K - sigma·M = L D Lᵀ
+int sturmCount(const TridiagonalMatrix& K, const TridiagonalMatrix& M, double sigma);
+
+// Нижние count собственных пар, M положительно определена. Собственные значения —
+// бисекцией по числу Штурма, O(n) на шаг; интервал делится пополам сразу для
+// всех значений внутри, середины нескольких интервалов считаются за один проход; формы — обратной итерацией с LU-разложением K - λM
+// с выбором ведущего элемента, близкие значения ортогонализуются по M.
+// Формы считаются только для нижних shapes мод. threads = 0 — по числу потоков пула
+ModalResult solveTridiagonalModes(const TridiagonalMatrix& K, const TridiagonalMatrix& M,
+    int count, int shapes, double tolerance = 1e-12, int threads = 0);
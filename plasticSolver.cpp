@@ -0,0 +1,337 @@
+#include "plasticSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Состояние стержня: пластическое удлинение и обратная сила упрочнения
+struct BarState {
+    double plastic = 0.0;
+    double back = 0.0;
+};
+
+// Вектор стержня e: -1 в левом узле, +1 в правом, опорные узлы исключены
+double applyBar(const PlasticBar& bar, const std::vector<char>& fixed, const std::vector<double>& v)
+{
+    double value = 0.0;
+    if (!fixed[bar.nodeRight]) value += v[bar.nodeRight];
+    if (!fixed[bar.nodeLeft]) value -= v[bar.nodeLeft];
+    return value;
+}
+
+// Касательная матрица K + сумма (k_t - k)·e·eᵀ через разложение базовой
+// касательной и поправку Вудбери по стержням, чья жесткость от базы отличается
+class TangentFactor {
+public:
+    TangentFactor(const SparseMatrix& K, const std::vector<PlasticBar>& bars, const std::vector<char>& fixed)
+        : m_K(K), m_bars(bars), m_fixed(fixed), m_columns(bars.size())
+    {
+        // Строки и столбцы опорных узлов — единичные
+        for (int i = 0; i < m_K.n; ++i) {
+            for (int k = m_K.rowPtr[i]; k < m_K.rowPtr[i + 1]; ++k) {
+                int j = m_K.colIdx[k];
+                if (m_fixed[i] || m_fixed[j]) {
+                    m_K.values[k] = (i == j) ? 1.0 : 0.0;
+                }
+            }
+        }
+        m_perm = reverseCuthillMcKee(m_K);
+    }
+
+    void factorize(const std::vector<double>& tangent)
+    {
+        SparseMatrix A = m_K;
+        for (size_t b = 0; b < m_bars.size(); ++b) {
+            double change = tangent[b] - m_bars[b].stiffness;
+            if (change != 0.0) addBar(A, m_bars[b], change);
+        }
+        // При вырожденности прежнее разложение остается рабочим
+        SkylineCholesky cholesky;
+        cholesky.factorize(A, m_perm);
+        m_cholesky = std::move(cholesky);
+        m_base = tangent;
+        for (auto& column : m_columns) column.clear();
+    }
+
+    int changedBars(const std::vector<double>& tangent) const
+    {
+        int count = 0;
+        for (size_t b = 0; b < m_bars.size(); ++b) {
+            count += tangent[b] != m_base[b];
+        }
+        return count;
+    }
+
+    void solve(const std::vector<double>& tangent, const std::vector<double>& r,
+        std::vector<double>& x, int& rank) const
+    {
+        std::vector<int> changed;
+        for (size_t b = 0; b < m_bars.size(); ++b) {
+            if (tangent[b] != m_base[b]) changed.push_back(static_cast<int>(b));
+        }
+        rank = static_cast<int>(changed.size());
+
+        m_cholesky.solve(r, x);
+        if (changed.empty()) return;
+
+        // Вудбери: (F + E C Eᵀ)^-1 r = y - Z (I + C Eᵀ Z)^-1 C Eᵀ y, Z = F^-1 E.
+        // I + C Eᵀ Z безразмерна, ее определитель — det K_t / det F: нулевой
+        // ведущий элемент означает механизм, а не потерю точности
+        const int m = rank;
+        std::vector<double> T(m * m, 0.0), t(m);
+        for (int i = 0; i < m; ++i) {
+            int bi = changed[i];
+            const std::vector<double>& zi = column(bi);
+            for (int j = 0; j < m; ++j) {
+                int bj = changed[j];
+                T[j * m + i] = (tangent[bj] - m_base[bj]) * applyBar(m_bars[bj], m_fixed, zi);
+            }
+            T[i * m + i] += 1.0;
+            t[i] = (tangent[bi] - m_base[bi]) * applyBar(m_bars[bi], m_fixed, x);
+        }
+        std::vector<double> w = solveDense(T, t, m, MechanismPivot);
+        for (int i = 0; i < m; ++i) {
+            const std::vector<double>& zi = column(changed[i]);
+            for (size_t k = 0; k < x.size(); ++k) {
+                x[k] -= zi[k] * w[i];
+            }
+        }
+    }
+
+private:
+    static constexpr double MechanismPivot = 1e-10;
+
+    void addBar(SparseMatrix& A, const PlasticBar& bar, double change) const
+    {
+        int l = bar.nodeLeft, r = bar.nodeRight;
+        if (!m_fixed[l]) *A.find(l, l) += change;
+        if (!m_fixed[r]) *A.find(r, r) += change;
+        if (!m_fixed[l] && !m_fixed[r]) {
+            *A.find(l, r) -= change;
+            *A.find(r, l) -= change;
+        }
+    }
+
+    // F^-1 e_b считается один раз на базовое разложение
+    const std::vector<double>& column(int b) const
+    {
+        std::vector<double>& z = m_columns[b];
+        if (z.empty()) {
+            std::vector<double> e(m_K.n, 0.0);
+            if (!m_fixed[m_bars[b].nodeRight]) e[m_bars[b].nodeRight] = 1.0;
+            if (!m_fixed[m_bars[b].nodeLeft]) e[m_bars[b].nodeLeft] = -1.0;
+            m_cholesky.solve(e, z);
+        }
+        return z;
+    }
+
+    SparseMatrix m_K;
+    const std::vector<PlasticBar>& m_bars;
+    const std::vector<char>& m_fixed;
+    std::vector<int> m_perm;
+    SkylineCholesky m_cholesky;
+    std::vector<double> m_base;
+    mutable std::vector<std::vector<double>> m_columns;
+};
+
+} // namespace
+
+std::vector<double> solvePlastic(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<PlasticBar>& bars, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const PlasticOptions& options, PlasticReport& report)
+{
+    const int n = K.n;
+    const int numBars = static_cast<int>(bars.size());
+    report = PlasticReport();
+
+    std::vector<double> elastic(numBars);
+    for (int b = 0; b < numBars; ++b) {
+        elastic[b] = bars[b].stiffness;
+    }
+    TangentFactor factor(K, bars, fixed);
+    factor.factorize(elastic);
+    report.factorizations = 1;
+
+    std::vector<BarState> committed(numBars), trial(numBars);
+    std::vector<double> tangent(numBars), forces(numBars);
+    std::vector<char> yielding(numBars);
+    std::vector<double> Ku(n), r(n), du(n);
+
+    // Возврат на диаграмму от сошедшегося состояния и невязка λ·B - f_int(u),
+    // f_int = K u - сумма k·δp·e; возвращает масштаб для критерия сходимости
+    auto evaluate = [&](double lambda, const std::vector<double>& u) {
+        double scale = 0.0;
+        for (int b = 0; b < numBars; ++b) {
+            const PlasticBar& bar = bars[b];
+            BarState state = committed[b];
+            double k = bar.stiffness;
+            double N = k * (u[bar.nodeRight] - u[bar.nodeLeft] - state.plastic) + lambda * bar.offset;
+            double ratio = std::clamp(bar.hardeningRatio, 0.0, 1.0);
+            double excess = std::abs(N - state.back) - bar.yieldForce;
+            tangent[b] = k;
+            yielding[b] = 0;
+            if (bar.yieldForce > 0.0 && ratio < 1.0 && excess > 1e-12 * bar.yieldForce) {
+                // Кинематическое упрочнение: H = k·r / (1 - r), Δγ = excess / (k + H)
+                double sign = N > state.back ? 1.0 : -1.0;
+                N -= sign * excess * (1.0 - ratio);
+                state.back += sign * excess * ratio;
+                state.plastic += sign * excess * (1.0 - ratio) / k;
+                tangent[b] = ratio * k;
+                yielding[b] = 1;
+            }
+            else if (bar.yieldForce > 0.0 && excess > -1e-12 * bar.yieldForce) {
+                yielding[b] = 1;
+            }
+            trial[b] = state;
+            forces[b] = N;
+            scale = std::max(scale, std::abs(N));
+        }
+        K.multiply(u, Ku);
+        for (int i = 0; i < n; ++i) {
+            r[i] = fixed[i] ? 0.0 : lambda * B[i] - Ku[i];
+            scale = std::max(scale, std::abs(lambda * B[i]));
+        }
+        for (int b = 0; b < numBars; ++b) {
+            double f = bars[b].stiffness * trial[b].plastic;
+            if (f == 0.0) continue;
+            if (!fixed[bars[b].nodeRight]) r[bars[b].nodeRight] += f;
+            if (!fixed[bars[b].nodeLeft]) r[bars[b].nodeLeft] -= f;
+        }
+        return scale;
+    };
+
+    auto residualNorm = [&]() {
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i) norm = std::max(norm, std::abs(r[i]));
+        return norm;
+    };
+
+    auto saveState = [&](double lambda) {
+        report.loadFactor = lambda;
+        report.forces = forces;
+        report.plasticElongation.resize(numBars);
+        for (int b = 0; b < numBars; ++b) {
+            report.plasticElongation[b] = committed[b].plastic;
+        }
+        report.yielding = yielding;
+    };
+
+    // Упругое решение при λ = 1: до первой текучести все пропорционально λ
+    std::vector<double> u(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        if (fixed[i]) u[i] = prescribed[i];
+    }
+    evaluate(1.0, u);
+    int rank = 0;
+    factor.solve(elastic, r, du, rank);
+    for (int i = 0; i < n; ++i) {
+        if (!fixed[i]) u[i] += du[i];
+    }
+
+    double firstYield = std::numeric_limits<double>::infinity();
+    for (int b = 0; b < numBars; ++b) {
+        const PlasticBar& bar = bars[b];
+        double N = bar.stiffness * (u[bar.nodeRight] - u[bar.nodeLeft]) + bar.offset;
+        if (bar.yieldForce <= 0.0 || N == 0.0) continue;
+        double factorAtYield = bar.yieldForce / std::abs(N);
+        if (factorAtYield < firstYield) {
+            firstYield = factorAtYield;
+            report.firstYieldBar = b;
+        }
+    }
+
+    const double maxLoad = options.maxLoadFactor > 0.0 ? options.maxLoadFactor
+        : std::numeric_limits<double>::infinity();
+    double lambda = std::isfinite(firstYield) ? std::min(firstYield, maxLoad)
+        : (std::isfinite(maxLoad) ? maxLoad : 1.0);
+    for (double& value : u) value *= lambda;
+    double scale = evaluate(lambda, u);
+    PlasticStep elasticStep{ lambda, 1, 0, 0.0, residualNorm() / std::max(1e-300, scale) };
+    for (double value : u) {
+        elasticStep.maxDisplacement = std::max(elasticStep.maxDisplacement, std::abs(value));
+    }
+    report.history.push_back(elasticStep);
+    if (!std::isfinite(firstYield)) {
+        saveState(lambda);
+        return u;
+    }
+    report.firstYieldFactor = firstYield;
+    report.history.back().yieldedBars = 1;
+    saveState(lambda);
+
+    const double initialStep = options.stepFraction * firstYield;
+    const double minStep = options.minStepFraction * firstYield;
+    double step = initialStep;
+    std::vector<double> uNext(n);
+    while (lambda < maxLoad && static_cast<int>(report.history.size()) <= options.maxSteps) {
+        double target = std::min(lambda + step, maxLoad);
+        uNext = u;
+        for (int i = 0; i < n; ++i) {
+            if (fixed[i]) uNext[i] = target * prescribed[i];
+        }
+
+        bool converged = false;
+        int iterations = 0;
+        double relative = 0.0;
+        try {
+            for (;; ++iterations) {
+                double scale = evaluate(target, uNext);
+                relative = residualNorm() / std::max(1e-300, scale);
+                if (!std::isfinite(relative)) break;
+                if (relative <= options.tolerance) {
+                    converged = true;
+                    break;
+                }
+                if (iterations == options.maxIterations) break;
+
+                if (factor.changedBars(tangent) > options.maxRank) {
+                    // Вырожденная касательная (механизм) здесь бросает исключение
+                    factor.factorize(tangent);
+                    report.factorizations++;
+                }
+                factor.solve(tangent, r, du, rank);
+                if (rank > 0) report.lowRankSolves++;
+                for (int i = 0; i < n; ++i) {
+                    if (!fixed[i]) uNext[i] += du[i];
+                }
+            }
+        }
+        catch (const std::runtime_error&) {
+            converged = false;
+        }
+        report.newtonIterations += iterations;
+
+        if (!converged) {
+            // Равновесия при target нет или Ньютон зациклился между
+            // состояниями: шаг делится пополам
+            step *= 0.5;
+            report.cutbacks++;
+            if (step < minStep) {
+                report.collapsed = true;
+                report.collapseFactor = lambda;
+                report.collapseBracket = target;
+                break;
+            }
+            continue;
+        }
+
+        committed = trial;
+        u.swap(uNext);
+        lambda = target;
+        PlasticStep record{ lambda, iterations, 0, 0.0, relative };
+        for (int b = 0; b < numBars; ++b) {
+            record.yieldedBars += yielding[b];
+        }
+        for (double value : u) {
+            record.maxDisplacement = std::max(record.maxDisplacement, std::abs(value));
+        }
+        report.history.push_back(record);
+        saveState(lambda);
+        if (iterations <= 3) {
+            step = std::min(2.0 * step, initialStep);
+        }
+    }
+    return u;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+
+// Стержень с билинейной диаграммой N — удлинение: до |N - α| = yieldForce
+// жесткость k, после — k_t = hardeningRatio·k (α — обратная сила
+// кинематического упрочнения). offset — часть среднего усилия от пролетных
+// нагрузок и ε_T при λ = 1: N = k·(u_right - u_left - δp) + λ·offset
+struct PlasticBar {
+    int nodeLeft;
+    int nodeRight;
+    double stiffness;
+    double offset;
+    double yieldForce;       // σ_т·A_min; <= 0 — стержень не течет
+    double hardeningRatio;   // E_t / E, от 0 (идеальная пластичность) до 1
+};
+
+struct PlasticOptions {
+    double stepFraction = 0.1;     // шаг по λ в долях λ первой текучести
+    double maxLoadFactor = 0.0;    // 0 — до разрушения
+    int maxSteps = 500;
+    int maxIterations = 30;
+    double tolerance = 1e-10;      // ||r||∞ / max(||λF||∞, max |N|)
+    double minStepFraction = 1e-4; // шаг мельче — разрушение
+    int maxRank = 16;              // поправок больше — разложение заново
+};
+
+// Сходившийся шаг нагружения
+struct PlasticStep {
+    double loadFactor;
+    int iterations;
+    int yieldedBars;
+    double maxDisplacement;
+    double residual;         // относительная невязка на выходе
+};
+
+struct PlasticReport {
+    double firstYieldFactor = 0.0;   // 0 — ни один стержень не течет
+    int firstYieldBar = -1;
+    bool collapsed = false;
+    double collapseFactor = 0.0;     // последний сошедшийся λ перед разрушением
+    double collapseBracket = 0.0;    // λ, при котором равновесия уже нет
+    std::vector<PlasticStep> history;
+    int newtonIterations = 0;
+    int cutbacks = 0;                // делений шага пополам
+    int factorizations = 0;
+    int lowRankSolves = 0;           // решений с поправкой Вудбери
+    // Состояние на последнем сошедшемся шаге
+    double loadFactor = 0.0;
+    std::vector<double> forces;
+    std::vector<double> plasticElongation;
+    std::vector<char> yielding;      // стержень на пределе текучести
+};
+
+// Пропорциональное нагружение λ·(B, prescribed) методом Ньютона — Рафсона
+// с касательной жесткостью. K и B — как собраны, до учета опор; fixed и
+// prescribed — опорные узлы. Упругая жесткость разлагается один раз, текучесть
+// стержня меняет касательную матрицу на (k_t - k)·e·eᵀ, и решение идет через
+// поправку Вудбери; разложение повторяется, только когда поправок много.
+// До первой текучести система линейна, λ первой текучести считается точно.
+// Разрушение — шаг, на котором Ньютон не сходится, мельче minStepFraction
+std::vector<double> solvePlastic(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<PlasticBar>& bars, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const PlasticOptions& options, PlasticReport& report);
@@ -0,0 +1,187 @@
+#include "sectionProfile.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+double SectionProfile::area(double xi, double constantArea) const
+{
+    switch (kind) {
+    case SectionKind::Linear:
+        return values[0] + (values[1] - values[0]) * xi;
+    case SectionKind::Polynomial: {
+        // Схема Горнера
+        double result = 0.0;
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            result = result * xi + *it;
+        }
+        return result;
+    }
+    case SectionKind::Table: {
+        if (xi <= points.front()) return values.front();
+        if (xi >= points.back()) return values.back();
+        size_t k = std::upper_bound(points.begin(), points.end(), xi) - points.begin();
+        double t = (xi - points[k - 1]) / (points[k] - points[k - 1]);
+        return values[k - 1] + (values[k] - values[k - 1]) * t;
+    }
+    case SectionKind::Constant:
+    default:
+        return constantArea;
+    }
+}
+
+bool SectionProfile::isValid() const
+{
+    if (!std::all_of(values.begin(), values.end(), [](double v) { return std::isfinite(v); })) {
+        return false;
+    }
+    switch (kind) {
+    case SectionKind::Linear:
+        return values.size() == 2;
+    case SectionKind::Polynomial:
+        return !values.empty();
+    case SectionKind::Table:
+        return values.size() >= 2 && points.size() == values.size()
+            && std::is_sorted(points.begin(), points.end())
+            && points.front() >= 0.0 && points.back() <= 1.0;
+    case SectionKind::Constant:
+    default:
+        return true;
+    }
+}
+
+double SectionProfile::minArea(double constantArea) const
+{
+    switch (kind) {
+    case SectionKind::Linear:
+    case SectionKind::Table:
+        return *std::min_element(values.begin(), values.end());
+    case SectionKind::Polynomial: {
+        const int samples = 128;
+        double result = area(0.0, constantArea);
+        for (int i = 1; i <= samples; ++i) {
+            result = std::min(result, area(static_cast<double>(i) / samples, constantArea));
+        }
+        return result;
+    }
+    case SectionKind::Constant:
+    default:
+        return constantArea;
+    }
+}
+
+namespace {
+
+// Узлы и веса 5-точечной формулы Гаусса — Лежандра на [-1, 1]
+constexpr double GaussNodes[5] = {
+    -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640 };
+constexpr double GaussWeights[5] = {
+    0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+struct Integrand {
+    const SectionProfile& profile;
+    double E;
+    double constantArea;
+    double L;
+    const LoadDistribution& loads;
+
+    SectionIntegrals gauss(double a, double b) const
+    {
+        SectionIntegrals sum;
+        double half = 0.5 * (b - a);
+        double mid = 0.5 * (a + b);
+        for (int k = 0; k < 5; ++k) {
+            double x = mid + half * GaussNodes[k];
+            double A = profile.area(x / L, constantArea);
+            if (!(A > 0.0)) {
+                throw std::runtime_error("Section area must be positive");
+            }
+            double w = GaussWeights[k] * half / (E * A);
+            sum.flexibility += w;
+            sum.loadIntegral += w * loads.resultant(x);
+        }
+        return sum;
+    }
+};
+
+SectionIntegrals adaptive(const Integrand& f, double a, double b,
+    const SectionIntegrals& whole, double tolerance, int depth)
+{
+    double mid = 0.5 * (a + b);
+    SectionIntegrals left = f.gauss(a, mid);
+    SectionIntegrals right = f.gauss(mid, b);
+    SectionIntegrals halves{ left.flexibility + right.flexibility, left.loadIntegral + right.loadIntegral };
+
+    bool converged = std::abs(halves.flexibility - whole.flexibility) <= tolerance * std::abs(halves.flexibility) &&
+        std::abs(halves.loadIntegral - whole.loadIntegral) <= tolerance * std::abs(halves.loadIntegral) + 1e-300;
+    if (depth == 0 || converged) {
+        return halves;
+    }
+    SectionIntegrals l = adaptive(f, a, mid, left, tolerance, depth - 1);
+    SectionIntegrals r = adaptive(f, mid, b, right, tolerance, depth - 1);
+    return { l.flexibility + r.flexibility, l.loadIntegral + r.loadIntegral };
+}
+
+} // namespace
+
+SectionIntegrals integrateSection(const SectionProfile& profile, double E, double constantArea,
+    double L, const LoadDistribution& loads, double x0, double x1, double tolerance)
+{
+    const Integrand f{ profile, E, constantArea, L, loads };
+
+    // Границы участков: концы, точки таблицы и концы нагрузок внутри [x0, x1]
+    std::vector<double> breaks{ x0 };
+    auto addBreak = [&](double x) {
+        if (x > x0 && x < x1) breaks.push_back(x);
+    };
+    if (profile.kind == SectionKind::Table) {
+        for (double xi : profile.points) addBreak(xi * L);
+    }
+    if (loads.segments) {
+        for (const LineLoad& load : *loads.segments) {
+            addBreak(load.start);
+            addBreak(load.end);
+        }
+    }
+    if (loads.points) {
+        for (const PointLoad& load : *loads.points) addBreak(load.position);
+    }
+    std::sort(breaks.begin(), breaks.end());
+    breaks.push_back(x1);
+
+    SectionIntegrals total;
+    for (size_t k = 0; k + 1 < breaks.size(); ++k) {
+        double a = breaks[k];
+        double b = breaks[k + 1];
+        if (b <= a) continue;
+        SectionIntegrals part = adaptive(f, a, b, f.gauss(a, b), tolerance, 20);
+        total.flexibility += part.flexibility;
+        total.loadIntegral += part.loadIntegral;
+    }
+    return total;
+}
+
+SectionMassMoments sectionMassMoments(const SectionProfile& profile, double constantArea)
+{
+    std::vector<double> breaks{ 0.0 };
+    if (profile.kind == SectionKind::Table) {
+        for (double xi : profile.points) {
+            if (xi > 0.0 && xi < 1.0) breaks.push_back(xi);
+        }
+    }
+    breaks.push_back(1.0);
+
+    SectionMassMoments moments;
+    for (size_t k = 0; k + 1 < breaks.size(); ++k) {
+        double half = 0.5 * (breaks[k + 1] - breaks[k]);
+        double mid = 0.5 * (breaks[k + 1] + breaks[k]);
+        if (half <= 0.0) continue;
+        for (int g = 0; g < 5; ++g) {
+            double xi = mid + half * GaussNodes[g];
+            double w = GaussWeights[g] * half * profile.area(xi, constantArea);
+            moments.left += w * (1.0 - xi) * (1.0 - xi);
+            moments.coupled += w * xi * (1.0 - xi);
+            moments.right += w * xi * xi;
+        }
+    }
+    return moments;
+}
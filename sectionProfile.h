@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "lineLoad.h"
+
+// Закон изменения площади сечения по длине стержня, ξ = x / L
+enum class SectionKind {
+    Constant,     // A = selectArea_A стержня
+    Linear,       // values = { A слева, A справа }
+    Polynomial,   // A(ξ) = values[0] + values[1]·ξ + values[2]·ξ² + ...
+    Table         // кусочно-линейная по точкам: points — ξ по возрастанию от 0 до 1, values — A в них
+};
+
+struct SectionProfile {
+    SectionKind kind = SectionKind::Constant;
+    std::vector<double> values;
+    std::vector<double> points;
+
+    bool isConstant() const { return kind == SectionKind::Constant; }
+    // Данных хватает для area(): у линейного два значения, у многочлена хотя бы
+    // одно, у таблицы не меньше двух пар с ξ по возрастанию в [0, 1]
+    bool isValid() const;
+    double area(double xi, double constantArea) const;
+    // Наименьшая площадь по длине; у многочлена — по 129 точкам
+    double minArea(double constantArea) const;
+};
+
+// Интегралы податливости участка [x0, x1] стержня длины L:
+//   flexibility = ∫ dx / (E·A(x)),  loadIntegral = ∫ Q(x) dx / (E·A(x)),
+// Q — равнодействующая распределенной нагрузки от 0 до x,
+// x отсчитывается от левого конца
+struct SectionIntegrals {
+    double flexibility = 0.0;
+    double loadIntegral = 0.0;
+};
+
+// Адаптивная квадратура Гаусса: участок делится пополам, пока 5-точечная
+// формула на нем не совпадет с суммой по половинам; изломы таблицы и
+// концы участков нагрузки и точки сил становятся границами, и на гладких кусках
+// сходимость быстрая
+SectionIntegrals integrateSection(const SectionProfile& profile, double E, double constantArea,
+    double L, const LoadDistribution& loads, double x0, double x1, double tolerance = 1e-12);
+
+// Моменты площади для матрицы масс по ξ ∈ [0, 1]:
+//   left = ∫ A·(1-ξ)² dξ,  coupled = ∫ A·ξ(1-ξ) dξ,  right = ∫ A·ξ² dξ.
+// Формула Гаусса на кусках таблицы точна; для многочлена — до 7-й степени
+struct SectionMassMoments {
+    double left = 0.0;
+    double coupled = 0.0;
+    double right = 0.0;
+};
+
+SectionMassMoments sectionMassMoments(const SectionProfile& profile, double constantArea);
@@ -0,0 +1,153 @@
+#include "sensitivitySolver.h"
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+SensitivityAnalysis::SensitivityAnalysis(const SparseMatrix& K, const std::vector<double>& B,
+    const std::vector<SensitivityBar>& bars, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, SkylineCholesky& factor, std::vector<int>& perm)
+    : m_K(K), m_bars(bars), m_fixed(fixed), m_factor(factor)
+{
+    const int n = K.n;
+    if (static_cast<int>(B.size()) != n) {
+        throw std::runtime_error("Load vector size does not match the stiffness matrix");
+    }
+
+    // Заданные перемещения — в правую часть, строки и столбцы опор — единичные
+    SparseMatrix reduced = K;
+    std::vector<double> F = B;
+    for (int i = 0; i < n; ++i) {
+        for (int k = reduced.rowPtr[i]; k < reduced.rowPtr[i + 1]; ++k) {
+            int j = reduced.colIdx[k];
+            if (!fixed[i] && fixed[j]) {
+                F[i] -= reduced.values[k] * prescribed[j];
+            }
+            if (fixed[i] || fixed[j]) {
+                reduced.values[k] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (fixed[i]) F[i] = prescribed[i];
+    }
+
+    if (static_cast<int>(perm.size()) != n) {
+        perm = reverseCuthillMcKee(reduced);
+    }
+    m_factor.factorize(reduced, perm);
+    m_factor.solve(F, m_u);
+}
+
+SensitivityResult SensitivityAnalysis::gradient(const SensitivityResponse& response)
+{
+    const int n = m_K.n;
+    const int numBars = static_cast<int>(m_bars.size());
+    SensitivityResult result;
+    result.response = response;
+
+    // Отклик R(u, p) = gᵀu + явная часть; g — его производная по перемещениям
+    std::vector<double> g(n, 0.0);
+    int stressBar = -1;
+    BarDerivative scale;   // для напряжения: множители при dk, dF_left, dF_right, dA конца
+    if (response.kind == ResponseKind::Displacement) {
+        if (response.index < 0 || response.index >= n) {
+            throw std::runtime_error("Response node is out of range");
+        }
+        result.value = m_u[response.index];
+        g[response.index] = 1.0;
+    }
+    else {
+        if (response.index < 0 || response.index >= numBars) {
+            throw std::runtime_error("Response bar is out of range");
+        }
+        stressBar = response.index;
+        const SensitivityBar& bar = m_bars[stressBar];
+        double elongation = m_u[bar.nodeRight] - m_u[bar.nodeLeft];
+        double left = (bar.stiffness * elongation + bar.loadLeft) / bar.areaLeft;
+        double right = (bar.stiffness * elongation - bar.loadRight) / bar.areaRight;
+        result.end = std::abs(right) > std::abs(left) ? 1 : 0;
+        double area = result.end ? bar.areaRight : bar.areaLeft;
+        result.value = result.end ? right : left;
+        g[bar.nodeLeft] -= bar.stiffness / area;
+        g[bar.nodeRight] += bar.stiffness / area;
+        // ∂σ/∂p = (dk·Δ + dF_left) / A - σ·dA / A  (на правом конце -dF_right)
+        scale = { elongation / area, result.end ? 0.0 : 1.0 / area,
+            result.end ? -1.0 / area : 0.0, -result.value / area };
+    }
+
+    // Сопряженная задача: у опорных узлов ψ = 0
+    std::vector<double> rhs(g), psi;
+    for (int i = 0; i < n; ++i) {
+        if (m_fixed[i]) rhs[i] = 0.0;
+    }
+    m_factor.solve(rhs, psi);
+    m_backSubstitutions++;
+    for (int i = 0; i < n; ++i) {
+        if (m_fixed[i]) psi[i] = 0.0;
+    }
+
+    // dF - dK·u для стержня: (dF_left + dk·Δ) в левом узле, (dF_right - dk·Δ) в правом
+    result.bars.resize(numBars);
+    for (int b = 0; b < numBars; ++b) {
+        const SensitivityBar& bar = m_bars[b];
+        double elongation = m_u[bar.nodeRight] - m_u[bar.nodeLeft];
+        for (int p = 0; p < BarParameterCount; ++p) {
+            const BarDerivative& d = bar.derivatives[p];
+            double value = psi[bar.nodeLeft] * (d.loadLeft + d.stiffness * elongation)
+                + psi[bar.nodeRight] * (d.loadRight - d.stiffness * elongation);
+            if (b == stressBar) {
+                value += scale.stiffness * d.stiffness + scale.loadLeft * d.loadLeft
+                    + scale.loadRight * d.loadRight + scale.area * d.area;
+            }
+            result.bars[b][p] = value;
+        }
+    }
+
+    // Узловые силы входят в F напрямую; заданное перемещение опоры u_j
+    // переносит -K_ij·u_j в правые части свободных строк
+    result.loads = psi;
+    result.settlements.assign(n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        if (m_fixed[j]) result.settlements[j] = g[j];
+    }
+    for (int i = 0; i < n; ++i) {
+        if (m_fixed[i]) continue;
+        for (int k = m_K.rowPtr[i]; k < m_K.rowPtr[i + 1]; ++k) {
+            int j = m_K.colIdx[k];
+            if (m_fixed[j]) result.settlements[j] -= psi[i] * m_K.values[k];
+        }
+    }
+    return result;
+}
+
+void writeSensitivityCsv(const std::string& fileName, const SensitivityResult& result)
+{
+    std::ofstream file(fileName);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open sensitivity file " + fileName);
+    }
+    static const char* const parameters[BarParameterCount] = { "E", "A", "L", "eps_T" };
+
+    file << std::setprecision(12);
+    file << "object,index,parameter,value\n";
+    if (result.response.kind == ResponseKind::Displacement) {
+        file << "response," << result.response.index << ",u," << result.value << "\n";
+    }
+    else {
+        file << "response," << result.response.index + 1 << ","
+            << (result.end ? "sigma_right" : "sigma_left") << "," << result.value << "\n";
+    }
+    for (size_t b = 0; b < result.bars.size(); ++b) {
+        for (int p = 0; p < BarParameterCount; ++p) {
+            file << "bar," << b + 1 << "," << parameters[p] << "," << result.bars[b][p] << "\n";
+        }
+    }
+    for (size_t i = 0; i < result.loads.size(); ++i) {
+        file << "node," << i << ",F," << result.loads[i] << "\n";
+        file << "node," << i << ",settlement," << result.settlements[i] << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write sensitivity file " + fileName);
+    }
+}
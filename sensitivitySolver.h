@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include "sparseSolver.h"
+
+// Параметры стержня, по которым считаются производные отклика
+enum class BarParameter { Modulus, Area, Length, FreeStrain };
+constexpr int BarParameterCount = 4;
+
+// Производные вклада стержня по одному параметру: жесткости k,
+// эквивалентных нагрузок концов и площадей концов
+struct BarDerivative {
+    double stiffness = 0.0;
+    double loadLeft = 0.0;
+    double loadRight = 0.0;
+    double area = 0.0;
+};
+
+// Стержень линейного расчета. loadLeft/loadRight — эквивалентные нагрузки,
+// как вошли в B: N(0) = k·Δ + loadLeft, N(L) = k·Δ - loadRight
+struct SensitivityBar {
+    int nodeLeft;
+    int nodeRight;
+    double stiffness;
+    double loadLeft;
+    double loadRight;
+    double areaLeft;      // площади концов для σ = N / A
+    double areaRight;
+    std::array<BarDerivative, BarParameterCount> derivatives;   // по BarParameter
+};
+
+enum class ResponseKind {
+    Displacement,   // перемещение узла
+    Stress          // σ на более нагруженном конце стержня
+};
+
+struct SensitivityResponse {
+    ResponseKind kind;
+    int index;            // узел или стержень, с 0
+};
+
+struct SensitivityResult {
+    SensitivityResponse response;
+    double value = 0.0;
+    int end = 0;          // для напряжения: 0 — левый конец, 1 — правый
+    std::vector<std::array<double, BarParameterCount>> bars;   // dR/dp по стержням
+    std::vector<double> loads;        // dR/dF по узлам; сила в опорном узле уходит в реакцию — 0
+    std::vector<double> settlements;  // dR/d(заданное перемещение) по опорным узлам, у прочих 0
+};
+
+// Линейный расчет K u = F с производными откликов. Разложение K — одно, в
+// конструкторе; производные одного отклика по всем параметрам стержней и по
+// всем нагрузкам — одним сопряженным решением K ψ = ∂R/∂u:
+//   dR/dp = ∂R/∂p + ψᵀ (dF/dp - dK/dp · u).
+// K и B — как собраны, до учета опор; factor и perm — буферы рабочего места
+// прямого решателя, perm пересчитывается, если не подходит по размеру
+class SensitivityAnalysis {
+public:
+    SensitivityAnalysis(const SparseMatrix& K, const std::vector<double>& B,
+        const std::vector<SensitivityBar>& bars, const std::vector<char>& fixed,
+        const std::vector<double>& prescribed, SkylineCholesky& factor, std::vector<int>& perm);
+
+    const std::vector<double>& displacements() const { return m_u; }
+    int backSubstitutions() const { return m_backSubstitutions; }
+
+    SensitivityResult gradient(const SensitivityResponse& response);
+
+private:
+    const SparseMatrix& m_K;
+    const std::vector<SensitivityBar>& m_bars;
+    const std::vector<char>& m_fixed;
+    SkylineCholesky& m_factor;
+    std::vector<double> m_u;
+    int m_backSubstitutions = 0;
+};
+
+// Производные в CSV: строки object,index,parameter,value. Первая строка —
+// сам отклик, далее стержни (с 1) по E, A, L, eps_T и узлы по F и settlement
+void writeSensitivityCsv(const std::string& fileName, const SensitivityResult& result);
@@ -1,967 +1,1417 @@
-#include "setOfElements.h"
-
-const qreal ConnectionManager::SNAP_DISTANCE = 15.0;
-const qreal ConnectionManager::SNAP_DISTANCE_SQUARED = SNAP_DISTANCE * SNAP_DISTANCE;
-
-
-
-// ---------- Балка ----------
-BeamItem::BeamItem(qreal x1, qreal y1, qreal length, qreal width)
-    : QGraphicsRectItem(0, 0, length, width), _ox(x1), _oy(y1), _len(length), _width(width)
-{
-    setBrush(QBrush(Qt::white));
-    setPen(QPen(Qt::black, 2));
-    setPos(x1, y1 - width / 2);  // 
-
-    // точки соединения
-    pointConnect_left = PointConnector(0, width / 2);
-    pointConnect_right = PointConnector(length, width / 2);
-
-    updateGreenPoints();
-
-    setFlag(QGraphicsItem::ItemIsMovable);
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-}
-
-QGraphicsEllipseItem* BeamItem::createGreenPoint(const PointConnector& pc)
-{
-    const qreal radius = 4.0;
-    QGraphicsEllipseItem* ellipse = new QGraphicsEllipseItem(
-        pc.o_x - radius, pc.o_y - radius,
-        radius * 2, radius * 2,
-        this
-    );
-    ellipse->setBrush(Qt::green);
-    ellipse->setPen(Qt::NoPen);
-    return ellipse;
-}
-
-void BeamItem::updateGreenPoints()
-{
-    // Удаление старых точек
-    if (leftPoint) {
-        delete leftPoint;
-        leftPoint = nullptr;
-    }
-    if (rightPoint) {
-        delete rightPoint;
-        rightPoint = nullptr;
-    }
-
-    // Создаем новые
-    leftPoint = createGreenPoint(pointConnect_left);
-    rightPoint = createGreenPoint(pointConnect_right);
-}
-
-PointConnector BeamItem::getLeftConnector() const {
-    QPointF scenePos = mapToScene(QPointF(0, _width / 2));
-    return PointConnector(scenePos.x(), scenePos.y());
-}
-
-PointConnector BeamItem::getRightConnector() const {
-    QPointF scenePos = mapToScene(QPointF(_len, _width / 2));
-    return PointConnector(scenePos.x(), scenePos.y());
-}
-
-void BeamItem::setConnectedTo(QGraphicsItem* other) {
-    if (other == this || !other || m_beingDestroyed) return;
-
-    connectedTo = other;
-    setBrush(QBrush(QColor(200, 255, 200)));
-    setFlag(QGraphicsItem::ItemIsMovable, false);
-
-    QTimer::singleShot(200, [this]() {
-        if (this && this->scene() && !m_beingDestroyed) {
-            setBrush(QBrush(Qt::white));
-        }
-        });
-}
-
-void BeamItem::disconnect() {
-    if (m_beingDestroyed || !connectedTo) {
-        return; // Защита от повторного вызова
-    }
-
-    QGraphicsItem* oldConnected = connectedTo;
-    connectedTo = nullptr; // Сначала разрываем связь у себя
-
-    // Безопасное отключение партнера
-    if (oldConnected) {
-        // Проверяем, что объект все еще существует в сцене
-        if (scene() && scene()->items().contains(oldConnected)) {
-            if (auto beam = dynamic_cast<BeamItem*>(oldConnected)) {
-                if (beam->connectedTo == this && !beam->m_beingDestroyed) {
-                    beam->connectedTo = nullptr;
-                    beam->setFlag(QGraphicsItem::ItemIsMovable, true);
-                    beam->setBrush(QBrush(Qt::white));
-                }
-            }
-            else if (auto support = dynamic_cast<FixedSupportItem*>(oldConnected)) {
-                if (support->connectedTo == this && !support->isBeingDestroyed()) {
-                    support->connectedTo = nullptr;
-                    support->setFlag(QGraphicsItem::ItemIsMovable, true);
-                }
-            }
-        }
-    }
-
-    setFlag(QGraphicsItem::ItemIsMovable, true);
-    setBrush(QBrush(Qt::white));
-
-    // Безопасное смещение только если объект еще в сцене
-    if (scene() && scene()->items().contains(this)) {
-        setPos(pos() + QPointF(20, 0));
-    }
-}
-
-void BeamItem::safeDelete() {
-    if (m_beingDestroyed) return;
-
-    m_beingDestroyed = true;
-    disconnect(); // Сначала отсоединяемся
-
-    // Для QGraphicsItem используем отложенное удаление через QTimer
-    if (scene()) {
-        scene()->removeItem(this);
-
-        // Используем QTimer для отложенного удаления
-        QTimer::singleShot(0, [this]() {
-            delete this;
-            });
-    }
-    else {
-        delete this; // Если не в сцене, удаляем сразу
-    }
-}
-
-void BeamItem::set_Length(qreal newLength)
-{
-    if (qFuzzyCompare(_len, newLength) || m_beingDestroyed) return;
-
-    QGraphicsItem* oldConnection = connectedTo;
-    LenBeam = qrealToMeters(newLength);
-    _len = newLength;
-    setRect(0, 0, newLength, _width);
-    pointConnect_right = PointConnector(newLength, _width / 2);
-
-    updateGreenPoints();
-    connectedTo = oldConnection;
-}
-
-void BeamItem::setInfo(double _cross_sectArea_A, double _mod_Elasticity_E, double _maxStressBeam_q)
-{
-    cross_sectArea_A = _cross_sectArea_A;
-    mod_Elasticity_E = _mod_Elasticity_E;
-    maxStressBeam_q = _maxStressBeam_q;
-}
-std::tuple<double, double, double, double> BeamItem::getInfo() {
-    return { _len ,cross_sectArea_A,mod_Elasticity_E, maxStressBeam_q };
-}
-PointConnector BeamItem::getPointConnector() const
-{
-    QPointF scenePos = mapToScene(QPointF(_len, _width / 2));
-    return PointConnector(scenePos.x(), scenePos.y());
-}
-
-void BeamItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
-{
-    if (m_beingDestroyed) return;
-    QGraphicsRectItem::mousePressEvent(event);
-    setSelected(true);
-}
-
-void BeamItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
-    if (m_beingDestroyed) return;
-
-    QMenu menu;
-    QAction* detachAction = menu.addAction(connectedTo ? "Отсоединить (соединен)" : "Отсоединить (не соединен)");
-    QAction* editAction = menu.addAction("Изменить");
-    QAction* deleteAction = menu.addAction("Удалить");
-
-    QAction* chosen = menu.exec(event->screenPos());
-
-    if (!chosen || m_beingDestroyed) return; // Дополнительная проверка
-
-    if (chosen == detachAction) {
-        disconnect();
-    }
-    else if (chosen == editAction) {
-        // Логика редактирования
-    }
-    else if (chosen == deleteAction) {
-        safeDelete();
-    }
-}
-
-// ---------- ЗАДЕЛКА ----------
-FixedSupportItem::FixedSupportItem(qreal x, qreal y, qreal height, ElementDirection dir) : el_d(dir), _ox(x), _oy(y)
-{
-    const QPen pen(Qt::black, 2);
-    QPainterPath path;
-
-    path.moveTo(0, 0);
-    path.lineTo(0, height);
-
-    qreal spacing = 5;
-    qreal diagLen = 12;
-    int count = static_cast<int>(height / spacing);
-
-    for (int i = 0; i < count; ++i) {
-        qreal yPos = i * spacing;
-        path.moveTo(0, yPos);
-        if (dir == ElementDirection::Left) {
-            path.lineTo(-diagLen, yPos + spacing / 2);
-        }
-        else if (dir == ElementDirection::Right) {
-            path.lineTo(diagLen, yPos - spacing / 2);
-        }
-    }
-
-    auto* hatch = new QGraphicsPathItem(path);
-    hatch->setPen(pen);
-    addToGroup(hatch);
-
-    setPos(x, y);
-    pointConnect = PointConnector(0, height / 2);
-
-    // Создаем зеленую точку
-    const qreal radius = 4.0;
-    auto ellipse = new QGraphicsEllipseItem(
-        pointConnect.o_x - radius, pointConnect.o_y - radius,
-        radius * 2, radius * 2, this
-    );
-    ellipse->setBrush(Qt::green);
-    ellipse->setPen(Qt::NoPen);
-
-    setFlag(QGraphicsItem::ItemIsMovable);
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-}
-
-PointConnector FixedSupportItem::getPointConnector() const
-{
-    QPointF scenePos = mapToScene(QPointF(pointConnect.o_x, pointConnect.o_y));
-    return PointConnector(scenePos.x(), scenePos.y());
-}
-
-void FixedSupportItem::setConnectedTo(BeamItem* other) {
-    if (!other || m_beingDestroyed) return;
-
-    connectedTo = other;
-
-    for (auto item : childItems()) {
-        if (auto pathItem = dynamic_cast<QGraphicsPathItem*>(item)) {
-            pathItem->setBrush(QBrush(QColor(200, 255, 200)));
-        }
-    }
-
-    QTimer::singleShot(200, [this]() {
-        if (this && this->scene() && !m_beingDestroyed) {
-            for (auto item : childItems()) {
-                if (auto pathItem = dynamic_cast<QGraphicsPathItem*>(item)) {
-                    pathItem->setBrush(QBrush());
-                }
-            }
-        }
-        });
-}
-
-void FixedSupportItem::disconnect() {
-    if (m_beingDestroyed || !connectedTo) {
-        return;
-    }
-
-    BeamItem* oldConnected = connectedTo;
-    connectedTo = nullptr;
-
-    if (oldConnected) {
-        // Проверяем, что объект все еще существует в сцене
-        if (scene() && scene()->items().contains(oldConnected)) {
-            if (oldConnected->connectedTo == this && !oldConnected->isBeingDestroyed()) {
-                oldConnected->connectedTo = nullptr;
-                oldConnected->setFlag(QGraphicsItem::ItemIsMovable, true);
-                oldConnected->setBrush(QBrush(Qt::white));
-            }
-        }
-    }
-
-    setFlag(QGraphicsItem::ItemIsMovable, true);
-
-    if (scene() && scene()->items().contains(this)) {
-        setPos(pos() + QPointF(20, 0));
-    }
-}
-
-void FixedSupportItem::safeDelete() {
-    if (m_beingDestroyed) return;
-
-    m_beingDestroyed = true;
-
- 
-    disconnect();
-
-    if (scene()) {
-        scene()->removeItem(this);
-
-        // Используем QTimer для отложенного удаления
-        QTimer::singleShot(0, [this]() {
-            delete this;
-            });
-
-    }
-    else {
-        delete this;
-    }
-    emit supportDeleted(el_d);
-}
-
-void FixedSupportItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
-{
-    if (m_beingDestroyed) return;
-    QGraphicsItemGroup::mousePressEvent(event);
-}
-
-void FixedSupportItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
-    if (m_beingDestroyed) return;
-
-    QMenu menu;
-    QAction* detachAction = menu.addAction(connectedTo ? "Отсоединить от балки" : "Отсоединить (не соединена)");
- //   QAction* editAction = menu.addAction("Изменить");
-    QAction* deleteAction = menu.addAction("Удалить");
-
-    detachAction->setEnabled(connectedTo != nullptr);
-
-    QAction* chosen = menu.exec(event->screenPos());
-
-    if (!chosen || m_beingDestroyed) return;
-
-    if (chosen == detachAction && connectedTo) {
-        disconnect();
-    }
-    else if (chosen == deleteAction) {
-        safeDelete();
-    }
-}
-
-QVariant FixedSupportItem::itemChange(GraphicsItemChange change, const QVariant& value)
-{
-    if (change == ItemPositionHasChanged) {
-        QPointF newPos = value.toPointF();
-        _ox = newPos.x();
-        _oy = newPos.y();
-    }
-    return QGraphicsItemGroup::itemChange(change, value);
-}
-
-// ---------- СИЛА ----------
-ForceItem::ForceItem(qreal x, qreal y, ElementDirection dir,
-    qreal length, const QPen& pen)
-    : el_d(dir), _ox(x), _oy(y), arrowLength(length), m_pen(pen)
-{
-    // изначально сила на начале балки
-    len_fr_beam = 0;
-
-    // позиционируем в сцене: смещение от начала балки
-    setPos(_ox + len_fr_beam, _oy);
-
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-    
-    setZValue(10);
-}
-
-PointConnector ForceItem::getPointConnector() const
-{
-    return PointConnector(_ox, _oy);
-}
-
-void ForceItem::set_Len_fr_beam(qreal newLength) {
-    len_fr_beam = newLength;
-    // позиция в сцене — только через setPos, локальная геометрия не меняется
-    setPos(_ox + len_fr_beam, _oy);
-}
-
-void ForceItem::changeDirection(ElementDirection dir)
-{
-    if (el_d == dir) return;
-    el_d = dir;
-    // просто перерисовываем локальную геометрию, позиция не трогается
-    update();
-}
-
-void ForceItem::setForce_H(qreal force_digital, int pos_beam)
-{
-    force_H = force_digital;
-    force_pos_beam = pos_beam;
-
-    update();
-}
-
-std::tuple<qreal, qreal, int> ForceItem::getInfo()
-{
-    return std::make_tuple(len_fr_beam, force_H, force_pos_beam);
-}
-
-QRectF ForceItem::boundingRect() const
-{
-    // Даем запас по рамке, чтобы поместилась стрелка и текст
-    // Симметрично относительно локального (0,0)
-    qreal margin = 20.0;
-    return QRectF(-arrowLength - margin, -margin,
-        2 * arrowLength + 2 * margin, 2 * margin);
-}
-
-void ForceItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
-{
-    painter->setPen(m_pen);
-    painter->setBrush(Qt::NoBrush);
-
-    const qreal dx = (el_d == ElementDirection::Right ? arrowLength : -arrowLength);
-
-    // линия
-    painter->drawLine(0, 0, dx, 0);
-
-    // стрелка
-    const qreal head = 10.0;
-    if (el_d == ElementDirection::Right) {
-        QPolygonF arrowHead;
-        arrowHead << QPointF(dx, 0)
-            << QPointF(dx - head, -head / 2)
-            << QPointF(dx - head, head / 2);
-        painter->drawPolygon(arrowHead);
-    }
-    else {
-        QPolygonF arrowHead;
-        arrowHead << QPointF(dx, 0)
-            << QPointF(dx + head, -head / 2)
-            << QPointF(dx + head, head / 2);
-        painter->drawPolygon(arrowHead);
-    }
-
-    // текст "F"
-    painter->setPen(m_pen.color());
-    const QPointF textPos = (el_d == ElementDirection::Right)
-        ? QPointF(dx / 2 - 5, -10)
-        : QPointF(dx / 2 - 5, 15);
-
-    QString tmp = QString("%1 (H) F").arg(force_H);
-    painter->drawText(textPos, tmp);
-}
-
-void ForceItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
-{
-    QGraphicsItem::mousePressEvent(event);
-}
-
-void ForceItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
-    QMenu menu;
-    QAction* detachAction = menu.addAction("Отсоединить");
-    QAction* editAction = menu.addAction("Изменить");
-    QAction* deleteAction = menu.addAction("Удалить");
-
-    QAction* chosen = menu.exec(event->screenPos());
-    if (chosen == deleteAction) {
-        if (scene()) {
-            scene()->removeItem(this);
-            // Для ForceItem используем прямое удаление
-            delete this;
-        }
-        else {
-            delete this;
-        }
-    }
-}
-
-LineLoadItem::LineLoadItem(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2,
-    ElementDirection dir, const QPen& pen)
-    : m_pen(pen), el_d(dir)
-{
-    q_line_load = 0;
-
-    // локальные координаты: начало всегда (0,0)
-    start_x1 = 0;
-    stop_y1 = 0;
-    start_x2 = ox_2 - ox_1;
-    stop_y2 = oy_2 - oy_1;
-
-    // глобальное смещение
-    setPos(ox_1, oy_1);
-
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-    setZValue(10);
-}
-
-std::tuple<qreal, int> LineLoadItem::getInfo() {
-
-    return std::make_tuple(q_line_load, _beamDig);
-}
-
-PointConnector LineLoadItem::getPointConnector() const
-{
-    return PointConnector();
-}
-
-void LineLoadItem::change_loc_joins(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2)
-{
-    prepareGeometryChange();
-
-    setPos(ox_1, oy_1);
-
-    start_x1 = 0;
-    stop_y1 = 0;
-    start_x2 = ox_2 - ox_1;
-    stop_y2 = oy_2 - oy_1;
-
-    
-    update();
-}
-
-void LineLoadItem::set_LineLoad(qreal q_l_load, int beamD) {
-    _beamDig = beamD;
-    q_line_load = q_l_load;
-}
-
-void LineLoadItem::change_direction(ElementDirection direction)
-{
-    el_d = direction;
-
-    update();
-}
-
-QRectF LineLoadItem::boundingRect() const
-{
-    qreal minX = std::min(start_x1, start_x2);
-    qreal maxX = std::max(start_x1, start_x2);
-    qreal minY = std::min(stop_y1, stop_y2);
-    qreal maxY = std::max(stop_y1, stop_y2);
-
-    // запас под стрелочные головки
-    const qreal headX = 10.0;
-    const qreal headY = 6.0;
-    const qreal margin = 4.0;
-
-    QString tmp = QString("%1 (H/М) q").arg(q_line_load);
-
-    // Примерная ширина символа ~8px, высота текста ~15px
-    qreal textWidth = tmp.length() * 8.0;
-    qreal textHeight = 15.0;
-
-    // Позиция текста
-    qreal textX = (start_x1 + start_x2) / 2 - 5;
-    qreal textY = -10;
-
-    // Расширяем границы с учетом текста
-    qreal finalMinX = std::min(minX - headX - margin, textX - margin);
-    qreal finalMaxX = std::max(maxX + headX + margin, textX + textWidth + margin);
-    qreal finalMinY = std::min(minY - headY - margin, textY - textHeight - margin);
-    qreal finalMaxY = std::max(maxY + headY + margin, textY + margin);
-
-    return QRectF(finalMinX, finalMinY,
-        finalMaxX - finalMinX,
-        finalMaxY - finalMinY);
-}
-
-void LineLoadItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
-{
-    painter->setPen(m_pen);
-    painter->setBrush(Qt::NoBrush);
-
-    // основная линия
-    painter->drawLine(start_x1, stop_y1, start_x2, stop_y2);
-
-    qreal len = start_x2 - start_x1;
-    if (qFuzzyIsNull(len)) return;
-
-    const qreal step = 20.0;
-    const qreal headX = 8.0;
-    const qreal headY = 4.0;
-
-    if (el_d == ElementDirection::Right) {
-        // Стрелки вправо - острие справа
-        for (qreal x = start_x1 + step; x <= start_x2; x += step) {
-            qreal y = stop_y1 + (stop_y2 - stop_y1) * (x - start_x1) / len;
-
-            QPolygonF arrowHead;
-            arrowHead << QPointF(x, y)              // острие стрелки
-                << QPointF(x - headX, y - headY)    // верх хвоста
-                << QPointF(x - headX, y + headY);   // низ хвоста
-
-            painter->setBrush(QBrush(m_pen.color()));
-            painter->drawPolygon(arrowHead);
-            painter->setBrush(Qt::NoBrush);
-        }
-    }
-    else { // Left
-        // Стрелки влево - острие СЛЕВА
-        for (qreal x = start_x1 + step; x <= start_x2; x += step) {
-            qreal y = stop_y1 + (stop_y2 - stop_y1) * (x - start_x1) / len;
-
-            QPolygonF arrowHead;
-            arrowHead << QPointF(x - headX, y)      // острие стрелки (слева)
-                << QPointF(x, y - headY)            // верх хвоста (справа)
-                << QPointF(x, y + headY);           // низ хвоста (справа)
-
-            painter->setBrush(QBrush(m_pen.color()));
-            painter->drawPolygon(arrowHead);
-            painter->setBrush(Qt::NoBrush);
-        }
-    }
-
-    painter->setPen(m_pen.color());
-    const QPointF textPos = (el_d == ElementDirection::Right)
-        ? QPointF((start_x1 + start_x2) / 2 - 5, -10)
-        : QPointF((start_x1 + start_x2) / 2 - 5, -10);
-
-    QString tmp = QString("%1 (H/м) q").arg(q_line_load);
-    painter->drawText(textPos, tmp);
-}
-
-
-void LineLoadItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
-{
-    QGraphicsItem::mousePressEvent(event);
-}
-
-void LineLoadItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
-{
-    QMenu menu;
-    QAction* deleteAction = menu.addAction("Удалить");
-
-    QAction* chosen = menu.exec(event->screenPos());
-    if (chosen == deleteAction) {
-        if (scene()) {
-            scene()->removeItem(this);
-            delete this;
-        }
-        else {
-            delete this;
-        }
-    }
-}
-BeamSign::BeamSign(qreal _ox, qreal _oy, int numb, const QPen& pen) :
-    x_pos(_ox), y_pos(_oy), number(numb), _pen(pen)
-{
-
-
-    setPos(x_pos, y_pos);
-
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-    setZValue(10);
-}
-QRectF BeamSign::boundingRect() const
-{
-    return QRectF(-radius, -radius, 2*radius, 2*radius);
-}
-void BeamSign::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
-{
-    painter->setRenderHint(QPainter::Antialiasing, true);
-    painter->setPen(_pen);
-    painter->setBrush(Qt::NoBrush);
-    painter->drawEllipse(boundingRect());
-
-    QFont font = painter->font();
-    font.setPointSize(12);   // размер в пунктах (чем больше, тем крупнее)
-    // font.setPixelSize(20); // альтернатива — фиксированный размер в пикселях
-    font.setBold(true);      // можно сделать жирным
-    painter->setFont(font);
-
-    QString tmp = QString::number(number);
-    painter->drawText(boundingRect(), Qt::AlignCenter, tmp);
-}
-// ---------- ConnectionManager ----------
-std::vector<BeamItem*> ConnectionManager::getBeams(QGraphicsScene* scene)
-{
-    std::vector<BeamItem*> beams;
-    beams.reserve(20); // Резервируем память
-
-    for (auto& item : scene->items()) {
-        if (auto beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) { // Проверяем, что балка не удаляется
-                beams.push_back(beam);
-            }
-        }
-    }
-    return beams;
-}
-void BeamSign::remove() {
-    if (scene()) {
-        scene()->removeItem(this);
-        delete this;
-    }
-}
-void PlotItem::remove() {
-    if (scene()) {
-        scene()->removeItem(this);
-        delete this;
-    }
-}
-void DiagramItem::remove() {
-    if (scene()) {
-        scene()->removeItem(this);
-        delete this;
-    }
-}
-BeamJoint::BeamJoint(qreal _ox, qreal _oy, int numb, const QPen& pen)
-    : x_pos(_ox), y_pos(_oy), number(numb), _pen(pen){
-
-    setPos(x_pos, y_pos);
-
-    setFlag(QGraphicsItem::ItemIsSelectable);
-    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
-    setZValue(10);
-}
-void BeamJoint::remove() {
-    if (scene()) {
-        scene()->removeItem(this);
-        delete this;
-    }
-}
-QRectF BeamJoint::boundingRect() const
-{
-    return QRectF(-square_side, -square_side, square_side, square_side);
-}
-
-void BeamJoint::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
-{
-    painter->setRenderHint(QPainter::Antialiasing, true);
-    painter->setPen(_pen);
-    painter->setBrush(Qt::NoBrush);
-    painter->drawRect(boundingRect());
-
-    QFont font = painter->font();
-    font.setPointSize(12);
-    // font.setPixelSize(20); // альтернатива — фиксированный размер в пикселях
-    font.setBold(true);
-    painter->setFont(font);
-
-    QString tmp = QString::number(number);
-    painter->drawText(boundingRect(), Qt::AlignCenter, tmp);
-}
-
-
-std::vector<FixedSupportItem*> ConnectionManager::getSupports(QGraphicsScene* scene)
-{
-    std::vector<FixedSupportItem*> supports;
-    supports.reserve(10);
-
-    for (auto& item : scene->items()) {
-        if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
-            if (!support->isBeingDestroyed()) { // Проверяем, что заделка не удаляется
-                supports.push_back(support);
-            }
-        }
-    }
-    return supports;
-}
-
-bool ConnectionManager::tryConnectBeams(BeamItem* movable, BeamItem* target)
-{
-    if (!movable || !target || movable == target) return false;
-
-    // Проверяем, что оба объекта еще существуют в сцене
-    if (!movable->scene() || !target->scene()) return false;
-    if (movable->isBeingDestroyed() || target->isBeingDestroyed()) return false;
-
-    PointConnector leftMovable = movable->getLeftConnector();
-    PointConnector rightMovable = movable->getRightConnector();
-    PointConnector leftTarget = target->getLeftConnector();
-    PointConnector rightTarget = target->getRightConnector();
-
-    qreal distance1 = leftMovable.distanceSquaredTo(rightTarget);
-    qreal distance2 = rightMovable.distanceSquaredTo(leftTarget);
-
-    if (distance1 < SNAP_DISTANCE_SQUARED || distance2 < SNAP_DISTANCE_SQUARED) {
-        bool connectLeftToRight = distance1 < distance2;
-
-        QPointF targetPoint = connectLeftToRight ?
-            QPointF(rightTarget.o_x, rightTarget.o_y) :
-            QPointF(leftTarget.o_x, leftTarget.o_y);
-
-        QPointF movablePoint = connectLeftToRight ?
-            QPointF(leftMovable.o_x, leftMovable.o_y) :
-            QPointF(rightMovable.o_x, rightMovable.o_y);
-
-        QPointF offset = targetPoint - movablePoint;
-        movable->setPos(movable->pos() + offset);
-        movable->setFlag(QGraphicsItem::ItemIsMovable, false);
-
-        movable->setConnectedTo(target);
-        target->setConnectedTo(movable);
-
-        return true;
-    }
-    return false;
-}
-
-bool ConnectionManager::tryConnectSupportToBeam(FixedSupportItem* support, BeamItem* beam)
-{
-    if (!support || !beam) return false;
-
-    // Проверяем, что оба объекта еще существуют в сцене
-    if (!support->scene() || !beam->scene()) return false;
-    if (support->isBeingDestroyed() || beam->isBeingDestroyed()) return false;
-
-    PointConnector supportPoint = support->getPointConnector();
-    PointConnector leftTarget = beam->getLeftConnector();
-    PointConnector rightTarget = beam->getRightConnector();
-
-    qreal distance1 = supportPoint.distanceSquaredTo(leftTarget);
-    qreal distance2 = supportPoint.distanceSquaredTo(rightTarget);
-
-    if (distance1 < SNAP_DISTANCE_SQUARED || distance2 < SNAP_DISTANCE_SQUARED) {
-        bool connectToLeft = distance1 < distance2;
-
-        QPointF targetPoint = connectToLeft ?
-            QPointF(leftTarget.o_x, leftTarget.o_y) :
-            QPointF(rightTarget.o_x, rightTarget.o_y);
-
-        QPointF supportScenePos = QPointF(supportPoint.o_x, supportPoint.o_y);
-        QPointF offset = targetPoint - supportScenePos;
-        support->setPos(support->pos() + offset);
-        support->setFlag(QGraphicsItem::ItemIsMovable, false);
-
-        support->setConnectedTo(beam);
-        beam->setConnectedTo(support);
-
-        return true;
-    }
-    return false;
-}
-
-bool ConnectionManager::trySnapItems(QGraphicsScene* scene)
-{
-    if (!scene) return false;
-
-    // Получаем все элементы одним проходом
-    auto allBeams = getBeams(scene);
-    auto allSupports = getSupports(scene);
-
-    // Сначала пытаемся соединить подвижные балки
-    for (auto* movable : allBeams) {
-        if (!(movable->flags() & QGraphicsItem::ItemIsMovable)) continue;
-        if (movable->isBeingDestroyed()) continue;
-
-        for (auto* target : allBeams) {
-            if (target->isBeingDestroyed()) continue;
-            if (tryConnectBeams(movable, target)) {
-                return true;
-            }
-        }
-    }
-
-    // Затем пытаемся соединить подвижные заделки с балками
-    for (auto* support : allSupports) {
-        if (!(support->flags() & QGraphicsItem::ItemIsMovable)) continue;
-        if (support->isBeingDestroyed()) continue;
-
-        for (auto* beam : allBeams) {
-            if (beam->isBeingDestroyed()) continue;
-            if (tryConnectSupportToBeam(support, beam)) {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-bool ConnectionManager::checkAndSnapNewItem(QGraphicsItem* newItem, QGraphicsScene* scene)
-{
-    if (!newItem || !scene) return false;
-
-    bool wasMovable = newItem->flags() & QGraphicsItem::ItemIsMovable;
-    newItem->setFlag(QGraphicsItem::ItemIsMovable, true);
-
-    bool snapped = trySnapItems(scene);
-
-    if (!snapped) {
-        newItem->setFlag(QGraphicsItem::ItemIsMovable, wasMovable);
-    }
-
-    return snapped;
-}
-
-bool PointConnector::operator==(PointConnector p_con)
-{
-    return qFuzzyCompare(o_x, p_con.o_x) && qFuzzyCompare(o_y, p_con.o_y);
-}
-
-void DiagramItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
-{
-    painter->setPen(QPen(Qt::black, 2));
-    painter->setBrush(Qt::NoBrush);
-    painter->drawLine(0, 0, m_beamLength, 0);
-
-    // Рисуем подпись (если есть)
-    if (!m_label.isEmpty())
-    {
-        painter->setPen(Qt::black);
-        QFont font = painter->font();
-        font.setPixelSize(12);
-        font.setBold(true);
-        painter->setFont(font);
-        painter->drawText(QPointF(-22, -5), m_label);
-    }
-
-    // Формируем график по точкам
-    QPolygonF polyline;
-    qreal stepX = m_beamLength / (m_values.size() - 1);
-
-    for (size_t i = 0; i < m_values.size(); i++) {
-        qreal x = i * stepX;
-        qreal y = -m_values[i] * _scaling;
-        polyline << QPointF(x, y);
-    }
-
-    QPolygonF fillPoly = polyline;
-    fillPoly << QPointF(m_beamLength, 0) << QPointF(0, 0);
-
-    painter->setBrush(QBrush(Qt::lightGray));
-    painter->setPen(QPen(Qt::black, 1));
-    painter->drawPolygon(fillPoly);
-
-    painter->setPen(QPen(Qt::blue, 1));
-    painter->drawPolyline(polyline);
-
-
-    const double eps = 1e-9;
-    if (!m_values.empty()) {
-        double leftValue = m_values.front();
-        if (std::abs(leftValue) > eps && showLeftLabel) {  // добавлена проверка
-            painter->setPen(Qt::darkRed);
-            painter->setFont(QFont("Arial", 9, QFont::Bold));
-            painter->drawText(QPointF(0, -leftValue * _scaling - 8),
-                QString::number(leftValue, 'f', 2));
-        }
-
-        double rightValue = m_values.back();
-        if (std::abs(rightValue) > eps && showRightLabel) {  // добавлена проверка
-            qreal xMax = m_beamLength;
-            painter->setPen(Qt::darkRed);
-            painter->setFont(QFont("Arial", 9, QFont::Bold));
-            painter->drawText(QPointF(xMax - 25, -rightValue * _scaling - 8),
-                QString::number(rightValue, 'f', 2));
-        }
-    }
-
-}
-
-void PlotItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
-{
-    painter->setRenderHint(QPainter::Antialiasing, true);
-
-    // Рисуем вертикальную линию
-    QPen linePen(Qt::black, 1);
-    painter->setPen(linePen);
-    painter->drawLine(0, 0, 0, mLineHeight);
-
-    // Рисуем маркер в начале линии (узел)
-    painter->setBrush(QBrush(Qt::black));
-    painter->drawEllipse(QPointF(0, 0), 4, 4);
-
-    
-}
+#include "setOfElements.h"
+
+const qreal ConnectionManager::SNAP_DISTANCE = 15.0;
+const qreal ConnectionManager::SNAP_DISTANCE_SQUARED = SNAP_DISTANCE * SNAP_DISTANCE;
+
+bool RenderDetail::cullSmallDetails = false;
+qreal RenderDetail::minDetailZoom = 0.5;
+
+bool RenderDetail::isCulled(const QPainter* painter)
+{
+    if (!cullSmallDetails) return false;
+    return isCulled(QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()));
+}
+
+
+
+// ---------- Балка ----------
+BeamItem::BeamItem(qreal x1, qreal y1, qreal length, qreal width)
+    : QGraphicsRectItem(0, 0, length, width), _ox(x1), _oy(y1), _len(length), _width(width)
+{
+    setBrush(QBrush(Qt::white));
+    setPen(QPen(Qt::black, 2));
+    setPos(x1, y1 - width / 2);  // 
+
+    // точки соединения
+    pointConnect_left = PointConnector(0, width / 2);
+    pointConnect_right = PointConnector(length, width / 2);
+
+    setFlag(QGraphicsItem::ItemIsMovable);
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+}
+
+QRectF BeamItem::boundingRect() const
+{
+    // точки соединения выступают за прямоугольник на радиус
+    return QGraphicsRectItem::boundingRect().adjusted(-GreenPointRadius, 0, GreenPointRadius, 0);
+}
+
+void BeamItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    QGraphicsRectItem::paint(painter, option, widget);
+
+    if (RenderDetail::isCulled(painter)) return;
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(Qt::green);
+    painter->drawEllipse(QPointF(pointConnect_left.o_x, pointConnect_left.o_y),
+        GreenPointRadius, GreenPointRadius);
+    painter->drawEllipse(QPointF(pointConnect_right.o_x, pointConnect_right.o_y),
+        GreenPointRadius, GreenPointRadius);
+}
+
+PointConnector BeamItem::getLeftConnector() const {
+    QPointF scenePos = mapToScene(QPointF(0, _width / 2));
+    return PointConnector(scenePos.x(), scenePos.y());
+}
+
+PointConnector BeamItem::getRightConnector() const {
+    QPointF scenePos = mapToScene(QPointF(_len, _width / 2));
+    return PointConnector(scenePos.x(), scenePos.y());
+}
+
+void BeamItem::setConnectedTo(QGraphicsItem* other) {
+    if (other == this || !other || m_beingDestroyed) return;
+
+    connectedTo = other;
+    setBrush(QBrush(QColor(200, 255, 200)));
+    setFlag(QGraphicsItem::ItemIsMovable, false);
+
+    QTimer::singleShot(200, [this]() {
+        if (this && this->scene() && !m_beingDestroyed) {
+            setBrush(QBrush(Qt::white));
+        }
+        });
+}
+
+void BeamItem::disconnect() {
+    if (m_beingDestroyed || !connectedTo) {
+        return; // Защита от повторного вызова
+    }
+
+    QGraphicsItem* oldConnected = connectedTo;
+    connectedTo = nullptr; // Сначала разрываем связь у себя
+
+    // Безопасное отключение партнера
+    if (oldConnected) {
+        // Проверяем, что объект все еще существует в сцене
+        if (scene() && scene()->items().contains(oldConnected)) {
+            if (auto beam = dynamic_cast<BeamItem*>(oldConnected)) {
+                if (beam->connectedTo == this && !beam->m_beingDestroyed) {
+                    beam->connectedTo = nullptr;
+                    beam->setFlag(QGraphicsItem::ItemIsMovable, true);
+                    beam->setBrush(QBrush(Qt::white));
+                }
+            }
+            else if (auto support = dynamic_cast<FixedSupportItem*>(oldConnected)) {
+                if (support->connectedTo == this && !support->isBeingDestroyed()) {
+                    support->connectedTo = nullptr;
+                    support->setFlag(QGraphicsItem::ItemIsMovable, true);
+                }
+            }
+        }
+    }
+
+    setFlag(QGraphicsItem::ItemIsMovable, true);
+    setBrush(QBrush(Qt::white));
+
+    // Безопасное смещение только если объект еще в сцене
+    if (scene() && scene()->items().contains(this)) {
+        setPos(pos() + QPointF(20, 0));
+    }
+}
+
+void BeamItem::safeDelete() {
+    if (m_beingDestroyed) return;
+
+    m_beingDestroyed = true;
+    disconnect(); // Сначала отсоединяемся
+
+    // Для QGraphicsItem используем отложенное удаление через QTimer
+    if (scene()) {
+        scene()->removeItem(this);
+
+        // Используем QTimer для отложенного удаления
+        QTimer::singleShot(0, [this]() {
+            delete this;
+            });
+    }
+    else {
+        delete this; // Если не в сцене, удаляем сразу
+    }
+}
+
+void BeamItem::set_Length(qreal newLength)
+{
+    if (qFuzzyCompare(_len, newLength) || m_beingDestroyed) return;
+
+    QGraphicsItem* oldConnection = connectedTo;
+    LenBeam = qrealToMeters(newLength);
+    _len = newLength;
+    setRect(0, 0, newLength, _width);
+    pointConnect_right = PointConnector(newLength, _width / 2);
+
+    connectedTo = oldConnection;
+}
+
+void BeamItem::setInfo(double _cross_sectArea_A, double _mod_Elasticity_E, double _maxStressBeam_q)
+{
+    cross_sectArea_A = _cross_sectArea_A;
+    mod_Elasticity_E = _mod_Elasticity_E;
+    maxStressBeam_q = _maxStressBeam_q;
+}
+std::tuple<double, double, double, double> BeamItem::getInfo() {
+    return { _len ,cross_sectArea_A,mod_Elasticity_E, maxStressBeam_q };
+}
+void BeamItem::setGapRight(double gap)
+{
+    m_gapRight = gap < 0.0 ? -1.0 : gap;
+    updateToolTip();
+}
+
+void BeamItem::setStrainInfo(double thermalExpansion, double deltaT, double initialStrain)
+{
+    m_thermalExpansion = thermalExpansion;
+    m_deltaT = deltaT;
+    m_initialStrain = initialStrain;
+    updateToolTip();
+}
+
+void BeamItem::setSection(const SectionProfile& section)
+{
+    m_section = section;
+    updateToolTip();
+}
+
+void BeamItem::setDensity(double density)
+{
+    m_density = density;
+    updateToolTip();
+}
+
+void BeamItem::setTangentModulus(double modulus)
+{
+    m_tangentModulus = modulus;
+    updateToolTip();
+}
+
+void BeamItem::updateToolTip()
+{
+    QStringList lines;
+    if (!m_section.isConstant()) {
+        lines << QString("Переменное сечение A(x)");
+    }
+    if (m_gapRight >= 0.0) {
+        lines << QString("Зазор справа: %1 м").arg(m_gapRight);
+    }
+    if (m_thermalExpansion != 0.0 && m_deltaT != 0.0) {
+        lines << QString("α = %1 1/°C, ΔT = %2 °C").arg(m_thermalExpansion).arg(m_deltaT);
+    }
+    if (m_initialStrain != 0.0) {
+        lines << QString("ε0 = %1").arg(m_initialStrain);
+    }
+    if (m_density > 0.0) {
+        lines << QString("ρ = %1 кг/м³").arg(m_density);
+    }
+    if (m_tangentModulus > 0.0) {
+        lines << QString("E_t = %1 Па").arg(m_tangentModulus);
+    }
+    setToolTip(lines.join("\n"));
+}
+PointConnector BeamItem::getPointConnector() const
+{
+    QPointF scenePos = mapToScene(QPointF(_len, _width / 2));
+    return PointConnector(scenePos.x(), scenePos.y());
+}
+
+void BeamItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    if (m_beingDestroyed) return;
+    QGraphicsRectItem::mousePressEvent(event);
+    setSelected(true);
+}
+
+void BeamItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
+    if (m_beingDestroyed) return;
+
+    QMenu menu;
+    QAction* detachAction = menu.addAction(connectedTo ? "Отсоединить (соединен)" : "Отсоединить (не соединен)");
+    QAction* editAction = menu.addAction("Изменить");
+    QAction* gapAction = menu.addAction("Зазор справа...");
+    QAction* thermalAction = menu.addAction("Температура...");
+    QAction* strainAction = menu.addAction("Начальная деформация...");
+    QAction* sectionAction = menu.addAction("Переменное сечение...");
+    QAction* densityAction = menu.addAction("Плотность...");
+    QAction* hardeningAction = menu.addAction("Упрочнение после текучести...");
+    QAction* deleteAction = menu.addAction("Удалить");
+
+    QAction* chosen = menu.exec(event->screenPos());
+
+    if (!chosen || m_beingDestroyed) return; // Дополнительная проверка
+
+    if (chosen == detachAction) {
+        disconnect();
+    }
+    else if (chosen == editAction) {
+        // Логика редактирования
+    }
+    else if (chosen == gapAction) {
+        // Отрицательное значение снимает зазор
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Стержень", "Зазор у правого конца, м (< 0 — нет):",
+            m_gapRight, -1.0, 1e6, 6, &ok);
+        if (ok) {
+            setGapRight(value);
+        }
+    }
+    else if (chosen == thermalAction) {
+        bool ok;
+        double alpha = QInputDialog::getDouble(nullptr, "Стержень", "Коэффициент расширения α, 1/°C:",
+            m_thermalExpansion, -1.0, 1.0, 8, &ok);
+        if (!ok) return;
+        double deltaT = QInputDialog::getDouble(nullptr, "Стержень", "Изменение температуры ΔT, °C:",
+            m_deltaT, -1e4, 1e4, 3, &ok);
+        if (ok) {
+            setStrainInfo(alpha, deltaT, m_initialStrain);
+        }
+    }
+    else if (chosen == strainAction) {
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Стержень", "Начальная деформация ε0:",
+            m_initialStrain, -1.0, 1.0, 8, &ok);
+        if (ok) {
+            setStrainInfo(m_thermalExpansion, m_deltaT, value);
+        }
+    }
+    else if (chosen == densityAction) {
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Стержень", "Плотность ρ, кг/м³:",
+            m_density, 0.0, 1e6, 3, &ok);
+        if (ok) {
+            setDensity(value);
+        }
+    }
+    else if (chosen == hardeningAction) {
+        // Билинейная диаграмма: предел текучести — σ_max стержня
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Стержень",
+            "Модуль упрочнения E_t, Па (0 — идеальная пластичность):",
+            m_tangentModulus, 0.0, 1e15, 3, &ok);
+        if (ok) {
+            setTangentModulus(value);
+        }
+    }
+    else if (chosen == sectionAction) {
+        // Закон A(ξ), ξ = x/L: значения через пробел, для таблицы — пары ξ:A
+        const QStringList kinds = { "Постоянное", "Линейное", "Полином", "Таблица" };
+        bool ok;
+        QString kindName = QInputDialog::getItem(nullptr, "Стержень", "Сечение:", kinds,
+            static_cast<int>(m_section.kind), false, &ok);
+        if (!ok) return;
+
+        SectionProfile section;
+        section.kind = static_cast<SectionKind>(kinds.indexOf(kindName));
+        if (section.kind == SectionKind::Constant) {
+            setSection(section);
+            return;
+        }
+
+        const QString hints[] = { "", "A слева и A справа, м²:", "Коэффициенты A(ξ) = c0 + c1·ξ + ..., м²:",
+            "Точки ξ:A, ξ от 0 до 1:" };
+        QString text = QInputDialog::getText(nullptr, "Стержень", hints[static_cast<int>(section.kind)],
+            QLineEdit::Normal, QString(), &ok);
+        if (!ok) return;
+
+        for (const QString& token : text.split(' ', Qt::SkipEmptyParts)) {
+            if (section.kind == SectionKind::Table) {
+                QStringList pair = token.split(':');
+                if (pair.size() != 2) return;
+                section.points.push_back(pair[0].toDouble());
+                section.values.push_back(pair[1].toDouble());
+            }
+            else {
+                section.values.push_back(token.toDouble());
+            }
+        }
+        if (section.isValid()) {
+            setSection(section);
+        }
+    }
+    else if (chosen == deleteAction) {
+        safeDelete();
+    }
+}
+
+// ---------- ЗАДЕЛКА ----------
+FixedSupportItem::FixedSupportItem(qreal x, qreal y, qreal height, ElementDirection dir) : el_d(dir), _ox(x), _oy(y)
+{
+    const QPen pen(Qt::black, 2);
+    QPainterPath path;
+
+    path.moveTo(0, 0);
+    path.lineTo(0, height);
+
+    qreal spacing = 5;
+    qreal diagLen = 12;
+    int count = static_cast<int>(height / spacing);
+
+    for (int i = 0; i < count; ++i) {
+        qreal yPos = i * spacing;
+        path.moveTo(0, yPos);
+        if (dir == ElementDirection::Left) {
+            path.lineTo(-diagLen, yPos + spacing / 2);
+        }
+        else if (dir == ElementDirection::Right) {
+            path.lineTo(diagLen, yPos - spacing / 2);
+        }
+    }
+
+    auto* hatch = new QGraphicsPathItem(path);
+    hatch->setPen(pen);
+    addToGroup(hatch);
+
+    setPos(x, y);
+    pointConnect = PointConnector(0, height / 2);
+
+    // Создаем зеленую точку
+    const qreal radius = 4.0;
+    auto ellipse = new QGraphicsEllipseItem(
+        pointConnect.o_x - radius, pointConnect.o_y - radius,
+        radius * 2, radius * 2, this
+    );
+    ellipse->setBrush(Qt::green);
+    ellipse->setPen(Qt::NoPen);
+
+    setFlag(QGraphicsItem::ItemIsMovable);
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+}
+
+PointConnector FixedSupportItem::getPointConnector() const
+{
+    QPointF scenePos = mapToScene(QPointF(pointConnect.o_x, pointConnect.o_y));
+    return PointConnector(scenePos.x(), scenePos.y());
+}
+
+void FixedSupportItem::setConnectedTo(BeamItem* other) {
+    if (!other || m_beingDestroyed) return;
+
+    connectedTo = other;
+
+    for (auto item : childItems()) {
+        if (auto pathItem = dynamic_cast<QGraphicsPathItem*>(item)) {
+            pathItem->setBrush(QBrush(QColor(200, 255, 200)));
+        }
+    }
+
+    QTimer::singleShot(200, [this]() {
+        if (this && this->scene() && !m_beingDestroyed) {
+            for (auto item : childItems()) {
+                if (auto pathItem = dynamic_cast<QGraphicsPathItem*>(item)) {
+                    pathItem->setBrush(QBrush());
+                }
+            }
+        }
+        });
+}
+
+void FixedSupportItem::disconnect() {
+    if (m_beingDestroyed || !connectedTo) {
+        return;
+    }
+
+    BeamItem* oldConnected = connectedTo;
+    connectedTo = nullptr;
+
+    if (oldConnected) {
+        // Проверяем, что объект все еще существует в сцене
+        if (scene() && scene()->items().contains(oldConnected)) {
+            if (oldConnected->connectedTo == this && !oldConnected->isBeingDestroyed()) {
+                oldConnected->connectedTo = nullptr;
+                oldConnected->setFlag(QGraphicsItem::ItemIsMovable, true);
+                oldConnected->setBrush(QBrush(Qt::white));
+            }
+        }
+    }
+
+    setFlag(QGraphicsItem::ItemIsMovable, true);
+
+    if (scene() && scene()->items().contains(this)) {
+        setPos(pos() + QPointF(20, 0));
+    }
+}
+
+void FixedSupportItem::safeDelete() {
+    if (m_beingDestroyed) return;
+
+    m_beingDestroyed = true;
+
+ 
+    disconnect();
+
+    if (scene()) {
+        scene()->removeItem(this);
+
+        // Используем QTimer для отложенного удаления
+        QTimer::singleShot(0, [this]() {
+            delete this;
+            });
+
+    }
+    else {
+        delete this;
+    }
+    emit supportDeleted(el_d);
+}
+
+void FixedSupportItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    if (m_beingDestroyed) return;
+    QGraphicsItemGroup::mousePressEvent(event);
+}
+
+void FixedSupportItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
+    if (m_beingDestroyed) return;
+
+    QMenu menu;
+    QAction* detachAction = menu.addAction(connectedTo ? "Отсоединить от балки" : "Отсоединить (не соединена)");
+    QAction* settlementAction = menu.addAction("Осадка...");
+    QAction* stiffnessAction = menu.addAction("Упругость...");
+    QAction* deleteAction = menu.addAction("Удалить");
+
+    detachAction->setEnabled(connectedTo != nullptr);
+
+    QAction* chosen = menu.exec(event->screenPos());
+
+    if (!chosen || m_beingDestroyed) return;
+
+    if (chosen == detachAction && connectedTo) {
+        disconnect();
+    }
+    else if (chosen == settlementAction) {
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Заделка", "Заданное перемещение, м:",
+            m_settlement, -1e6, 1e6, 6, &ok);
+        if (ok) {
+            setSettlement(value);
+        }
+    }
+    else if (chosen == stiffnessAction) {
+        // 0 — жесткая заделка, иначе пружина на землю
+        bool ok;
+        double value = QInputDialog::getDouble(nullptr, "Заделка", "Жесткость опоры, Н/м (0 — жесткая):",
+            m_stiffness, 0.0, 1e15, 3, &ok);
+        if (ok) {
+            setStiffness(value);
+        }
+    }
+    else if (chosen == deleteAction) {
+        safeDelete();
+    }
+}
+
+void FixedSupportItem::setSettlement(double settlement)
+{
+    m_settlement = settlement;
+    updateToolTip();
+}
+
+void FixedSupportItem::setStiffness(double stiffness)
+{
+    m_stiffness = stiffness;
+    updateToolTip();
+}
+
+void FixedSupportItem::updateToolTip()
+{
+    QStringList lines;
+    if (m_stiffness > 0.0) {
+        lines << QString("Упругая опора: k = %1 Н/м").arg(m_stiffness);
+    }
+    if (m_settlement != 0.0) {
+        lines << QString("Осадка: %1 м").arg(m_settlement);
+    }
+    setToolTip(lines.join("\n"));
+}
+
+QVariant FixedSupportItem::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+    if (change == ItemPositionHasChanged) {
+        QPointF newPos = value.toPointF();
+        _ox = newPos.x();
+        _oy = newPos.y();
+    }
+    return QGraphicsItemGroup::itemChange(change, value);
+}
+
+// ---------- СИЛА ----------
+ForceItem::ForceItem(qreal x, qreal y, ElementDirection dir,
+    qreal length, const QPen& pen)
+    : el_d(dir), _ox(x), _oy(y), arrowLength(length), m_pen(pen)
+{
+    // изначально сила на начале балки
+    len_fr_beam = 0;
+
+    // позиционируем в сцене: смещение от начала балки
+    setPos(_ox + len_fr_beam, _oy);
+
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+    
+    setZValue(10);
+}
+
+PointConnector ForceItem::getPointConnector() const
+{
+    return PointConnector(_ox, _oy);
+}
+
+void ForceItem::set_Len_fr_beam(qreal newLength) {
+    len_fr_beam = newLength;
+    // позиция в сцене — только через setPos, локальная геометрия не меняется
+    setPos(_ox + len_fr_beam + metersToQreal(m_offset), _oy);
+}
+
+void ForceItem::setOffset(double meters)
+{
+    m_offset = meters;
+    setPos(_ox + len_fr_beam + metersToQreal(m_offset), _oy);
+}
+
+void ForceItem::changeDirection(ElementDirection dir)
+{
+    if (el_d == dir) return;
+    el_d = dir;
+    // просто перерисовываем локальную геометрию, позиция не трогается
+    update();
+}
+
+void ForceItem::setForce_H(qreal force_digital, int pos_beam)
+{
+    force_H = force_digital;
+    force_pos_beam = pos_beam;
+
+    update();
+}
+
+std::tuple<qreal, qreal, int> ForceItem::getInfo()
+{
+    return std::make_tuple(len_fr_beam, force_H, force_pos_beam);
+}
+
+QRectF ForceItem::boundingRect() const
+{
+    // Даем запас по рамке, чтобы поместилась стрелка и текст
+    // Симметрично относительно локального (0,0)
+    qreal margin = 20.0;
+    return QRectF(-arrowLength - margin, -margin,
+        2 * arrowLength + 2 * margin, 2 * margin);
+}
+
+void ForceItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    painter->setPen(m_pen);
+    painter->setBrush(Qt::NoBrush);
+
+    const qreal dx = (el_d == ElementDirection::Right ? arrowLength : -arrowLength);
+
+    // линия
+    painter->drawLine(0, 0, dx, 0);
+
+    // При сильном отдалении наконечник и подпись все равно не различимы
+    if (RenderDetail::isCulled(painter)) return;
+
+    // стрелка
+    const qreal head = 10.0;
+    if (el_d == ElementDirection::Right) {
+        QPolygonF arrowHead;
+        arrowHead << QPointF(dx, 0)
+            << QPointF(dx - head, -head / 2)
+            << QPointF(dx - head, head / 2);
+        painter->drawPolygon(arrowHead);
+    }
+    else {
+        QPolygonF arrowHead;
+        arrowHead << QPointF(dx, 0)
+            << QPointF(dx + head, -head / 2)
+            << QPointF(dx + head, head / 2);
+        painter->drawPolygon(arrowHead);
+    }
+
+    // текст "F"
+    painter->setPen(m_pen.color());
+    const QPointF textPos = (el_d == ElementDirection::Right)
+        ? QPointF(dx / 2 - 5, -10)
+        : QPointF(dx / 2 - 5, 15);
+
+    QString tmp = QString("%1 (H) F").arg(force_H);
+    painter->drawText(textPos, tmp);
+}
+
+void ForceItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    QGraphicsItem::mousePressEvent(event);
+}
+
+void ForceItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
+    QMenu menu;
+    QAction* detachAction = menu.addAction("Отсоединить");
+    QAction* editAction = menu.addAction("Изменить");
+    QAction* offsetAction = menu.addAction("Положение на стержне...");
+    QAction* historyAction = menu.addAction("Закон F(t)...");
+    QAction* deleteAction = menu.addAction("Удалить");
+
+    QAction* chosen = menu.exec(event->screenPos());
+    if (chosen == historyAction) {
+        // Таблица "t:f" — множитель силы, линейно между точками, за концами постоянен
+        QStringList points;
+        for (size_t i = 0; i < m_history.times.size(); ++i) {
+            points << QString("%1:%2").arg(m_history.times[i]).arg(m_history.values[i]);
+        }
+        bool ok;
+        QString text = QInputDialog::getText(nullptr, "Закон F(t)",
+            "Точки t:f через пробел (пусто — постоянная сила):", QLineEdit::Normal, points.join(' '), &ok);
+        if (ok) {
+            LoadHistory history;
+            for (const QString& token : text.split(' ', Qt::SkipEmptyParts)) {
+                QStringList pair = token.split(':');
+                if (pair.size() != 2) continue;
+                double t = pair[0].toDouble();
+                if (!history.times.empty() && t <= history.times.back()) continue;
+                history.times.push_back(t);
+                history.values.push_back(pair[1].toDouble());
+            }
+            m_history = history;
+        }
+    }
+    else if (chosen == offsetAction) {
+        // Смещение вправо от узла; сила внутри пролета учитывается стержнем, а не узлом
+        bool ok;
+        double offset = QInputDialog::getDouble(nullptr, "Сосредоточенная сила", "Смещение от узла, м:",
+            m_offset, -1e6, 1e6, 4, &ok);
+        if (ok) {
+            setOffset(offset);
+        }
+    }
+    else if (chosen == deleteAction) {
+        if (scene()) {
+            scene()->removeItem(this);
+            // Для ForceItem используем прямое удаление
+            delete this;
+        }
+        else {
+            delete this;
+        }
+    }
+}
+
+LineLoadItem::LineLoadItem(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2,
+    ElementDirection dir, const QPen& pen)
+    : m_pen(pen), el_d(dir)
+{
+    q_line_load = 0;
+
+    // локальные координаты: начало всегда (0,0)
+    start_x1 = 0;
+    stop_y1 = 0;
+    start_x2 = ox_2 - ox_1;
+    stop_y2 = oy_2 - oy_1;
+
+    // глобальное смещение
+    setPos(ox_1, oy_1);
+
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+    setZValue(10);
+}
+
+std::tuple<qreal, int> LineLoadItem::getInfo() {
+
+    return std::make_tuple(q_line_load, _beamDig);
+}
+
+PointConnector LineLoadItem::getPointConnector() const
+{
+    return PointConnector();
+}
+
+void LineLoadItem::change_loc_joins(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2)
+{
+    prepareGeometryChange();
+
+    setPos(ox_1, oy_1);
+
+    start_x1 = 0;
+    stop_y1 = 0;
+    start_x2 = ox_2 - ox_1;
+    stop_y2 = oy_2 - oy_1;
+
+    
+    update();
+}
+
+void LineLoadItem::set_LineLoad(qreal q_l_load, int beamD) {
+    _beamDig = beamD;
+    q_line_load = q_l_load;
+    update();
+}
+
+std::tuple<double, double, double> LineLoadItem::getSpan() const
+{
+    return { m_spanStart, m_spanEnd, m_uniform ? q_line_load : m_qEnd };
+}
+
+void LineLoadItem::setSpan(double start, double end, double qEnd)
+{
+    prepareGeometryChange();
+    m_spanStart = std::clamp(start, 0.0, 1.0);
+    m_spanEnd = std::clamp(end, m_spanStart, 1.0);
+    m_qEnd = qEnd;
+    m_uniform = qEnd == q_line_load;
+    update();
+}
+
+void LineLoadItem::change_direction(ElementDirection direction)
+{
+    el_d = direction;
+
+    update();
+}
+
+QRectF LineLoadItem::boundingRect() const
+{
+    qreal minX = std::min(start_x1, start_x2);
+    qreal maxX = std::max(start_x1, start_x2);
+    qreal minY = std::min(stop_y1, stop_y2);
+    qreal maxY = std::max(stop_y1, stop_y2);
+
+    // запас под стрелочные головки
+    const qreal headX = 10.0;
+    const qreal headY = 6.0;
+    const qreal margin = 4.0;
+
+    QString tmp = QString("%1 (H/М) q").arg(q_line_load);
+
+    // Примерная ширина символа ~8px, высота текста ~15px
+    qreal textWidth = tmp.length() * 8.0;
+    qreal textHeight = 15.0;
+
+    // Позиция текста
+    qreal textX = (start_x1 + start_x2) / 2 - 5;
+    qreal textY = -10;
+
+    // Расширяем границы с учетом текста
+    qreal finalMinX = std::min(minX - headX - margin, textX - margin);
+    qreal finalMaxX = std::max(maxX + headX + margin, textX + textWidth + margin);
+    qreal finalMinY = std::min(minY - headY - margin, textY - textHeight - margin);
+    qreal finalMaxY = std::max(maxY + headY + margin, textY + margin);
+
+    return QRectF(finalMinX, finalMinY,
+        finalMaxX - finalMinX,
+        finalMaxY - finalMinY);
+}
+
+void LineLoadItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    painter->setPen(m_pen);
+    painter->setBrush(Qt::NoBrush);
+
+    // Нагрузка может занимать часть стержня
+    const qreal x1 = start_x1 + (start_x2 - start_x1) * m_spanStart;
+    const qreal x2 = start_x1 + (start_x2 - start_x1) * m_spanEnd;
+    const qreal y1 = stop_y1 + (stop_y2 - stop_y1) * m_spanStart;
+    const qreal y2 = stop_y1 + (stop_y2 - stop_y1) * m_spanEnd;
+
+    // основная линия
+    painter->drawLine(x1, y1, x2, y2);
+
+    qreal len = x2 - x1;
+    if (qFuzzyIsNull(len)) return;
+    if (RenderDetail::isCulled(painter)) return;
+
+    const qreal step = 20.0;
+    const qreal headX = 8.0;
+    const qreal headY = 4.0;
+
+    if (el_d == ElementDirection::Right) {
+        // Стрелки вправо - острие справа
+        for (qreal x = x1 + step; x <= x2; x += step) {
+            qreal y = y1 + (y2 - y1) * (x - x1) / len;
+
+            QPolygonF arrowHead;
+            arrowHead << QPointF(x, y)              // острие стрелки
+                << QPointF(x - headX, y - headY)    // верх хвоста
+                << QPointF(x - headX, y + headY);   // низ хвоста
+
+            painter->setBrush(QBrush(m_pen.color()));
+            painter->drawPolygon(arrowHead);
+            painter->setBrush(Qt::NoBrush);
+        }
+    }
+    else { // Left
+        // Стрелки влево - острие СЛЕВА
+        for (qreal x = x1 + step; x <= x2; x += step) {
+            qreal y = y1 + (y2 - y1) * (x - x1) / len;
+
+            QPolygonF arrowHead;
+            arrowHead << QPointF(x - headX, y)      // острие стрелки (слева)
+                << QPointF(x, y - headY)            // верх хвоста (справа)
+                << QPointF(x, y + headY);           // низ хвоста (справа)
+
+            painter->setBrush(QBrush(m_pen.color()));
+            painter->drawPolygon(arrowHead);
+            painter->setBrush(Qt::NoBrush);
+        }
+    }
+
+    painter->setPen(m_pen.color());
+    const QPointF textPos = (el_d == ElementDirection::Right)
+        ? QPointF((x1 + x2) / 2 - 5, -10)
+        : QPointF((x1 + x2) / 2 - 5, -10);
+
+    QString tmp = m_uniform ? QString("%1 (H/м) q").arg(q_line_load)
+        : QString("%1…%2 (H/м) q").arg(q_line_load).arg(m_qEnd);
+    painter->drawText(textPos, tmp);
+}
+
+
+void LineLoadItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    QGraphicsItem::mousePressEvent(event);
+}
+
+void LineLoadItem::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
+{
+    QMenu menu;
+    QAction* spanAction = menu.addAction("Участок и трапеция...");
+    QAction* deleteAction = menu.addAction("Удалить");
+
+    QAction* chosen = menu.exec(event->screenPos());
+    if (chosen == spanAction) {
+        // Начало и конец — доли длины стержня, q в начале участка задается как обычно
+        bool ok;
+        double start = QInputDialog::getDouble(nullptr, "Погонная нагрузка", "Начало участка, доля длины:",
+            m_spanStart, 0.0, 1.0, 4, &ok);
+        if (!ok) return;
+        double end = QInputDialog::getDouble(nullptr, "Погонная нагрузка", "Конец участка, доля длины:",
+            m_spanEnd, start, 1.0, 4, &ok);
+        if (!ok) return;
+        double qEnd = QInputDialog::getDouble(nullptr, "Погонная нагрузка", "q в конце участка, Н/м:",
+            m_uniform ? q_line_load : m_qEnd, -1e12, 1e12, 4, &ok);
+        if (ok) {
+            setSpan(start, end, qEnd);
+        }
+    }
+    else if (chosen == deleteAction) {
+        if (scene()) {
+            scene()->removeItem(this);
+            delete this;
+        }
+        else {
+            delete this;
+        }
+    }
+}
+BeamSign::BeamSign(qreal _ox, qreal _oy, int numb, const QPen& pen) :
+    x_pos(_ox), y_pos(_oy), number(numb), _pen(pen)
+{
+
+
+    setPos(x_pos, y_pos);
+
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+    setZValue(10);
+}
+QRectF BeamSign::boundingRect() const
+{
+    return QRectF(-radius, -radius, 2*radius, 2*radius);
+}
+void BeamSign::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->setPen(_pen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawEllipse(boundingRect());
+
+    QFont font = painter->font();
+    font.setPointSize(12);   // размер в пунктах (чем больше, тем крупнее)
+    // font.setPixelSize(20); // альтернатива — фиксированный размер в пикселях
+    font.setBold(true);      // можно сделать жирным
+    painter->setFont(font);
+
+    QString tmp = QString::number(number);
+    painter->drawText(boundingRect(), Qt::AlignCenter, tmp);
+}
+// ---------- ConnectionManager ----------
+std::vector<BeamItem*> ConnectionManager::getBeams(QGraphicsScene* scene)
+{
+    std::vector<BeamItem*> beams;
+    beams.reserve(20); // Резервируем память
+
+    for (auto& item : scene->items()) {
+        if (auto beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) { // Проверяем, что балка не удаляется
+                beams.push_back(beam);
+            }
+        }
+    }
+    return beams;
+}
+void BeamSign::remove() {
+    if (scene()) {
+        scene()->removeItem(this);
+        delete this;
+    }
+}
+void PlotItem::remove() {
+    if (scene()) {
+        scene()->removeItem(this);
+        delete this;
+    }
+}
+void DiagramItem::remove() {
+    if (scene()) {
+        scene()->removeItem(this);
+        delete this;
+    }
+}
+BeamJoint::BeamJoint(qreal _ox, qreal _oy, int numb, const QPen& pen)
+    : x_pos(_ox), y_pos(_oy), number(numb), _pen(pen){
+
+    setPos(x_pos, y_pos);
+
+    setFlag(QGraphicsItem::ItemIsSelectable);
+    setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
+    setZValue(10);
+}
+void BeamJoint::remove() {
+    if (scene()) {
+        scene()->removeItem(this);
+        delete this;
+    }
+}
+QRectF BeamJoint::boundingRect() const
+{
+    return QRectF(-square_side, -square_side, square_side, square_side);
+}
+
+void BeamJoint::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->setPen(_pen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(boundingRect());
+
+    QFont font = painter->font();
+    font.setPointSize(12);
+    // font.setPixelSize(20); // альтернатива — фиксированный размер в пикселях
+    font.setBold(true);
+    painter->setFont(font);
+
+    QString tmp = QString::number(number);
+    painter->drawText(boundingRect(), Qt::AlignCenter, tmp);
+}
+
+
+std::vector<FixedSupportItem*> ConnectionManager::getSupports(QGraphicsScene* scene)
+{
+    std::vector<FixedSupportItem*> supports;
+    supports.reserve(10);
+
+    for (auto& item : scene->items()) {
+        if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
+            if (!support->isBeingDestroyed()) { // Проверяем, что заделка не удаляется
+                supports.push_back(support);
+            }
+        }
+    }
+    return supports;
+}
+
+bool ConnectionManager::tryConnectBeams(BeamItem* movable, BeamItem* target)
+{
+    if (!movable || !target || movable == target) return false;
+
+    // Проверяем, что оба объекта еще существуют в сцене
+    if (!movable->scene() || !target->scene()) return false;
+    if (movable->isBeingDestroyed() || target->isBeingDestroyed()) return false;
+
+    PointConnector leftMovable = movable->getLeftConnector();
+    PointConnector rightMovable = movable->getRightConnector();
+    PointConnector leftTarget = target->getLeftConnector();
+    PointConnector rightTarget = target->getRightConnector();
+
+    qreal distance1 = leftMovable.distanceSquaredTo(rightTarget);
+    qreal distance2 = rightMovable.distanceSquaredTo(leftTarget);
+
+    if (distance1 < SNAP_DISTANCE_SQUARED || distance2 < SNAP_DISTANCE_SQUARED) {
+        bool connectLeftToRight = distance1 < distance2;
+
+        QPointF targetPoint = connectLeftToRight ?
+            QPointF(rightTarget.o_x, rightTarget.o_y) :
+            QPointF(leftTarget.o_x, leftTarget.o_y);
+
+        QPointF movablePoint = connectLeftToRight ?
+            QPointF(leftMovable.o_x, leftMovable.o_y) :
+            QPointF(rightMovable.o_x, rightMovable.o_y);
+
+        QPointF offset = targetPoint - movablePoint;
+        movable->setPos(movable->pos() + offset);
+        movable->setFlag(QGraphicsItem::ItemIsMovable, false);
+
+        movable->setConnectedTo(target);
+        target->setConnectedTo(movable);
+
+        return true;
+    }
+    return false;
+}
+
+bool ConnectionManager::tryConnectSupportToBeam(FixedSupportItem* support, BeamItem* beam)
+{
+    if (!support || !beam) return false;
+
+    // Проверяем, что оба объекта еще существуют в сцене
+    if (!support->scene() || !beam->scene()) return false;
+    if (support->isBeingDestroyed() || beam->isBeingDestroyed()) return false;
+
+    PointConnector supportPoint = support->getPointConnector();
+    PointConnector leftTarget = beam->getLeftConnector();
+    PointConnector rightTarget = beam->getRightConnector();
+
+    qreal distance1 = supportPoint.distanceSquaredTo(leftTarget);
+    qreal distance2 = supportPoint.distanceSquaredTo(rightTarget);
+
+    if (distance1 < SNAP_DISTANCE_SQUARED || distance2 < SNAP_DISTANCE_SQUARED) {
+        bool connectToLeft = distance1 < distance2;
+
+        QPointF targetPoint = connectToLeft ?
+            QPointF(leftTarget.o_x, leftTarget.o_y) :
+            QPointF(rightTarget.o_x, rightTarget.o_y);
+
+        QPointF supportScenePos = QPointF(supportPoint.o_x, supportPoint.o_y);
+        QPointF offset = targetPoint - supportScenePos;
+        support->setPos(support->pos() + offset);
+        support->setFlag(QGraphicsItem::ItemIsMovable, false);
+
+        support->setConnectedTo(beam);
+        beam->setConnectedTo(support);
+
+        return true;
+    }
+    return false;
+}
+
+bool ConnectionManager::trySnapItems(QGraphicsScene* scene)
+{
+    if (!scene) return false;
+
+    // Получаем все элементы одним проходом
+    auto allBeams = getBeams(scene);
+    auto allSupports = getSupports(scene);
+
+    // Сначала пытаемся соединить подвижные балки
+    for (auto* movable : allBeams) {
+        if (!(movable->flags() & QGraphicsItem::ItemIsMovable)) continue;
+        if (movable->isBeingDestroyed()) continue;
+
+        for (auto* target : allBeams) {
+            if (target->isBeingDestroyed()) continue;
+            if (tryConnectBeams(movable, target)) {
+                return true;
+            }
+        }
+    }
+
+    // Затем пытаемся соединить подвижные заделки с балками
+    for (auto* support : allSupports) {
+        if (!(support->flags() & QGraphicsItem::ItemIsMovable)) continue;
+        if (support->isBeingDestroyed()) continue;
+
+        for (auto* beam : allBeams) {
+            if (beam->isBeingDestroyed()) continue;
+            if (tryConnectSupportToBeam(support, beam)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ConnectionManager::checkAndSnapNewItem(QGraphicsItem* newItem, QGraphicsScene* scene)
+{
+    if (!newItem || !scene) return false;
+
+    bool wasMovable = newItem->flags() & QGraphicsItem::ItemIsMovable;
+    newItem->setFlag(QGraphicsItem::ItemIsMovable, true);
+
+    bool snapped = trySnapItems(scene);
+
+    if (!snapped) {
+        newItem->setFlag(QGraphicsItem::ItemIsMovable, wasMovable);
+    }
+
+    return snapped;
+}
+
+int ConnectionManager::snapAllItems(QGraphicsScene* scene)
+{
+    if (!scene) return 0;
+
+    auto allBeams = getBeams(scene);
+    auto allSupports = getSupports(scene);
+
+    // Балки по X левого коннектора: соседа ищем бинарным поиском, а не перебором
+    std::vector<std::pair<qreal, BeamItem*>> byLeft;
+    byLeft.reserve(allBeams.size());
+    for (auto* beam : allBeams) {
+        byLeft.emplace_back(beam->getLeftConnector().o_x, beam);
+    }
+    std::sort(byLeft.begin(), byLeft.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Ключи могут устареть на величину привязки после сдвига балки, поэтому окно шире
+    const qreal window = 2 * SNAP_DISTANCE;
+    int connections = 0;
+
+    // Слева направо: каждая следующая балка подтягивается к уже выровненной
+    for (auto& [leftX, beam] : byLeft) {
+        if (beam->isBeingDestroyed()) continue;
+        PointConnector right = beam->getRightConnector();
+
+        auto it = std::lower_bound(byLeft.begin(), byLeft.end(), right.o_x - window,
+            [](const auto& p, qreal value) { return p.first < value; });
+
+        for (; it != byLeft.end() && it->first <= right.o_x + window; ++it) {
+            BeamItem* next = it->second;
+            if (next == beam || next->isBeingDestroyed()) continue;
+            if (tryConnectBeams(next, beam)) {
+                connections++;
+                break;
+            }
+        }
+    }
+
+    // Заделок на сцене не больше двух, полный перебор балок здесь дешевый
+    for (auto* support : allSupports) {
+        if (!(support->flags() & QGraphicsItem::ItemIsMovable)) continue;
+        if (support->isBeingDestroyed()) continue;
+
+        for (auto* beam : allBeams) {
+            if (tryConnectSupportToBeam(support, beam)) {
+                connections++;
+                break;
+            }
+        }
+    }
+
+    return connections;
+}
+
+bool PointConnector::operator==(PointConnector p_con)
+{
+    return qFuzzyCompare(o_x, p_con.o_x) && qFuzzyCompare(o_y, p_con.o_y);
+}
+
+// Шрифты эпюр создаются один раз, а не на каждую перерисовку
+static const QFont& diagramTitleFont()
+{
+    static const QFont font = [] {
+        QFont f;
+        f.setPixelSize(12);
+        f.setBold(true);
+        return f;
+        }();
+    return font;
+}
+
+static const QFont& diagramValueFont()
+{
+    static const QFont font("Arial", 9, QFont::Bold);
+    return font;
+}
+
+void DiagramItem::setValues(const std::vector<double>& values)
+{
+    m_values = values;
+    rebuildGeometry();
+}
+
+void DiagramItem::setPositions(const std::vector<double>& positions)
+{
+    m_positions = positions;
+    rebuildGeometry();
+}
+
+void DiagramItem::setScaling(int scalingparam)
+{
+    if (_scaling == scalingparam) return;
+    _scaling = scalingparam;
+    rebuildGeometry();
+}
+
+void DiagramItem::rebuildGeometry()
+{
+    prepareGeometryChange();
+
+    m_lodCache.clear();
+    m_hasLeftText = m_hasRightText = false;
+
+    // Формируем график по всем точкам
+    std::vector<size_t> indices(m_values.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+    m_paths = buildPaths(indices);
+
+    m_bounds = m_paths.fill.boundingRect().united(QRectF(0, -1, m_beamLength, 2));
+
+    // drawStaticText позиционирует по левому верхнему углу, а не по базовой линии
+    const QFont& titleFont = diagramTitleFont();
+    const QFont& valueFont = diagramValueFont();
+    const qreal titleAscent = QFontMetricsF(titleFont).ascent();
+    const qreal valueAscent = QFontMetricsF(valueFont).ascent();
+
+    if (!m_label.isEmpty()) {
+        m_titleText.setText(m_label);
+        m_titleText.prepare(QTransform(), titleFont);
+        m_titlePos = QPointF(-22, -5 - titleAscent);
+        m_bounds |= QRectF(m_titlePos, m_titleText.size());
+    }
+
+    const double eps = 1e-9;
+    if (!m_values.empty()) {
+        double leftValue = m_values.front();
+        if (std::abs(leftValue) > eps && showLeftLabel) {
+            m_leftText.setText(QString::number(leftValue, 'f', 2));
+            m_leftText.prepare(QTransform(), valueFont);
+            m_leftPos = QPointF(0, -leftValue * _scaling - 8 - valueAscent);
+            m_bounds |= QRectF(m_leftPos, m_leftText.size());
+            m_hasLeftText = true;
+        }
+
+        double rightValue = m_values.back();
+        if (std::abs(rightValue) > eps && showRightLabel) {
+            m_rightText.setText(QString::number(rightValue, 'f', 2));
+            m_rightText.prepare(QTransform(), valueFont);
+            m_rightPos = QPointF(m_beamLength - 25, -rightValue * _scaling - 8 - valueAscent);
+            m_bounds |= QRectF(m_rightPos, m_rightText.size());
+            m_hasRightText = true;
+        }
+    }
+
+    // запас под толщину пера
+    m_bounds.adjust(-2, -2, 2, 2);
+    update();
+}
+
+DiagramItem::DiagramPaths DiagramItem::buildPaths(const std::vector<size_t>& indices) const
+{
+    DiagramPaths paths;
+    if (indices.empty()) return paths;
+
+    // Неравномерная сетка: повтор координаты дает вертикальный скачок
+    qreal stepX = (m_values.size() > 1) ? m_beamLength / (m_values.size() - 1) : 0.0;
+    const bool positioned = m_positions.size() == m_values.size();
+    auto xAt = [&](size_t i) { return positioned ? m_positions[i] * m_beamLength : i * stepX; };
+
+    paths.line.moveTo(xAt(indices[0]), -m_values[indices[0]] * _scaling);
+    for (size_t k = 1; k < indices.size(); k++) {
+        paths.line.lineTo(xAt(indices[k]), -m_values[indices[k]] * _scaling);
+    }
+
+    paths.fill = paths.line;
+    paths.fill.lineTo(m_beamLength, 0);
+    paths.fill.lineTo(0, 0);
+    paths.fill.closeSubpath();
+    return paths;
+}
+
+const DiagramItem::DiagramPaths& DiagramItem::pathsForLevelOfDetail(qreal lod)
+{
+    if (lod <= 0 || m_values.size() < 3) return m_paths;
+
+    // Корзина масштаба: шаг в полоктавы, ширину берем по верхней границе корзины
+    const int bucket = static_cast<int>(std::floor(std::log2(lod) * 2.0));
+    const qreal bucketScale = std::pow(2.0, (bucket + 1) / 2.0);
+    const size_t columns = static_cast<size_t>(std::ceil(m_beamLength * bucketScale)) + 1;
+
+    // Точек меньше, чем помещается в пиксельные столбцы: рисуем без прореживания
+    if (m_values.size() <= 2 * columns + 2) return m_paths;
+
+    auto cached = m_lodCache.find(bucket);
+    if (cached != m_lodCache.end()) return cached->second;
+
+    // Min/max по пиксельным столбцам: экстремумы остаются на своих местах,
+    // число вершин ограничено шириной эпюры на экране
+    const size_t n = m_values.size();
+    std::vector<size_t> indices;
+    indices.reserve(2 * columns + 2);
+    indices.push_back(0);
+
+    for (size_t c = 0; c < columns; c++) {
+        size_t i0 = c * n / columns;
+        size_t i1 = (c + 1) * n / columns;
+        if (i0 >= i1) continue;
+
+        size_t iMin = i0, iMax = i0;
+        for (size_t i = i0 + 1; i < i1; i++) {
+            if (m_values[i] < m_values[iMin]) iMin = i;
+            if (m_values[i] > m_values[iMax]) iMax = i;
+        }
+
+        size_t first = std::min(iMin, iMax);
+        size_t second = std::max(iMin, iMax);
+        if (first != indices.back()) indices.push_back(first);
+        if (second != indices.back()) indices.push_back(second);
+    }
+
+    if (indices.back() != n - 1) indices.push_back(n - 1);
+
+    return m_lodCache.emplace(bucket, buildPaths(indices)).first->second;
+}
+
+void DiagramItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+{
+    const DiagramPaths& paths = pathsForLevelOfDetail(
+        option->levelOfDetailFromTransform(painter->worldTransform()));
+
+    painter->setPen(QPen(Qt::black, 2));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawLine(QLineF(0, 0, m_beamLength, 0));
+
+    // Рисуем подпись (если есть)
+    if (!m_label.isEmpty())
+    {
+        painter->setPen(Qt::black);
+        painter->setFont(diagramTitleFont());
+        painter->drawStaticText(m_titlePos, m_titleText);
+    }
+
+    painter->setBrush(QBrush(Qt::lightGray));
+    painter->setPen(QPen(Qt::black, 1));
+    painter->drawPath(paths.fill);
+
+    painter->setBrush(Qt::NoBrush);
+    painter->setPen(QPen(Qt::blue, 1));
+    painter->drawPath(paths.line);
+
+    painter->setPen(Qt::darkRed);
+    painter->setFont(diagramValueFont());
+    if (m_hasLeftText) {
+        painter->drawStaticText(m_leftPos, m_leftText);
+    }
+    if (m_hasRightText) {
+        painter->drawStaticText(m_rightPos, m_rightText);
+    }
+}
+
+void PlotItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    // Рисуем вертикальную линию
+    QPen linePen(Qt::black, 1);
+    painter->setPen(linePen);
+    painter->drawLine(0, 0, 0, mLineHeight);
+
+    // Рисуем маркер в начале линии (узел)
+    painter->setBrush(QBrush(Qt::black));
+    painter->drawEllipse(QPointF(0, 0), 4, 4);
+
+    
+}
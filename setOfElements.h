@@ -1,307 +1,387 @@
-#ifndef SETOFELEMENTS_H
-#define SETOFELEMENTS_H
-#include <QGraphicsScene>
-#include <QGraphicsItem>
-#include <QGraphicsLineItem>
-#include <QGraphicsRectItem>
-#include <QGraphicsPathItem>
-#include <QGraphicsTextItem>
-#include <QGraphicsItemGroup>
-#include <QGraphicsSceneContextMenuEvent>
-#include <QMenu>
-#include <QPen>
-#include <QBrush>
-#include <QPainterPath>
-#include <QDebug>
-#include <QTimer>
-#include <QObject>
-#include <unordered_map>
-#include <vector>
-#include <QPainter>
-#include "Help.h"
-enum class ElementDirection {
-    Right,
-    Left
-};
-
-struct PointConnector {
-    qreal o_x;
-    qreal o_y;
-
-    PointConnector(qreal x = 0, qreal y = 0) : o_x(x), o_y(y) {}
-
-    // вычисление квадрата расстояния
-    inline qreal distanceSquaredTo(const PointConnector& other) const {
-        qreal dx = o_x - other.o_x;
-        qreal dy = o_y - other.o_y;
-        return dx * dx + dy * dy;
-    }
-
-    bool operator==(PointConnector p_con);
-};
-
-struct IHasConnector {
-    virtual ~IHasConnector() = default;
-    virtual PointConnector getPointConnector() const = 0;
-};
-
-// Предварительные объявления
-class BeamItem;
-class FixedSupportItem;
-
-// Балка
-class BeamItem final : public QGraphicsRectItem, public IHasConnector {
-private:
-    bool m_beingDestroyed = false; // Флаг для предотвращения повторного вызова
-
-    double LenBeam;
-    double cross_sectArea_A;
-    double mod_Elasticity_E;
-    double maxStressBeam_q;
-public:
-    QGraphicsItem* connectedTo = nullptr;
-
-    BeamItem(qreal x1, qreal y1, qreal length, qreal width);
-    virtual ~BeamItem() override {
-        m_beingDestroyed = true;
-        // Явно удаляем дочерние элементы
-        if (leftPoint) delete leftPoint;
-        if (rightPoint) delete rightPoint;
-    }
-    PointConnector getPointConnector() const override;
-
-    PointConnector getLeftConnector() const;
-    PointConnector getRightConnector() const;
-    void setConnectedTo(QGraphicsItem* other);
-    void disconnect();
-    void safeDelete(); // Новая безопасная функция удаления
-
-    std::tuple<qreal, qreal> getParams() const { return { _len, _width };  }
-
-    bool isConnected() const { return connectedTo != nullptr; }
-    QGraphicsItem* getConnectedBeam() const { return connectedTo; }
-    bool isBeingDestroyed() const { return m_beingDestroyed; }
-
-    void set_Length(qreal newLength);
-
-    void setInfo(double _cross_sectArea_A, double _mod_Elasticity_E, double _maxStressBeam_q);
-    std::tuple<qreal, qreal> getCoordinates() { 
-        QPointF pos = scenePos();
-        return { pos.x(), pos.y() };
-    
-    }
-    std::tuple<double, double, double, double> getInfo();
-protected:
-    qreal _ox, _oy, _len, _width;
-    PointConnector pointConnect_left, pointConnect_right;
-
-    // Кэшируем зеленые точки для повторного использования
-    QGraphicsEllipseItem* leftPoint = nullptr;
-    QGraphicsEllipseItem* rightPoint = nullptr;
-
-    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
-    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
-
-private:
-    void updateGreenPoints();
-    QGraphicsEllipseItem* createGreenPoint(const PointConnector& pc);
-};
-
-// Заделка
-class FixedSupportItem final : public QObject, public QGraphicsItemGroup, public IHasConnector {
-    Q_OBJECT
-private:
-    bool m_beingDestroyed = false; // Флаг для предотвращения повторного вызова
-    qreal _ox;
-    qreal _oy;
-
-signals:
-    void supportDeleted(ElementDirection direction);
-public:
-    BeamItem* connectedTo = nullptr;
-
-    FixedSupportItem(qreal x, qreal y, qreal height, ElementDirection dir);
-    virtual ~FixedSupportItem() override {
-        m_beingDestroyed = true;
-    }
-    PointConnector getPointConnector() const override;
-    std::tuple<qreal, qreal, ElementDirection> getInfo() { return{ _ox, _oy, el_d }; }
-    void setConnectedTo(BeamItem* other);
-    void disconnect();
-    void safeDelete();
-
-    bool isConnected() const { return connectedTo != nullptr; }
-    BeamItem* getConnectedBeam() const { return connectedTo; }
-    bool isBeingDestroyed() const { return m_beingDestroyed; }
-
-protected:
-    ElementDirection el_d;
-    PointConnector pointConnect;
-
-    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
-    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
-    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
-};
-
-// Сила
-class ForceItem final : public QGraphicsItem, public IHasConnector {
-
-    qreal len_fr_beam = 0; // длина от начала балки до силы (смещение позиции)
-    qreal force_H = 0;
-    int force_pos_beam = 0;
-    qreal _ox;
-    qreal _oy;
-
-    qreal arrowLength = 50.0;
-
-public:
-    ForceItem(qreal x, qreal y, ElementDirection dir,
-        qreal length = 50, const QPen& pen = QPen(Qt::red, 2));
-
-    PointConnector getPointConnector() const override;
-    void set_Len_fr_beam(qreal newLength);
-    void changeDirection(ElementDirection dir);
-    void setForce_H(qreal force_digital, int pos_beam);
-    std::tuple<qreal, qreal, int> getInfo(); // len && force
-
-protected:
-    ElementDirection el_d;
-    PointConnector pointConnect;
-    QPen m_pen;
-
-    // QGraphicsItem API
-    QRectF boundingRect() const override;
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
-
-    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
-    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
-};
-
-class LineLoadItem final : public QGraphicsItem, public IHasConnector {
-    qreal start_x1 = 0, stop_y1 = 0;
-   qreal start_x2 = 0, stop_y2 = 0;
-   qreal q_line_load = 0;
-   int _beamDig;
-public:
-    LineLoadItem(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2, ElementDirection dir, 
-        const QPen& pen = QPen(Qt::blue, 2));
-    PointConnector getPointConnector() const override;
-
-    void change_loc_joins(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2);
-    void set_LineLoad(qreal q_l_load, int beamD);
-    void change_direction(ElementDirection direction);
-    std::tuple<qreal, int> getInfo();
-protected:
-    ElementDirection el_d;
-    QPen m_pen;
-    QRectF boundingRect() const override;
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
-
-    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
-    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
-
-};
-
-class BeamSign final : public QGraphicsItem {
-    const qreal radius = 12;
-    qreal x_pos, y_pos;
-    
-    int number;
-    const QPen _pen;
-public:
-    
-    BeamSign(qreal _ox, qreal _oy,int numb, const QPen& pen = QPen(Qt::darkCyan, 2));
-
-    void remove();
-protected:
-    QRectF boundingRect() const override;
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
-};
-
-
-class BeamJoint final : public QGraphicsItem {
-    const qreal square_side = 20;
-    qreal x_pos, y_pos;
-
-    int number;
-    const QPen _pen;
-public:
-
-    BeamJoint(qreal _ox, qreal _oy, int numb, const QPen& pen = QPen(Qt::darkGreen, 2));
-
-    void remove();
-protected:
-    QRectF boundingRect() const override;
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
-};
-
-class PlotItem : public QGraphicsItem
-{
-private:
-    qreal mX, mY;
-    qreal mLineHeight;
-
-public:
-    PlotItem(qreal x, qreal y, qreal lineHeight = 100.0)
-        : mX(x), mY(y), mLineHeight(lineHeight)
-    {
-        setPos(mX, mY);
-    }
-    void remove();
-    QRectF boundingRect() const override
-    {
-        qreal width = 40;
-        return QRectF(-20, 0, width, mLineHeight + 30);
-    }
-
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) override;
-};
-
-
-class DiagramItem : public QGraphicsItem {
-private:
-    std::vector<double> m_values;
-    qreal mX, mY, m_beamLength;
-    QString m_label;
-    int _scaling;
-    bool showLeftLabel = true;   // новое поле
-    bool showRightLabel = true;  // новое поле
-
-public:
-    DiagramItem(qreal x, qreal y, qreal length,
-        const std::vector<double>& values,
-        const QString& label, int scalingparam,bool left_sign, bool right_sign)
-        : mX(x), mY(y), m_beamLength(length),
-        m_values(values), m_label(label), _scaling(scalingparam), showLeftLabel(left_sign), showRightLabel(right_sign){
-        setPos(mX, mY);
-    }
-
-    void remove();
-    QRectF boundingRect() const override {
-        return QRectF(0, 0, m_beamLength, 100);
-    }
-
-    void paint(QPainter* painter, const QStyleOptionGraphicsItem*,
-        QWidget*) override;
-};
-
-
-class ConnectionManager : public QObject {
-    Q_OBJECT
-public:
-    static const qreal SNAP_DISTANCE;
-    static const qreal SNAP_DISTANCE_SQUARED; // Добавляем квадрат для оптимизации
-
-    static bool trySnapItems(QGraphicsScene* scene);
-    static bool checkAndSnapNewItem(QGraphicsItem* newItem, QGraphicsScene* scene);
-
-private:
-    // Оптимизированные helper функции
-    static std::vector<BeamItem*> getBeams(QGraphicsScene* scene);
-    static std::vector<FixedSupportItem*> getSupports(QGraphicsScene* scene);
-    static bool tryConnectBeams(BeamItem* movable, BeamItem* target);
-    static bool tryConnectSupportToBeam(FixedSupportItem* support, BeamItem* beam);
-};
-
-#endif
+#ifndef SETOFELEMENTS_H
+#define SETOFELEMENTS_H
+#include <QGraphicsScene>
+#include <QGraphicsItem>
+#include <QGraphicsLineItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsPathItem>
+#include <QGraphicsTextItem>
+#include <QGraphicsItemGroup>
+#include <QGraphicsSceneContextMenuEvent>
+#include <QStyleOptionGraphicsItem>
+#include <QMenu>
+#include <QInputDialog>
+#include <QPen>
+#include <QBrush>
+#include <QPainterPath>
+#include <QDebug>
+#include <QTimer>
+#include <QObject>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <QPainter>
+#include <QStaticText>
+#include <QFontMetricsF>
+#include "Help.h"
+enum class ElementDirection {
+    Right,
+    Left
+};
+
+struct PointConnector {
+    qreal o_x;
+    qreal o_y;
+
+    PointConnector(qreal x = 0, qreal y = 0) : o_x(x), o_y(y) {}
+
+    // вычисление квадрата расстояния
+    inline qreal distanceSquaredTo(const PointConnector& other) const {
+        qreal dx = o_x - other.o_x;
+        qreal dy = o_y - other.o_y;
+        return dx * dx + dy * dy;
+    }
+
+    bool operator==(PointConnector p_con);
+};
+
+// Отрисовка мелких деталей (зеленые точки, стрелки нагрузок) для больших сцен
+struct RenderDetail {
+    static bool cullSmallDetails;   // включается режимом производительности
+    static qreal minDetailZoom;     // ниже этого масштаба детали не рисуются
+
+    static bool isCulled(qreal zoom) { return cullSmallDetails && zoom < minDetailZoom; }
+    static bool isCulled(const QPainter* painter);
+};
+
+struct IHasConnector {
+    virtual ~IHasConnector() = default;
+    virtual PointConnector getPointConnector() const = 0;
+};
+
+// Предварительные объявления
+class BeamItem;
+class FixedSupportItem;
+
+// Балка
+class BeamItem final : public QGraphicsRectItem, public IHasConnector {
+private:
+    bool m_beingDestroyed = false; // Флаг для предотвращения повторного вызова
+
+    double LenBeam;
+    double cross_sectArea_A;
+    double mod_Elasticity_E;
+    double maxStressBeam_q;
+    double m_gapRight = -1.0;      // зазор у правого конца, м; < 0 — нет зазора
+    double m_thermalExpansion = 0.0; // α, 1/°C
+    double m_deltaT = 0.0;           // ΔT, °C
+    double m_initialStrain = 0.0;    // ε0
+    SectionProfile m_section;        // переменное сечение; постоянное — cross_sectArea_A
+    double m_density = 0.0;          // плотность ρ, кг/м³ (модальный анализ)
+    double m_tangentModulus = 0.0;   // E_t после текучести, Па (упругопластический расчет)
+
+    void updateToolTip();
+public:
+    QGraphicsItem* connectedTo = nullptr;
+
+    BeamItem(qreal x1, qreal y1, qreal length, qreal width);
+    virtual ~BeamItem() override {
+        m_beingDestroyed = true;
+    }
+    PointConnector getPointConnector() const override;
+
+    PointConnector getLeftConnector() const;
+    PointConnector getRightConnector() const;
+    void setConnectedTo(QGraphicsItem* other);
+    void disconnect();
+    void safeDelete(); // Новая безопасная функция удаления
+
+    std::tuple<qreal, qreal> getParams() const { return { _len, _width };  }
+
+    bool isConnected() const { return connectedTo != nullptr; }
+    QGraphicsItem* getConnectedBeam() const { return connectedTo; }
+    bool isBeingDestroyed() const { return m_beingDestroyed; }
+
+    void set_Length(qreal newLength);
+
+    void setInfo(double _cross_sectArea_A, double _mod_Elasticity_E, double _maxStressBeam_q);
+    std::tuple<qreal, qreal> getCoordinates() { 
+        QPointF pos = scenePos();
+        return { pos.x(), pos.y() };
+    
+    }
+    std::tuple<double, double, double, double> getInfo();
+    double getGapRight() const { return m_gapRight; }
+    void setGapRight(double gap);
+    std::tuple<double, double, double> getStrainInfo() const { return { m_thermalExpansion, m_deltaT, m_initialStrain }; }
+    void setStrainInfo(double thermalExpansion, double deltaT, double initialStrain);
+    const SectionProfile& getSection() const { return m_section; }
+    void setSection(const SectionProfile& section);
+    double getDensity() const { return m_density; }
+    void setDensity(double density);
+    double getTangentModulus() const { return m_tangentModulus; }
+    void setTangentModulus(double modulus);
+protected:
+    qreal _ox, _oy, _len, _width;
+    PointConnector pointConnect_left, pointConnect_right;
+
+    // Зеленые точки рисуются в paint самой балки, без дочерних элементов сцены
+    static constexpr qreal GreenPointRadius = 4.0;
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
+};
+
+// Заделка
+class FixedSupportItem final : public QObject, public QGraphicsItemGroup, public IHasConnector {
+    Q_OBJECT
+private:
+    bool m_beingDestroyed = false; // Флаг для предотвращения повторного вызова
+    qreal _ox;
+    qreal _oy;
+    double m_settlement = 0.0;     // заданное перемещение (осадка), м
+    bool m_internal = false;       // промежуточная опора, не занимает левый/правый край
+    double m_stiffness = 0.0;      // жесткость упругой опоры, Н/м; 0 — жесткая заделка
+
+    void updateToolTip();
+
+signals:
+    void supportDeleted(ElementDirection direction);
+public:
+    BeamItem* connectedTo = nullptr;
+
+    FixedSupportItem(qreal x, qreal y, qreal height, ElementDirection dir);
+    virtual ~FixedSupportItem() override {
+        m_beingDestroyed = true;
+    }
+    PointConnector getPointConnector() const override;
+    std::tuple<qreal, qreal, ElementDirection> getInfo() { return{ _ox, _oy, el_d }; }
+    double getSettlement() const { return m_settlement; }
+    void setSettlement(double settlement);
+    bool isInternal() const { return m_internal; }
+    void setInternal(bool internal) { m_internal = internal; }
+    double getStiffness() const { return m_stiffness; }
+    void setStiffness(double stiffness);
+    void setConnectedTo(BeamItem* other);
+    void disconnect();
+    void safeDelete();
+
+    bool isConnected() const { return connectedTo != nullptr; }
+    BeamItem* getConnectedBeam() const { return connectedTo; }
+    bool isBeingDestroyed() const { return m_beingDestroyed; }
+
+protected:
+    ElementDirection el_d;
+    PointConnector pointConnect;
+
+    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
+    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
+};
+
+// Сила
+class ForceItem final : public QGraphicsItem, public IHasConnector {
+
+    qreal len_fr_beam = 0; // длина от начала балки до силы (смещение позиции)
+    qreal force_H = 0;
+    int force_pos_beam = 0;
+    qreal _ox;
+    qreal _oy;
+    double m_offset = 0.0; // смещение от узла вдоль стержня, м (сила внутри пролета)
+    LoadHistory m_history; // множитель f(t) для динамического расчета; пусто — f = 1
+
+    qreal arrowLength = 50.0;
+
+public:
+    ForceItem(qreal x, qreal y, ElementDirection dir,
+        qreal length = 50, const QPen& pen = QPen(Qt::red, 2));
+
+    PointConnector getPointConnector() const override;
+    void set_Len_fr_beam(qreal newLength);
+    void changeDirection(ElementDirection dir);
+    void setForce_H(qreal force_digital, int pos_beam);
+    std::tuple<qreal, qreal, int> getInfo(); // len && force
+    double getOffset() const { return m_offset; }
+    void setOffset(double meters);
+    const LoadHistory& getHistory() const { return m_history; }
+    void setHistory(const LoadHistory& history) { m_history = history; }
+
+protected:
+    ElementDirection el_d;
+    PointConnector pointConnect;
+    QPen m_pen;
+
+    // QGraphicsItem API
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
+};
+
+class LineLoadItem final : public QGraphicsItem, public IHasConnector {
+    qreal start_x1 = 0, stop_y1 = 0;
+   qreal start_x2 = 0, stop_y2 = 0;
+   qreal q_line_load = 0;
+   int _beamDig;
+   double m_spanStart = 0.0;   // участок нагрузки в долях длины стержня
+   double m_spanEnd = 1.0;
+   double m_qEnd = 0.0;        // q в конце участка для трапециевидной нагрузки
+   bool m_uniform = true;      // q постоянна, m_qEnd не используется
+public:
+    LineLoadItem(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2, ElementDirection dir, 
+        const QPen& pen = QPen(Qt::blue, 2));
+    PointConnector getPointConnector() const override;
+
+    void change_loc_joins(qreal ox_1, qreal oy_1, qreal ox_2, qreal oy_2);
+    void set_LineLoad(qreal q_l_load, int beamD);
+    void change_direction(ElementDirection direction);
+    std::tuple<qreal, int> getInfo();
+    std::tuple<double, double, double> getSpan() const; // начало, конец, q в конце
+    void setSpan(double start, double end, double qEnd);
+protected:
+    ElementDirection el_d;
+    QPen m_pen;
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
+
+};
+
+class BeamSign final : public QGraphicsItem {
+    const qreal radius = 12;
+    qreal x_pos, y_pos;
+    
+    int number;
+    const QPen _pen;
+public:
+    
+    BeamSign(qreal _ox, qreal _oy,int numb, const QPen& pen = QPen(Qt::darkCyan, 2));
+
+    void remove();
+protected:
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+};
+
+
+class BeamJoint final : public QGraphicsItem {
+    const qreal square_side = 20;
+    qreal x_pos, y_pos;
+
+    int number;
+    const QPen _pen;
+public:
+
+    BeamJoint(qreal _ox, qreal _oy, int numb, const QPen& pen = QPen(Qt::darkGreen, 2));
+
+    void remove();
+protected:
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+};
+
+class PlotItem : public QGraphicsItem
+{
+private:
+    qreal mX, mY;
+    qreal mLineHeight;
+
+public:
+    PlotItem(qreal x, qreal y, qreal lineHeight = 100.0)
+        : mX(x), mY(y), mLineHeight(lineHeight)
+    {
+        setPos(mX, mY);
+    }
+    void remove();
+    QRectF boundingRect() const override
+    {
+        qreal width = 40;
+        return QRectF(-20, 0, width, mLineHeight + 30);
+    }
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) override;
+};
+
+
+class DiagramItem : public QGraphicsItem {
+private:
+    std::vector<double> m_values;
+    std::vector<double> m_positions; // x / L для каждого значения; пусто — равномерная сетка
+    qreal mX, mY, m_beamLength;
+    QString m_label;
+    int _scaling;
+    bool showLeftLabel = true;   // новое поле
+    bool showRightLabel = true;  // новое поле
+
+    struct DiagramPaths {
+        QPainterPath line;
+        QPainterPath fill;
+    };
+
+    // Геометрия эпюры считается один раз при изменении значений или масштаба
+    DiagramPaths m_paths;
+    QRectF m_bounds;
+
+    // Прореженные пути по корзинам масштаба (полоктавы на корзину)
+    std::unordered_map<int, DiagramPaths> m_lodCache;
+
+    QStaticText m_titleText, m_leftText, m_rightText;
+    QPointF m_titlePos, m_leftPos, m_rightPos;
+    bool m_hasLeftText = false, m_hasRightText = false;
+
+    void rebuildGeometry();
+    DiagramPaths buildPaths(const std::vector<size_t>& indices) const;
+    const DiagramPaths& pathsForLevelOfDetail(qreal lod);
+
+public:
+    DiagramItem(qreal x, qreal y, qreal length,
+        const std::vector<double>& values,
+        const QString& label, int scalingparam,bool left_sign, bool right_sign)
+        : mX(x), mY(y), m_beamLength(length),
+        m_values(values), m_label(label), _scaling(scalingparam), showLeftLabel(left_sign), showRightLabel(right_sign){
+        setPos(mX, mY);
+        setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        rebuildGeometry();
+    }
+
+    void remove();
+    void setValues(const std::vector<double>& values);
+    void setPositions(const std::vector<double>& positions);
+    void setScaling(int scalingparam);
+
+    QRectF boundingRect() const override {
+        return m_bounds;
+    }
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem*,
+        QWidget*) override;
+};
+
+
+class ConnectionManager : public QObject {
+    Q_OBJECT
+public:
+    static const qreal SNAP_DISTANCE;
+    static const qreal SNAP_DISTANCE_SQUARED; // Добавляем квадрат для оптимизации
+
+    static bool trySnapItems(QGraphicsScene* scene);
+    static bool checkAndSnapNewItem(QGraphicsItem* newItem, QGraphicsScene* scene);
+    static int snapAllItems(QGraphicsScene* scene); // один проход по всей сцене
+
+private:
+    // Оптимизированные helper функции
+    static std::vector<BeamItem*> getBeams(QGraphicsScene* scene);
+    static std::vector<FixedSupportItem*> getSupports(QGraphicsScene* scene);
+    static bool tryConnectBeams(BeamItem* movable, BeamItem* target);
+    static bool tryConnectSupportToBeam(FixedSupportItem* support, BeamItem* beam);
+};
+
+#endif
 // SETOFELEMENTS_H
\ No newline at end of file
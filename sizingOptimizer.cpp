@@ -0,0 +1,291 @@
+#include "sizingOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Линейный расчет при заданных площадях: сборка, учет опор, одно разложение
+class SizingAnalysis {
+public:
+    SizingAnalysis(const std::vector<SizingBar>& bars, int numNodes, const std::vector<double>& loads,
+        const std::vector<double>& groundSprings, const std::vector<char>& fixed,
+        const std::vector<double>& prescribed)
+        : m_bars(bars), m_n(numNodes), m_loads(loads), m_springs(groundSprings),
+        m_fixed(fixed), m_prescribed(prescribed), m_builder(numNodes) {}
+
+    double stiffness(int b, const std::vector<double>& areas) const
+    {
+        const SizingBar& bar = m_bars[b];
+        return bar.designable ? bar.modulus * areas[b] / bar.length : bar.stiffness;
+    }
+
+    // Эквивалентные нагрузки концов с парой от ε_T
+    void barLoads(int b, const std::vector<double>& areas, double& left, double& right) const
+    {
+        const SizingBar& bar = m_bars[b];
+        double thermal = bar.designable ? bar.modulus * areas[b] * bar.freeStrain : 0.0;
+        left = bar.loadLeft - thermal;
+        right = bar.loadRight + thermal;
+    }
+
+    void run(const std::vector<double>& areas)
+    {
+        m_builder.reset(m_n);
+        m_builder.reserve(4 * m_bars.size() + m_n);
+        for (int b = 0; b < static_cast<int>(m_bars.size()); ++b) {
+            const SizingBar& bar = m_bars[b];
+            double k = stiffness(b, areas);
+            m_builder.add(bar.nodeLeft, bar.nodeLeft, k);
+            m_builder.add(bar.nodeLeft, bar.nodeRight, -k);
+            m_builder.add(bar.nodeRight, bar.nodeLeft, -k);
+            m_builder.add(bar.nodeRight, bar.nodeRight, k);
+        }
+        for (int i = 0; i < m_n; ++i) {
+            if (m_springs[i] > 0.0) m_builder.add(i, i, m_springs[i]);
+        }
+        m_builder.toCSR(m_K);
+
+        m_F = m_loads;
+        for (int b = 0; b < static_cast<int>(m_bars.size()); ++b) {
+            double left, right;
+            barLoads(b, areas, left, right);
+            m_F[m_bars[b].nodeLeft] += left;
+            m_F[m_bars[b].nodeRight] += right;
+        }
+
+        // Заданные перемещения — в правую часть, строки опор — единичные
+        for (int i = 0; i < m_n; ++i) {
+            for (int k = m_K.rowPtr[i]; k < m_K.rowPtr[i + 1]; ++k) {
+                int j = m_K.colIdx[k];
+                if (!m_fixed[i] && m_fixed[j]) {
+                    m_F[i] -= m_K.values[k] * m_prescribed[j];
+                }
+                if (m_fixed[i] || m_fixed[j]) {
+                    m_K.values[k] = (i == j) ? 1.0 : 0.0;
+                }
+            }
+        }
+        for (int i = 0; i < m_n; ++i) {
+            if (m_fixed[i]) m_F[i] = m_prescribed[i];
+        }
+
+        // Шаблон от площадей не зависит: перестановка считается один раз
+        if (m_perm.empty()) {
+            m_perm = reverseCuthillMcKee(m_K);
+        }
+        m_factor.factorize(m_K, m_perm);
+        m_factor.solve(m_F, m_u);
+    }
+
+    // Сопряженная задача K ψ = e_node
+    void adjoint(int node, std::vector<double>& psi) const
+    {
+        std::vector<double> e(m_n, 0.0);
+        e[node] = 1.0;
+        m_factor.solve(e, psi);
+    }
+
+    const std::vector<double>& displacements() const { return m_u; }
+
+private:
+    const std::vector<SizingBar>& m_bars;
+    int m_n;
+    const std::vector<double>& m_loads;
+    const std::vector<double>& m_springs;
+    const std::vector<char>& m_fixed;
+    const std::vector<double>& m_prescribed;
+
+    SparseBuilder m_builder;
+    SparseMatrix m_K;
+    std::vector<int> m_perm;
+    SkylineCholesky m_factor;
+    std::vector<double> m_F;
+    std::vector<double> m_u;
+};
+
+// Выпуклое приближение ограничения: g ≈ g0 + Σ p_b·(A_b - A0_b) + Σ c_b·(1/A_b - 1/A0_b),
+// p — положительные производные, c = -dg/dA·A0² — от отрицательных
+struct ConvexConstraint {
+    double value;
+    std::vector<double> linear;
+    std::vector<double> reciprocal;
+};
+
+} // namespace
+
+std::vector<double> optimizeSections(const std::vector<SizingBar>& bars, int numNodes,
+    const std::vector<double>& loads, const std::vector<double>& groundSprings,
+    const std::vector<char>& fixed, const std::vector<double>& prescribed,
+    const SizingOptions& options, SizingReport& report)
+{
+    const int numBars = static_cast<int>(bars.size());
+    report = SizingReport();
+
+    std::vector<double> areas(numBars);
+    double largest = 0.0;
+    for (int b = 0; b < numBars; ++b) {
+        areas[b] = bars[b].area;
+        largest = std::max(largest, bars[b].area);
+        if (bars[b].designable && !(bars[b].area > 0.0)) {
+            throw std::runtime_error("Bar area must be positive");
+        }
+    }
+    const double maxArea = options.maxArea > 0.0 ? options.maxArea : 1000.0 * largest;
+    std::vector<DisplacementLimit> limits;
+    for (const DisplacementLimit& limit : options.displacementLimits) {
+        if (limit.node < 0 || limit.node >= numNodes) {
+            throw std::runtime_error("Displacement limit node is out of range");
+        }
+        if (!(limit.limit > 0.0)) {
+            throw std::runtime_error("Displacement limit must be positive");
+        }
+        if (!fixed[limit.node]) limits.push_back(limit);
+    }
+    const int m = static_cast<int>(limits.size());
+
+    auto volumeOf = [&](const std::vector<double>& a) {
+        double volume = 0.0;
+        for (int b = 0; b < numBars; ++b) volume += a[b] * bars[b].length;
+        return volume;
+    };
+    report.initialVolume = volumeOf(areas);
+
+    SizingAnalysis analysis(bars, numNodes, loads, groundSprings, fixed, prescribed);
+    std::vector<double> stressRatio(numBars), elongation(numBars), psi;
+    std::vector<ConvexConstraint> constraints(m);
+    std::vector<double> lower(numBars), upper(numBars), next(numBars);
+
+    // Анализ текущего проекта: напряжения по концам стержня (N меняется
+    // по длине от пролетных нагрузок), N(0) = kΔ + F_left, N(L) = kΔ - F_right
+    auto analyse = [&](double& maxStress, double& maxDisplacement) {
+        analysis.run(areas);
+        report.factorizations++;
+        const std::vector<double>& u = analysis.displacements();
+        maxStress = 0.0;
+        for (int b = 0; b < numBars; ++b) {
+            const SizingBar& bar = bars[b];
+            elongation[b] = u[bar.nodeRight] - u[bar.nodeLeft];
+            stressRatio[b] = 0.0;
+            if (!bar.designable || bar.allowableStress <= 0.0) continue;
+            double left, right;
+            analysis.barLoads(b, areas, left, right);
+            double k = analysis.stiffness(b, areas);
+            double N = std::max(std::abs(k * elongation[b] + left), std::abs(k * elongation[b] - right));
+            stressRatio[b] = N / (areas[b] * bar.allowableStress);
+            maxStress = std::max(maxStress, stressRatio[b]);
+        }
+        maxDisplacement = 0.0;
+        for (const DisplacementLimit& limit : limits) {
+            maxDisplacement = std::max(maxDisplacement, std::abs(u[limit.node]) / limit.limit);
+        }
+    };
+
+    for (int iteration = 0; iteration < options.maxIterations; ++iteration) {
+        double maxStress, maxDisplacement;
+        analyse(maxStress, maxDisplacement);
+        const std::vector<double>& u = analysis.displacements();
+
+        // Границы подзадачи: шаг площади и усилие, замороженное на итерацию
+        for (int b = 0; b < numBars; ++b) {
+            if (!bars[b].designable) continue;
+            lower[b] = std::max(options.minArea, areas[b] * (1.0 - options.moveLimit));
+            upper[b] = std::max(lower[b], std::min(maxArea, areas[b] * (1.0 + options.moveLimit)));
+            lower[b] = std::max(lower[b], std::min(upper[b], areas[b] * stressRatio[b]));
+        }
+
+        // Производные перемещений по всем площадям — по одному сопряженному решению
+        for (int i = 0; i < m; ++i) {
+            ConvexConstraint& g = constraints[i];
+            double ui = u[limits[i].node];
+            double sign = ui >= 0.0 ? 1.0 : -1.0;
+            g.value = std::abs(ui) / limits[i].limit - 1.0;
+            g.linear.assign(numBars, 0.0);
+            g.reciprocal.assign(numBars, 0.0);
+            analysis.adjoint(limits[i].node, psi);
+            report.adjointSolves++;
+            for (int b = 0; b < numBars; ++b) {
+                const SizingBar& bar = bars[b];
+                if (!bar.designable) continue;
+                double dudA = (psi[bar.nodeRight] - psi[bar.nodeLeft])
+                    * (bar.modulus * bar.freeStrain - bar.modulus / bar.length * elongation[b]);
+                double derivative = sign * dudA / limits[i].limit;
+                if (derivative >= 0.0) g.linear[b] = derivative;
+                else g.reciprocal[b] = -derivative * areas[b] * areas[b];
+            }
+        }
+
+        // Минимум лагранжиана по каждой площади при множителях mu
+        std::vector<double> mu(m, 0.0);
+        auto primal = [&]() {
+            for (int b = 0; b < numBars; ++b) {
+                if (!bars[b].designable) {
+                    next[b] = areas[b];
+                    continue;
+                }
+                double numerator = 0.0, denominator = bars[b].length;
+                for (int i = 0; i < m; ++i) {
+                    numerator += mu[i] * constraints[i].reciprocal[b];
+                    denominator += mu[i] * constraints[i].linear[b];
+                }
+                double a = numerator > 0.0 ? std::sqrt(numerator / denominator) : lower[b];
+                next[b] = std::clamp(a, lower[b], upper[b]);
+            }
+        };
+        auto approximation = [&](int i) {
+            const ConvexConstraint& g = constraints[i];
+            double value = g.value;
+            for (int b = 0; b < numBars; ++b) {
+                if (!bars[b].designable) continue;
+                value += g.linear[b] * (next[b] - areas[b]);
+                value += g.reciprocal[b] * (1.0 / next[b] - 1.0 / areas[b]);
+            }
+            return value;
+        };
+
+        // Двойственная задача: приближение g_i убывает по mu_i, множители
+        // подбираются бисекцией по очереди
+        for (int sweep = 0; sweep < (m > 1 ? 30 : 1); ++sweep) {
+            for (int i = 0; i < m; ++i) {
+                mu[i] = 0.0;
+                primal();
+                if (approximation(i) <= 0.0) continue;
+                double lo = 0.0, hi = 1.0;
+                for (int grow = 0; grow < 200; ++grow) {
+                    mu[i] = hi;
+                    primal();
+                    if (approximation(i) <= 0.0) break;
+                    lo = hi;
+                    hi *= 4.0;
+                }
+                for (int step = 0; step < 60 && hi - lo > 1e-12 * hi; ++step) {
+                    mu[i] = 0.5 * (lo + hi);
+                    primal();
+                    (approximation(i) > 0.0 ? lo : hi) = mu[i];
+                }
+                mu[i] = hi;
+            }
+        }
+        primal();
+
+        double maxChange = 0.0;
+        for (int b = 0; b < numBars; ++b) {
+            maxChange = std::max(maxChange, std::abs(next[b] - areas[b]) / areas[b]);
+        }
+        report.history.push_back({ volumeOf(areas), maxStress, maxDisplacement, maxChange });
+
+        bool feasible = maxStress <= 1.0 + options.feasibility && maxDisplacement <= 1.0 + options.feasibility;
+        if (feasible && maxChange <= options.tolerance) {
+            report.converged = true;
+            break;
+        }
+        areas.swap(next);
+    }
+
+    double maxStress, maxDisplacement;
+    analyse(maxStress, maxDisplacement);
+    report.volume = volumeOf(areas);
+    report.stressRatios = stressRatio;
+    report.displacements = analysis.displacements();
+    return areas;
+}
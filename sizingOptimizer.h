@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+
+// Стержень в подборе сечений. У проектного стержня k = E·A/L, эквивалентные
+// нагрузки loadLeft/loadRight (от q и сил в пролете) от A не зависят, а ε_T
+// дает пару ∓E·A·ε_T. У непроектного (переменное сечение) A не меняется:
+// stiffness, loadLeft/loadRight — готовые, с ε_T
+struct SizingBar {
+    int nodeLeft;
+    int nodeRight;
+    double length;
+    double modulus;
+    double area;
+    double allowableStress;  // σ_max; <= 0 — без проверки
+    double loadLeft;
+    double loadRight;
+    double freeStrain;
+    bool designable = true;
+    double stiffness = 0.0;  // только для непроектного
+};
+
+// Ограничение перемещения |u_node| <= limit
+struct DisplacementLimit {
+    int node;
+    double limit;
+};
+
+struct SizingOptions {
+    double minArea = 1e-6;
+    double maxArea = 0.0;         // 0 — 1000 наибольших исходных
+    double moveLimit = 0.5;       // за итерацию A меняется не больше чем в (1 ± moveLimit) раз
+    int maxIterations = 200;
+    double tolerance = 1e-4;      // относительное изменение площадей
+    double feasibility = 1e-6;    // допустимое превышение ограничений
+    std::vector<DisplacementLimit> displacementLimits;
+};
+
+struct SizingIteration {
+    double volume;
+    double maxStressRatio;        // max |σ| / σ_max
+    double maxDisplacementRatio;  // max |u| / limit
+    double maxChange;             // max |ΔA| / A
+};
+
+struct SizingReport {
+    bool converged = false;
+    double initialVolume = 0.0;
+    double volume = 0.0;
+    std::vector<SizingIteration> history;
+    int factorizations = 0;
+    int adjointSolves = 0;
+    std::vector<double> stressRatios;      // по стержням в итоговом проекте
+    std::vector<double> displacements;     // итоговые перемещения узлов
+};
+
+// Минимум объема Σ A·L при |σ| <= σ_max в каждом проектном стержне и
+// ограничениях перемещений. Последовательные выпуклые приближения (CONLIN):
+// на каждой итерации одно разложение K; производные перемещений по всем
+// площадям — одним сопряженным решением K ψ = e_node на ограничение,
+// du/dA_b = -(E/L)·(ψ_r - ψ_l)·(Δ_b - ε_T·L). Напряжение стержня
+// приближается при неизменном усилии, σ ~ 1/A, — точно для статически
+// определимых систем; перераспределение усилий учитывается пересчетом.
+// Подзадача сепарабельна и решается через двойственные множители.
+// groundSprings — жесткости пружин по узлам, loads — узловые силы;
+// возвращает площади (у непроектных — исходные)
+std::vector<double> optimizeSections(const std::vector<SizingBar>& bars, int numNodes,
+    const std::vector<double>& loads, const std::vector<double>& groundSprings,
+    const std::vector<char>& fixed, const std::vector<double>& prescribed,
+    const SizingOptions& options, SizingReport& report);
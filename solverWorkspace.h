@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+#include "Help.h"
+#include "sparseSolver.h"
+#include "tridiagSolver.h"
+#include "contactSolver.h"
+#include "modalSolver.h"
+
+// Опорные узлы с заданными перемещениями. Исходные строки A и нагрузки
+// сохраняются до исключения, по ним после решения считаются реакции
+struct SupportConstraints {
+    std::vector<int> nodes;
+    std::vector<double> values;       // заданное перемещение узла
+    std::vector<double> loads;        // внешняя узловая нагрузка
+    std::vector<int> rowPtr;          // исходные строки A в формате CSR
+    std::vector<int> cols;
+    std::vector<double> coeffs;
+    std::vector<double> reactions;    // R = A_c * Δ - F_c
+    double totalLoad = 0.0;           // сумма всех узловых нагрузок
+
+    // Упругие опоры: реакция пружины R = -k * Δ
+    std::vector<int> springNodes;
+    std::vector<double> springStiffness;
+    std::vector<double> springReactions;
+};
+
+// Буферы всех этапов расчета: сборки, решения и пост-процессора.
+// Экземпляр принадлежит процессору, расчеты которого идут по одному; при
+// повторных расчетах модели того же размера векторы сохраняют емкость
+// и память не выделяется
+struct SolverWorkspace {
+    // Сборка
+    SparseBuilder builder;
+    SparseMatrix A;
+    std::vector<double> B;
+    std::vector<char> forceApplied;   // узлы, сила в которых уже учтена
+    std::vector<char> springApplied;  // узлы, пружина в которых уже учтена
+    std::vector<char> fixedNodes;     // узлы с заделкой
+    std::vector<double> prescribed;   // заданные перемещения по узлам
+    SupportConstraints constraints;
+    std::vector<GapElement> gaps;     // контактные элементы (зазоры)
+    std::vector<double> nodeStiffness; // наибольшая жесткость стержня в узле, для штрафа зазоров
+    ContactReport contact;
+
+    // Решение
+    std::vector<double> deltas;
+    TridiagonalMatrix chain;
+    std::vector<double> sweep;        // прогоночные коэффициенты
+
+    // Модальный анализ: матрица масс и трехдиагональная пара по свободным узлам
+    SparseMatrix M;
+    TridiagonalMatrix chainMass;
+    std::vector<int> modalNodes;      // строка пары -> исходный узел
+
+    // Прямой решатель: перестановка RCM пересчитывается только при смене шаблона
+    SkylineCholesky cholesky;
+    std::vector<int> perm;
+    std::vector<int> patternRowPtr;
+    std::vector<int> patternColIdx;
+
+    // Пост-процессор
+    std::vector<double> range;
+    std::vector<BeamResults> results;
+
+    // true, если шаблон A совпадает с прошлым расчетом; иначе запоминает новый
+    bool samePattern(const SparseMatrix& matrix)
+    {
+        if (matrix.rowPtr == patternRowPtr && matrix.colIdx == patternColIdx) {
+            return true;
+        }
+        patternRowPtr.assign(matrix.rowPtr.begin(), matrix.rowPtr.end());
+        patternColIdx.assign(matrix.colIdx.begin(), matrix.colIdx.end());
+        return false;
+    }
+};
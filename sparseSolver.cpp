@@ -0,0 +1,814 @@
+#include "sparseSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <QtConcurrent>
+
+// ==================== CSR ====================
+
+double SparseMatrix::at(int row, int col) const
+{
+    auto begin = colIdx.begin() + rowPtr[row];
+    auto end = colIdx.begin() + rowPtr[row + 1];
+    auto it = std::lower_bound(begin, end, col);
+    if (it == end || *it != col) return 0.0;
+    return values[it - colIdx.begin()];
+}
+
+double* SparseMatrix::find(int row, int col)
+{
+    auto begin = colIdx.begin() + rowPtr[row];
+    auto end = colIdx.begin() + rowPtr[row + 1];
+    auto it = std::lower_bound(begin, end, col);
+    if (it == end || *it != col) return nullptr;
+    return &values[it - colIdx.begin()];
+}
+
+void SparseMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const
+{
+    y.assign(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k) {
+            sum += values[k] * x[colIdx[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+// Делит [0, n) на блоки по числу потоков пула и выполняет их параллельно;
+// маленькие диапазоны считаются в вызывающем потоке
+template <typename Func>
+static void parallelRanges(int n, Func func)
+{
+    const int minBlock = 16384;
+    const int threads = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    const int blocks = std::min(threads, std::max(1, n / minBlock));
+
+    if (blocks == 1) {
+        func(0, n);
+        return;
+    }
+
+    std::vector<int> blockIds(blocks);
+    std::iota(blockIds.begin(), blockIds.end(), 0);
+    QtConcurrent::blockingMap(blockIds, [&](int block) {
+        int begin = static_cast<int>(static_cast<long long>(n) * block / blocks);
+        int end = static_cast<int>(static_cast<long long>(n) * (block + 1) / blocks);
+        func(begin, end);
+        });
+}
+
+void SparseMatrix::multiplyParallel(const std::vector<double>& x, std::vector<double>& y) const
+{
+    y.resize(n);
+    parallelRanges(n, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            double sum = 0.0;
+            for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k) {
+                sum += values[k] * x[colIdx[k]];
+            }
+            y[i] = sum;
+        }
+        });
+}
+
+// ==================== COO -> CSR ====================
+
+SparseBuilder::SparseBuilder(int n) : m_n(n)
+{
+    if (n < 0) {
+        throw std::invalid_argument("Matrix size must be non-negative");
+    }
+}
+
+void SparseBuilder::reset(int n)
+{
+    if (n < 0) {
+        throw std::invalid_argument("Matrix size must be non-negative");
+    }
+    m_n = n;
+    m_entries.clear();
+}
+
+void SparseBuilder::add(int row, int col, double value)
+{
+    if (row < 0 || row >= m_n || col < 0 || col >= m_n) {
+        throw std::out_of_range("Sparse entry is outside of the matrix");
+    }
+    m_entries.push_back({ row, col, value });
+}
+
+SparseMatrix SparseBuilder::toCSR() const
+{
+    SparseMatrix A;
+    std::vector<int> count, fill;
+    std::vector<std::pair<int, double>> byRow;
+    buildCSR(m_n, m_entries, count, fill, byRow, A);
+    return A;
+}
+
+void SparseBuilder::toCSR(SparseMatrix& A)
+{
+    buildCSR(m_n, m_entries, m_count, m_fill, m_byRow, A);
+}
+
+void SparseBuilder::buildCSR(int n, const std::vector<Entry>& entries, std::vector<int>& count,
+    std::vector<int>& fill, std::vector<std::pair<int, double>>& byRow, SparseMatrix& A)
+{
+    A.n = n;
+
+    // Раскладываем элементы по строкам (сортировка подсчетом)
+    count.assign(n + 1, 0);
+    for (const Entry& e : entries) {
+        count[e.row + 1]++;
+    }
+    for (int i = 0; i < n; ++i) {
+        count[i + 1] += count[i];
+    }
+
+    byRow.resize(entries.size());
+    fill.assign(count.begin(), count.end() - 1);
+    for (const Entry& e : entries) {
+        byRow[fill[e.row]++] = { e.col, e.value };
+    }
+
+    // Внутри строки упорядочиваем по столбцу и суммируем повторы
+    A.rowPtr.assign(n + 1, 0);
+    A.colIdx.clear();
+    A.values.clear();
+    A.colIdx.reserve(entries.size());
+    A.values.reserve(entries.size());
+
+    for (int i = 0; i < n; ++i) {
+        auto begin = byRow.begin() + count[i];
+        auto end = byRow.begin() + count[i + 1];
+        std::sort(begin, end, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (auto it = begin; it != end; ++it) {
+            if (static_cast<int>(A.colIdx.size()) > A.rowPtr[i] && A.colIdx.back() == it->first) {
+                A.values.back() += it->second;
+            }
+            else {
+                A.colIdx.push_back(it->first);
+                A.values.push_back(it->second);
+            }
+        }
+        A.rowPtr[i + 1] = static_cast<int>(A.colIdx.size());
+    }
+}
+
+// ==================== RCM ====================
+
+// Обход в ширину от start; возвращает последний уровень и глубину
+static int bfsLevels(const SparseMatrix& A, int start, std::vector<int>& level,
+    std::vector<int>& lastLevel)
+{
+    std::fill(level.begin(), level.end(), -1);
+    std::queue<int> queue;
+    queue.push(start);
+    level[start] = 0;
+    int depth = 0;
+    lastLevel.assign(1, start);
+
+    while (!queue.empty()) {
+        int v = queue.front();
+        queue.pop();
+        for (int k = A.rowPtr[v]; k < A.rowPtr[v + 1]; ++k) {
+            int u = A.colIdx[k];
+            if (level[u] >= 0) continue;
+            level[u] = level[v] + 1;
+            if (level[u] > depth) {
+                depth = level[u];
+                lastLevel.clear();
+            }
+            if (level[u] == depth) lastLevel.push_back(u);
+            queue.push(u);
+        }
+    }
+    return depth;
+}
+
+std::vector<int> reverseCuthillMcKee(const SparseMatrix& A)
+{
+    const int n = A.n;
+    std::vector<int> degree(n);
+    for (int i = 0; i < n; ++i) {
+        degree[i] = A.rowPtr[i + 1] - A.rowPtr[i];
+    }
+
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+    std::vector<int> level(n, -1);
+    std::vector<int> lastLevel;
+    std::vector<int> neighbours;
+
+    for (int seed = 0; seed < n; ++seed) {
+        if (visited[seed]) continue;
+
+        // Псевдопериферийная вершина компоненты: уходим на самый дальний уровень,
+        // пока глубина обхода растет
+        int start = seed;
+        int depth = bfsLevels(A, start, level, lastLevel);
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            int candidate = *std::min_element(lastLevel.begin(), lastLevel.end(),
+                [&degree](int a, int b) { return degree[a] < degree[b]; });
+            int candidateDepth = bfsLevels(A, candidate, level, lastLevel);
+            if (candidateDepth <= depth) break;
+            start = candidate;
+            depth = candidateDepth;
+        }
+
+        // Катхилл — Макки: соседи в порядке возрастания степени
+        size_t head = order.size();
+        order.push_back(start);
+        visited[start] = 1;
+        while (head < order.size()) {
+            int v = order[head++];
+            neighbours.clear();
+            for (int k = A.rowPtr[v]; k < A.rowPtr[v + 1]; ++k) {
+                int u = A.colIdx[k];
+                if (!visited[u]) {
+                    visited[u] = 1;
+                    neighbours.push_back(u);
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end(),
+                [&degree](int a, int b) { return degree[a] < degree[b]; });
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// ==================== Профильный Холецкий ====================
+
+template <typename Real>
+void BasicSkylineCholesky<Real>::factorize(const SparseMatrix& A, const std::vector<int>& perm)
+{
+    m_n = A.n;
+    m_perm = perm;
+    if (static_cast<int>(m_perm.size()) != m_n) {
+        throw std::invalid_argument("Permutation size does not match the matrix");
+    }
+
+    m_inverse.resize(m_n);
+    for (int i = 0; i < m_n; ++i) {
+        m_inverse[m_perm[i]] = i;
+    }
+
+    // Профиль: первый ненулевой столбец каждой строки в новой нумерации
+    m_first.assign(m_n, 0);
+    m_rowStart.assign(m_n + 1, 0);
+    for (int i = 0; i < m_n; ++i) {
+        int old = m_perm[i];
+        int first = i;
+        for (int k = A.rowPtr[old]; k < A.rowPtr[old + 1]; ++k) {
+            first = std::min(first, m_inverse[A.colIdx[k]]);
+        }
+        m_first[i] = first;
+        m_rowStart[i + 1] = m_rowStart[i] + (i - first + 1);
+    }
+
+    m_values.assign(m_rowStart[m_n], Real(0));
+    m_diagonal.resize(m_n);
+    for (int i = 0; i < m_n; ++i) {
+        int old = m_perm[i];
+        for (int k = A.rowPtr[old]; k < A.rowPtr[old + 1]; ++k) {
+            int j = m_inverse[A.colIdx[k]];
+            if (j <= i) {
+                L(i, j) += static_cast<Real>(A.values[k]);
+            }
+        }
+        m_diagonal[i] = L(i, i);
+    }
+
+    // Построчное разложение: скалярные произведения по непрерывным участкам профиля
+    for (int i = 0; i < m_n; ++i) {
+        const int fi = m_first[i];
+        Real* rowI = &m_values[m_rowStart[i]];
+
+        for (int j = fi; j < i; ++j) {
+            const int fj = m_first[j];
+            const Real* rowJ = &m_values[m_rowStart[j]];
+            const int k0 = std::max(fi, fj);
+
+            Real sum = rowI[j - fi];
+            for (int k = k0; k < j; ++k) {
+                sum -= rowI[k - fi] * rowJ[k - fj];
+            }
+            rowI[j - fi] = sum / rowJ[j - fj];
+        }
+
+        Real d = rowI[i - fi];
+        for (int k = fi; k < i; ++k) {
+            d -= rowI[k - fi] * rowI[k - fi];
+        }
+
+        // Проверка вырожденности относительно исходной диагонали; для float
+        // порог грубее — после потери пяти порядков у ведущего элемента не
+        // остается верных цифр
+        const double relativeTolerance = std::is_same_v<Real, float> ? 1e-5 : 1e-12;
+        const double tinyPivot = std::is_same_v<Real, float> ? 1e-30 : 1e-300;
+        if (!(d > relativeTolerance * std::abs(m_diagonal[i])) || d < tinyPivot) {
+            throw std::runtime_error("Matrix is singular");
+        }
+        rowI[i - fi] = std::sqrt(d);
+    }
+
+    // Решение с тем же разложением повторяется много раз (шаги по времени),
+    // деление в цепочке зависимостей заметно дороже умножения
+    m_inverseDiagonal.resize(m_n);
+    for (int i = 0; i < m_n; ++i) {
+        m_inverseDiagonal[i] = Real(1) / m_values[m_rowStart[i] + (i - m_first[i])];
+    }
+}
+
+template <typename Real>
+std::vector<double> BasicSkylineCholesky<Real>::solve(const std::vector<double>& b) const
+{
+    std::vector<double> x;
+    solve(b, x);
+    return x;
+}
+
+template <typename Real>
+void BasicSkylineCholesky<Real>::solve(const std::vector<double>& b, std::vector<double>& x) const
+{
+    if (static_cast<int>(b.size()) != m_n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+
+    std::vector<Real>& z = m_work;
+    z.resize(m_n);
+    for (int i = 0; i < m_n; ++i) {
+        z[i] = static_cast<Real>(b[m_perm[i]]);
+    }
+
+    // Прямой ход: L*z = P*b
+    for (int i = 0; i < m_n; ++i) {
+        const int fi = m_first[i];
+        const Real* rowI = &m_values[m_rowStart[i]];
+        Real sum = z[i];
+        for (int k = fi; k < i; ++k) {
+            sum -= rowI[k - fi] * z[k];
+        }
+        z[i] = sum * m_inverseDiagonal[i];
+    }
+
+    // Обратный ход: L^T*x = z, по столбцам L^T (строкам L)
+    for (int i = m_n - 1; i >= 0; --i) {
+        const int fi = m_first[i];
+        const Real* rowI = &m_values[m_rowStart[i]];
+        z[i] *= m_inverseDiagonal[i];
+        for (int k = fi; k < i; ++k) {
+            z[k] -= rowI[k - fi] * z[i];
+        }
+    }
+
+    x.resize(m_n);
+    for (int i = 0; i < m_n; ++i) {
+        x[m_perm[i]] = z[i];
+    }
+}
+
+template class BasicSkylineCholesky<double>;
+template class BasicSkylineCholesky<float>;
+
+std::vector<double> solveDense(std::vector<double> M, std::vector<double> rhs, int m, double minPivot)
+{
+    for (int col = 0; col < m; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < m; ++row) {
+            if (std::abs(M[row * m + col]) > std::abs(M[pivot * m + col])) pivot = row;
+        }
+        if (std::abs(M[pivot * m + col]) < minPivot) {
+            throw std::runtime_error("Matrix is singular");
+        }
+        if (pivot != col) {
+            for (int k = 0; k < m; ++k) std::swap(M[col * m + k], M[pivot * m + k]);
+            std::swap(rhs[col], rhs[pivot]);
+        }
+        for (int row = col + 1; row < m; ++row) {
+            double factor = M[row * m + col] / M[col * m + col];
+            if (factor == 0.0) continue;
+            for (int k = col; k < m; ++k) M[row * m + k] -= factor * M[col * m + k];
+            rhs[row] -= factor * rhs[col];
+        }
+    }
+    for (int row = m - 1; row >= 0; --row) {
+        double sum = rhs[row];
+        for (int k = row + 1; k < m; ++k) sum -= M[row * m + k] * rhs[k];
+        rhs[row] = sum / M[row * m + row];
+    }
+    return rhs;
+}
+
+// ==================== PCG ====================
+
+// Неполное разложение Холецкого IC(0): L имеет шаблон нижнего треугольника A.
+// При потере положительности диагональ сдвигается (A + alpha*diag(A))
+class IncompleteCholesky {
+public:
+    explicit IncompleteCholesky(const SparseMatrix& A)
+    {
+        const int n = A.n;
+        m_rowPtr.assign(n + 1, 0);
+        for (int i = 0; i < n; ++i) {
+            int count = 0;
+            for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1] && A.colIdx[k] <= i; ++k) {
+                count++;
+            }
+            m_rowPtr[i + 1] = m_rowPtr[i] + count;
+        }
+        m_colIdx.resize(m_rowPtr[n]);
+        m_values.resize(m_rowPtr[n]);
+
+        for (double alpha = 0.0; ; alpha = (alpha == 0.0) ? 1e-3 : alpha * 10.0) {
+            if (alpha > 1.0) {
+                throw std::runtime_error("Incomplete Cholesky breakdown");
+            }
+            if (tryFactorize(A, alpha)) break;
+        }
+    }
+
+    // z = (L*L^T)^-1 * r
+    void apply(const std::vector<double>& r, std::vector<double>& z) const
+    {
+        const int n = static_cast<int>(m_rowPtr.size()) - 1;
+        z = r;
+        for (int i = 0; i < n; ++i) {
+            double sum = z[i];
+            int diag = m_rowPtr[i + 1] - 1;
+            for (int k = m_rowPtr[i]; k < diag; ++k) {
+                sum -= m_values[k] * z[m_colIdx[k]];
+            }
+            z[i] = sum / m_values[diag];
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            int diag = m_rowPtr[i + 1] - 1;
+            z[i] /= m_values[diag];
+            for (int k = m_rowPtr[i]; k < diag; ++k) {
+                z[m_colIdx[k]] -= m_values[k] * z[i];
+            }
+        }
+    }
+
+private:
+    std::vector<int> m_rowPtr;
+    std::vector<int> m_colIdx;    // диагональ — последний элемент строки
+    std::vector<double> m_values;
+
+    bool tryFactorize(const SparseMatrix& A, double alpha)
+    {
+        const int n = A.n;
+        for (int i = 0; i < n; ++i) {
+            int dst = m_rowPtr[i];
+            for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1] && A.colIdx[k] <= i; ++k) {
+                m_colIdx[dst] = A.colIdx[k];
+                m_values[dst] = A.values[k] * ((A.colIdx[k] == i) ? 1.0 + alpha : 1.0);
+                dst++;
+            }
+            if (dst == m_rowPtr[i] || m_colIdx[dst - 1] != i) {
+                return false; // нет диагонали
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const int diagI = m_rowPtr[i + 1] - 1;
+            for (int p = m_rowPtr[i]; p < diagI; ++p) {
+                const int j = m_colIdx[p];
+                const int diagJ = m_rowPtr[j + 1] - 1;
+
+                // Скалярное произведение строк i и j по общим столбцам < j
+                double sum = m_values[p];
+                int a = m_rowPtr[i], b = m_rowPtr[j];
+                while (a < p && b < diagJ) {
+                    if (m_colIdx[a] == m_colIdx[b]) sum -= m_values[a++] * m_values[b++];
+                    else if (m_colIdx[a] < m_colIdx[b]) a++;
+                    else b++;
+                }
+                m_values[p] = sum / m_values[diagJ];
+            }
+
+            double d = m_values[diagI];
+            for (int p = m_rowPtr[i]; p < diagI; ++p) {
+                d -= m_values[p] * m_values[p];
+            }
+            if (!(d > 0.0)) return false;
+            m_values[diagI] = std::sqrt(d);
+        }
+        return true;
+    }
+};
+
+static double dotProduct(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+std::vector<double> solvePCG(const SparseMatrix& A, const std::vector<double>& b,
+    const PcgOptions& options, PcgReport& report)
+{
+    const int n = A.n;
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+
+    report = PcgReport();
+    std::vector<double> x(n, 0.0);
+
+    const double normB = std::sqrt(dotProduct(b, b));
+    if (normB == 0.0) {
+        report.converged = true;
+        return x;
+    }
+
+    // Предобусловливатель
+    std::vector<double> inverseDiagonal;
+    std::unique_ptr<IncompleteCholesky> ic;
+    if (options.preconditioner == Preconditioner::Jacobi) {
+        inverseDiagonal.resize(n);
+        for (int i = 0; i < n; ++i) {
+            double d = A.at(i, i);
+            if (!(d > 0.0)) {
+                throw std::runtime_error("Matrix is not positive definite");
+            }
+            inverseDiagonal[i] = 1.0 / d;
+        }
+    }
+    else {
+        ic = std::make_unique<IncompleteCholesky>(A);
+    }
+
+    auto precondition = [&](const std::vector<double>& r, std::vector<double>& z) {
+        if (ic) {
+            ic->apply(r, z);
+            return;
+        }
+        z.resize(n);
+        parallelRanges(n, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                z[i] = inverseDiagonal[i] * r[i];
+            }
+            });
+    };
+
+    std::vector<double> r = b;
+    std::vector<double> z, p, Ap;
+    precondition(r, z);
+    p = z;
+    double rz = dotProduct(r, z);
+
+    const int maxIterations = (options.maxIterations > 0) ? options.maxIterations : n;
+
+    for (int iter = 1; iter <= maxIterations; ++iter) {
+        A.multiplyParallel(p, Ap);
+
+        double pAp = dotProduct(p, Ap);
+        if (!(pAp > 0.0)) {
+            throw std::runtime_error("Matrix is not positive definite");
+        }
+        double alpha = rz / pAp;
+
+        double rr = 0.0;
+        for (int i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+            rr += r[i] * r[i];
+        }
+
+        report.iterations = iter;
+        report.relativeResidual = std::sqrt(rr) / normB;
+        if (options.keepHistory) {
+            report.residualHistory.push_back(report.relativeResidual);
+        }
+        if (report.relativeResidual <= options.tolerance) {
+            report.converged = true;
+            break;
+        }
+
+        precondition(r, z);
+        double rzNew = dotProduct(r, z);
+        double beta = rzNew / rz;
+        rz = rzNew;
+        for (int i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+
+    return x;
+}
+
+// ==================== Режим точности ====================
+
+// b - A x с удвоенной точностью: ошибка каждого произведения находится
+// через fma, ошибка каждого сложения — через TwoSum (Огита — Рамп — Оиси)
+static void accurateResidual(const SparseMatrix& A, const std::vector<double>& x,
+    const std::vector<double>& b, std::vector<double>& r)
+{
+    r.resize(A.n);
+    for (int i = 0; i < A.n; ++i) {
+        double sum = b[i];
+        double error = 0.0;
+        for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+            double product = A.values[k] * x[A.colIdx[k]];
+            double productError = std::fma(A.values[k], x[A.colIdx[k]], -product);
+            double next = sum - product;
+            double bv = next - sum;
+            error += ((sum - (next - bv)) + (-product - bv)) - productError;
+            sum = next;
+        }
+        r[i] = sum + error;
+    }
+}
+
+static double normInf(const std::vector<double>& v)
+{
+    double norm = 0.0;
+    for (double value : v) {
+        norm = std::max(norm, std::abs(value));
+    }
+    return norm;
+}
+
+// ||A||_1; для симметричной матрицы равна максимальной сумме по строке
+static double norm1(const SparseMatrix& A)
+{
+    double norm = 0.0;
+    for (int i = 0; i < A.n; ++i) {
+        double sum = 0.0;
+        for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+            sum += std::abs(A.values[k]);
+        }
+        norm = std::max(norm, sum);
+    }
+    return norm;
+}
+
+// Оценка ||A^-1||_1 по Хейгеру — Хайему для симметричной A:
+// несколько решений с готовым разложением вместо обращения
+template <typename ApplyInverse>
+static double estimateInverseNorm1(int n, ApplyInverse applyInverse)
+{
+    std::vector<double> x(n, 1.0 / n), y, z, sign(n);
+    double estimate = 0.0;
+    int lastIndex = -1;
+
+    for (int iter = 0; iter < 5; ++iter) {
+        applyInverse(x, y);
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i) {
+            norm += std::abs(y[i]);
+            sign[i] = (y[i] >= 0.0) ? 1.0 : -1.0;
+        }
+        if (iter > 0 && norm <= estimate) break;
+        estimate = norm;
+
+        applyInverse(sign, z);
+        int index = 0;
+        double zx = 0.0;
+        for (int i = 0; i < n; ++i) {
+            zx += z[i] * x[i];
+            if (std::abs(z[i]) > std::abs(z[index])) index = i;
+        }
+        if (std::abs(z[index]) <= zx || index == lastIndex) break;
+
+        std::fill(x.begin(), x.end(), 0.0);
+        x[index] = 1.0;
+        lastIndex = index;
+    }
+    return estimate;
+}
+
+// Уточнение решения масштабированной системы по готовому разложению
+// и метрики точности для исходной
+template <typename Real>
+static std::vector<double> refineScaled(const BasicSkylineCholesky<Real>& cholesky,
+    const SparseMatrix& A, const SparseMatrix& scaled, const std::vector<double>& scale,
+    const std::vector<double>& b, const std::vector<double>& rhs, int maxSteps,
+    bool estimateCondition, AccuracyReport& report)
+{
+    const int n = A.n;
+    std::vector<double> y, r, dy;
+    cholesky.solve(rhs, y);
+
+    // Уточнение: пока поправка уменьшается и не дошла до уровня округления double
+    const double eps = std::numeric_limits<double>::epsilon();
+    double previous = std::numeric_limits<double>::infinity();
+    report.refinementSteps = 0;
+    report.converged = false;
+    for (int step = 0; step < maxSteps; ++step) {
+        accurateResidual(scaled, y, rhs, r);
+        cholesky.solve(r, dy);
+        for (int i = 0; i < n; ++i) {
+            y[i] += dy[i];
+        }
+
+        double normY = normInf(y);
+        double correction = (normY > 0.0) ? normInf(dy) / normY : 0.0;
+        report.refinementSteps = step + 1;
+        report.lastCorrection = correction;
+        if (correction <= 4.0 * eps) {
+            report.converged = true;
+            break;
+        }
+        if (correction > 0.5 * previous) break;
+        previous = correction;
+    }
+
+    std::vector<double> x(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = y[i] * scale[i];
+    }
+
+    // Обратная ошибка: на сколько нужно возмутить A и b, чтобы x стал точным
+    accurateResidual(A, x, b, r);
+    double normA = norm1(A);   // для симметричной A совпадает с max-нормой
+    double denominator = normA * normInf(x) + normInf(b);
+    report.backwardError = (denominator > 0.0) ? normInf(r) / denominator : 0.0;
+    if (!estimateCondition) {
+        return x;
+    }
+
+    // cond(S A S) и cond(A) = ||A|| * ||S (SAS)^-1 S||
+    report.scaledConditionEstimate = norm1(scaled) * estimateInverseNorm1(n,
+        [&](const std::vector<double>& v, std::vector<double>& out) { cholesky.solve(v, out); });
+
+    std::vector<double> sv(n);
+    report.conditionEstimate = normA * estimateInverseNorm1(n,
+        [&](const std::vector<double>& v, std::vector<double>& out) {
+            for (int i = 0; i < n; ++i) sv[i] = v[i] * scale[i];
+            cholesky.solve(sv, out);
+            for (int i = 0; i < n; ++i) out[i] *= scale[i];
+        });
+
+    return x;
+}
+
+std::vector<double> solveWithRefinement(const SparseMatrix& A, const std::vector<double>& b,
+    std::vector<int>& perm, AccuracyReport& report, int maxSteps, FactorPrecision precision,
+    bool estimateCondition)
+{
+    const int n = A.n;
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+    report = AccuracyReport();
+
+    // Масштаб: ближайшая к 1/sqrt(A_ii) степень двойки
+    std::vector<double> scale(n, 1.0);
+    for (int i = 0; i < n; ++i) {
+        double d = A.at(i, i);
+        if (d > 0.0) {
+            scale[i] = std::exp2(-std::round(0.5 * std::log2(d)));
+        }
+    }
+
+    SparseMatrix scaled = A;
+    std::vector<double> rhs(n);
+    for (int i = 0; i < n; ++i) {
+        for (int k = scaled.rowPtr[i]; k < scaled.rowPtr[i + 1]; ++k) {
+            scaled.values[k] *= scale[i] * scale[scaled.colIdx[k]];
+        }
+        rhs[i] = b[i] * scale[i];
+    }
+    if (static_cast<int>(perm.size()) != n) {
+        perm = reverseCuthillMcKee(scaled);
+    }
+
+    // float сходится, только если cond * 1e-7 заметно меньше 1; иначе
+    // (или при потере ведущего элемента) разложение повторяется в double
+    if (precision == FactorPrecision::Single) {
+        try {
+            SkylineCholeskyFloat single;
+            single.factorize(scaled, perm);
+            std::vector<double> x = refineScaled(single, A, scaled, scale, b, rhs, maxSteps,
+                estimateCondition, report);
+            if (report.converged) {
+                report.precision = FactorPrecision::Single;
+                return x;
+            }
+        }
+        catch (const std::runtime_error&) {
+        }
+        report.singleFallback = true;
+    }
+
+    SkylineCholesky cholesky;
+    cholesky.factorize(scaled, perm);
+    report.precision = FactorPrecision::Double;
+    return refineScaled(cholesky, A, scaled, scale, b, rhs, maxSteps, estimateCondition, report);
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Разреженная симметричная матрица в формате CSR (хранятся обе половины)
+struct SparseMatrix {
+    int n = 0;
+    std::vector<int> rowPtr;      // n + 1 элементов
+    std::vector<int> colIdx;      // столбцы по возрастанию внутри строки
+    std::vector<double> values;
+
+    double at(int row, int col) const;   // 0, если элемента нет в шаблоне
+    double* find(int row, int col);      // nullptr, если элемента нет в шаблоне
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+    // То же произведение, строки делятся на блоки по потокам пула
+    void multiplyParallel(const std::vector<double>& x, std::vector<double>& y) const;
+    size_t nonZeros() const { return values.size(); }
+};
+
+// Сборка в формате COO: повторные (i, j) суммируются при переводе в CSR
+class SparseBuilder {
+public:
+    explicit SparseBuilder(int n = 0);
+    // Новая сборка размера n; память под элементы сохраняется
+    void reset(int n);
+    void reserve(size_t entries) { m_entries.reserve(entries); }
+    void add(int row, int col, double value);
+    SparseMatrix toCSR() const;
+    // То же в готовую матрицу: при повторной сборке того же размера
+    // память не выделяется
+    void toCSR(SparseMatrix& A);
+
+private:
+    struct Entry {
+        int row;
+        int col;
+        double value;
+    };
+    int m_n;
+    std::vector<Entry> m_entries;
+
+    // Буферы сортировки подсчетом, переиспользуются между вызовами toCSR
+    std::vector<int> m_count;
+    std::vector<int> m_fill;
+    std::vector<std::pair<int, double>> m_byRow;
+
+    static void buildCSR(int n, const std::vector<Entry>& entries, std::vector<int>& count,
+        std::vector<int>& fill, std::vector<std::pair<int, double>>& byRow, SparseMatrix& A);
+};
+
+// Обратный алгоритм Катхилла — Макки: перестановка, уменьшающая профиль матрицы.
+// perm[новый индекс] = исходный индекс
+std::vector<int> reverseCuthillMcKee(const SparseMatrix& A);
+
+// Разложение Холецкого A = L*L^T в профильной (skyline) форме.
+// Профиль строки i хранится от первого ненулевого столбца до диагонали,
+// после RCM для цепочек и сетей стержней он почти постоянной ширины.
+// Real — точность хранения L: float вдвое сокращает память и поток данных
+template <typename Real>
+class BasicSkylineCholesky {
+public:
+    void factorize(const SparseMatrix& A, const std::vector<int>& perm);
+    std::vector<double> solve(const std::vector<double>& b) const;
+    void solve(const std::vector<double>& b, std::vector<double>& x) const;
+
+    int size() const { return m_n; }
+    size_t envelopeSize() const { return m_values.size(); }
+
+private:
+    int m_n = 0;
+    std::vector<int> m_perm;           // новый индекс -> исходный
+    std::vector<int> m_first;          // первый столбец профиля строки
+    std::vector<size_t> m_rowStart;    // начало строки в m_values
+    std::vector<Real> m_values;        // строки L от m_first[i] до i включительно
+    std::vector<int> m_inverse;        // исходный индекс -> новый
+    std::vector<double> m_diagonal;    // диагональ A до разложения
+    std::vector<Real> m_inverseDiagonal; // 1 / L_ii: в решении умножения вместо делений
+    mutable std::vector<Real> m_work;
+
+    Real& L(int i, int j) { return m_values[m_rowStart[i] + (j - m_first[i])]; }
+    Real L(int i, int j) const { return m_values[m_rowStart[i] + (j - m_first[i])]; }
+};
+
+using SkylineCholesky = BasicSkylineCholesky<double>;
+using SkylineCholeskyFloat = BasicSkylineCholesky<float>;
+
+// Плотная система m x m (M по строкам) методом Гаусса с выбором ведущего
+// элемента по столбцу; для малых систем поправок Вудбери. Ведущий элемент
+// меньше minPivot по модулю — матрица вырождена
+std::vector<double> solveDense(std::vector<double> M, std::vector<double> rhs, int m,
+    double minPivot = 1e-300);
+
+// ==================== Итерационный решатель ====================
+
+enum class Preconditioner {
+    Jacobi,              // диагональное масштабирование, хорошо распараллеливается
+    IncompleteCholesky   // IC(0) по шаблону A, для цепочек совпадает с точным
+};
+
+struct PcgOptions {
+    double tolerance = 1e-10;     // по относительной невязке ||r|| / ||b||
+    int maxIterations = 0;        // 0 — не больше n итераций
+    Preconditioner preconditioner = Preconditioner::IncompleteCholesky;
+    bool keepHistory = false;     // сохранять невязку каждой итерации
+};
+
+struct PcgReport {
+    int iterations = 0;
+    double relativeResidual = 0.0;
+    bool converged = false;
+    std::vector<double> residualHistory;
+};
+
+// Метод сопряженных градиентов с предобусловливанием для симметричной
+// положительно определенной A. Память O(nnz), без факторизации
+std::vector<double> solvePCG(const SparseMatrix& A, const std::vector<double>& b,
+    const PcgOptions& options, PcgReport& report);
+
+// ==================== Режим точности ====================
+
+enum class FactorPrecision {
+    Double,
+    Single   // разложение во float, уточнение по невязке в double
+};
+
+struct AccuracyReport {
+    double conditionEstimate = 0.0;        // оценка cond_1(A); 0 — не оценивалась
+    double scaledConditionEstimate = 0.0;  // то же после масштабирования диагональю
+    double backwardError = 0.0;            // ||b - A x|| / (||A|| ||x|| + ||b||), max-норма
+    double lastCorrection = 0.0;           // ||dx|| / ||x|| на последнем уточнении
+    int refinementSteps = 0;
+    bool converged = false;
+    FactorPrecision precision = FactorPrecision::Double;   // фактически использованная
+    bool singleFallback = false;           // float не сошелся, пересчитано в double
+};
+
+// Прямое решение с масштабированием A -> S A S (S — степени двойки, близкие
+// к 1/sqrt(A_ii), поэтому масштабирование точное), RCM + Холецкий и
+// итерационным уточнением. Невязка уточнения считается с удвоенной
+// точностью (компенсированное скалярное произведение), число
+// обусловленности оценивается по Хейгеру — Хайему по готовому разложению
+// (estimateCondition = false — без оценки, она стоит нескольких решений).
+// При Single разложение хранится во float, а уточнение доводит решение
+// до точности double. perm — перестановка RCM рабочего места: масштабирование
+// шаблон не меняет, она пересчитывается, только если не подходит по размеру
+std::vector<double> solveWithRefinement(const SparseMatrix& A, const std::vector<double>& b,
+    std::vector<int>& perm, AccuracyReport& report, int maxSteps = 5,
+    FactorPrecision precision = FactorPrecision::Double, bool estimateCondition = true);
@@ -1,1266 +1,1756 @@
-#include "superBAR.h"
-
-superBAR::superBAR(QWidget* parent)
-    : QMainWindow(parent)
-{
-    ui.setupUi(this);
-    this->setWindowTitle("super-BAR");
-
-    ui.widget_beam->hide();
-    ui.widget_force->hide();
-    ui.widget_l_load->hide();
-    centerWindowOnScreen();
-    setupSceneAndView();
-    connectUi();
-}
-
-superBAR::~superBAR()
-{
-    disconnectAllItems();
-
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
-    }
-}
-
-void superBAR::disconnectAllItems()
-{
-    if (!m_scene) return;
-
-    // Сначала отключаем все соединения безопасным способом
-    QList<QGraphicsItem*> allItems = m_scene->items();
-
-    // Отключаем все балки
-    for (auto item : allItems) {
-        if (auto beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) {
-                beam->disconnect();
-            }
-        }
-    }
-
-    // Отключаем все заделки
-    for (auto item : allItems) {
-        if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
-            if (!support->isBeingDestroyed()) {
-                support->disconnect();
-            }
-        }
-    }
-}
-
-void superBAR::on_pushButton_8_clicked()
-{
-
-    collectBeamInfo(collectedBeam_info);
-    if (collectedBeam_info.size() < 1) {
-        QMessageBox::warning(this, "", "Нет исходных данных");
-        return;
-    }
-    cProcessor* form = new cProcessor(&collectedBeam_info);
-
-    connect(form, &cProcessor::sendResults,
-        this, &superBAR::create_Plot);
-
-    form->setAttribute(Qt::WA_DeleteOnClose);
-    form->setWindowModality(Qt::ApplicationModal);
-    form->show();
-   
-}
-
-void superBAR::onScalesConfirmed(int nxScale, int uxScale, int sigmaScale)
-{
-    removeItemsOfType<PlotItem>();
-    removeItemsOfType<DiagramItem>();
-    Nx_scaling = nxScale;
-    Ux_scaling = uxScale;
-    sigma_scaling = sigmaScale;
-    displayDiagrams(_results);
-}
-
-void superBAR::closeEvent(QCloseEvent* event)
-{
-    disconnectAllItems();
-
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
-    }
-
-    QMainWindow::closeEvent(event);
-}
-
-bool superBAR::eventFilter(QObject* obj, QEvent* event)
-{
-    // Обработка зума колесиком мыши
-    if (obj == ui.graphicsView_1->viewport() && event->type() == QEvent::Wheel) {
-        QWheelEvent* wheelEvent = static_cast<QWheelEvent*>(event);
-
-        if (wheelEvent->modifiers() & Qt::ControlModifier) {
-            const int delta = wheelEvent->angleDelta().y();
-            const qreal factor = 1.15;
-
-            if (delta > 0) {
-                // Приближение
-                if (m_currentZoom * factor <= 10.0) {
-                    ui.graphicsView_1->scale(factor, factor);
-                    m_currentZoom *= factor;
-                }
-            }
-            else {
-                // Отдаление
-                if (m_currentZoom / factor >= 0.1) {
-                    ui.graphicsView_1->scale(1.0 / factor, 1.0 / factor);
-                    m_currentZoom /= factor;
-                }
-            }
-
-            return true;
-        }
-    }
-
-    return QMainWindow::eventFilter(obj, event);
-}
-void superBAR::create_Plot(std::vector<BeamResults> results) {
-    _results = results;
-
-    removeItemsOfType<PlotItem>();
-    removeItemsOfType<DiagramItem>();
-
-    displayDiagrams(results);
-}
-std::tuple<double, double, double> superBAR::findMinMax(const std::vector<double>& values)
-{
-    if (values.empty()) {
-        return std::make_tuple(0.0, 0.0, 0.0);
-    }
-
-    auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
-
-    double mod1 = std::abs(*minIt);
-    double mod2 = std::abs(*maxIt);
-    double mod_max = std::max(mod1, mod2);
-    return std::make_tuple(*minIt, *maxIt, mod_max);
-}
-void superBAR::displayDiagrams(const std::vector<BeamResults>& results)
-{
-    auto connectors = collectAllConnectors();
-
-    if (connectors.empty()) {
-        qDebug() << "No connectors found!";
-        return;
-    }
-
-    const qreal lineHeight = 2100.0;
-    const qreal yOffset = 25;
-
-    // Для каждого узла создаем PlotItem
-    for (size_t i = 0; i < connectors.size(); i++)
-    {
-        const auto& conn = connectors[i];
-
-        // Создаем PlotItem для этого узла
-        PlotItem* plotItem = new PlotItem(
-            conn.o_x,                // X координата узла
-            conn.o_y+ yOffset,      // Y координата + смещение вниз
-            lineHeight              // Высота линии
-        );
-        m_scene->addItem(plotItem);
-
-    }
-
-    std::vector<double> Nx;
-    std::vector<double> Ux;
-    std::vector<double> sigma_x;
-    for (int i = 0; i < results.size(); i++) {
-        Nx.insert(Nx.end(), results[i].N_x.begin(), results[i].N_x.end());
-        Ux.insert(Ux.end(), results[i].U_x.begin(), results[i].U_x.end());
-        sigma_x.insert(sigma_x.end(), results[i].sigma.begin(), results[i].sigma.end());
-    }
-    auto[min_Nx, max_Nx, mod_Nx] = findMinMax(Nx);
-    auto[min_Ux, max_Ux, mod_Ux] = findMinMax(Ux);
-    auto[min_sig, max_sig, mod_sig] = findMinMax(sigma_x);
-    
-    for (int i = 0; i < connectors.size()-1; i++) {
-
-        double offset;
-
-
-        double opt = std::min(std::abs(min_Nx), std::abs(max_Nx));
-        offset = metersToQreal(opt);
-
-        if (offset < 100) {
-            offset = 300;
-        }
-        else if (offset > 500 && offset < 800) {
-            offset = offset / 1.7f;
-        }
-        else if (offset > 800) {
-            offset = offset / 3.0f;
-        }
-        double now_x = connectors[i].o_x;
-
-        std::string param_nx = (i == 0) ? "Nx" : "";
-
-        bool Nx_right = !shouldHideRightLabel(i, results,
-            [](const BeamResults& r) { return r.N_x; });
-
-        DiagramItem* diag1 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), 
-            results[i].N_x, QString::fromStdString(param_nx), Nx_scaling, true, Nx_right);
-
-        m_scene->addItem(diag1);
-        offset += metersToQreal(mod_Ux) / 4;
-        offset += 70.0;
-
-        
-        
-      //  bool Ux_right = true;
-
-        //const double eps = 1e-9;
-
-        //// Проверяем только правую подпись
-        //if (i < static_cast<int>(results.size()) - 1) {
-        //    if (!results[i].U_x.empty() && !results[i + 1].U_x.empty()) {
-        //        double rightCurrent = results[i].U_x[results[i].U_x.size() - 1];
-        //        double leftNext = results[i + 1].U_x[0];
-
-        //        // Используем сравнение с допуском
-        //        if (std::abs(rightCurrent - leftNext) < eps) {
-        //            Ux_right = false;
-        //        }
-        //    }
-        //}
-
-        std::string param_ux = (i == 0) ? "Ux" : "";
-
-        bool Ux_right = !shouldHideRightLabel(i, results,
-            [](const BeamResults& r) { return r.U_x; });
-
-        DiagramItem* diag2 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), 
-            results[i].U_x, QString::fromStdString(param_ux), Ux_scaling, true, Ux_right);
-        m_scene->addItem(diag2);
-        offset += metersToQreal(mod_sig) / 4;
-        offset += 70.0;
-
-        std::string param_sigma = (i == 0) ? "σ" : "";
-        bool Sigma_x_right = !shouldHideRightLabel(i, results,
-            [](const BeamResults& r) { return r.sigma; });
-        DiagramItem* diag3 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), results[i].sigma,
-            QString::fromStdString(param_sigma), sigma_scaling, true, Sigma_x_right);
-        m_scene->addItem(diag3);
-
-    }
-}
-
-
-void superBAR::collectBeamInfo(std::vector<Core_of_Beam>& data)
-{
-    collectedBeam_info.clear();
-
-    if (!m_scene) return;
-
-    // 1. Собираем ВСЕ балки из сцены
-    std::vector<BeamItem*> allBeams;
-
-    for (auto* item : m_scene->items()) {
-        if (auto* beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) {
-                allBeams.push_back(beam);
-            }
-        }
-    }
-
-    // 2. Сортируем балки слева направо по координате X
-    std::sort(allBeams.begin(), allBeams.end(),
-        [](BeamItem* a, BeamItem* b) {
-            auto leftConnA = a->getLeftConnector();
-            auto leftConnB = b->getLeftConnector();
-            return leftConnA.o_x < leftConnB.o_x;
-        });
-
-    // 3. Собираем информацию по каждой балке
-    for (BeamItem* beam : allBeams) {
-        Core_of_Beam beamInfo;
-
-        // Получаем характеристики балки
-        auto [len, sectArea, modElast, maxStress] = beam->getInfo();
-        beamInfo.len_L = qrealToMeters(len);
-        beamInfo.selectArea_A = sectArea;
-        beamInfo.mod_elasticity = modElast;
-        beamInfo.maxVoltage = maxStress;
-
-        // Получаем координаты концов балки
-        auto leftConn = beam->getLeftConnector();
-        auto rightConn = beam->getRightConnector();
-
-        // Собираем информацию об узлах (включая lineLoad_q)
-        beamInfo.Joint_left = collectJointInfo(leftConn);
-        beamInfo.Joint_right = collectJointInfo(rightConn);
-
-        collectedBeam_info.push_back(beamInfo);
-    }
-
-}
-
-Joint_info superBAR::collectJointInfo(const PointConnector& nodePos)
-{
-    Joint_info jointInfo;
-    jointInfo.fixedSupport = 0;
-    jointInfo.lineLoad_q = 0.0;
-    jointInfo.force_f = 0.0;
-
-    const qreal tolerance = 15.0; // Используем SNAP_DISTANCE для согласованности
-
-    // Проходим по всем элементам сцены
-    for (auto* item : m_scene->items()) {
-
-        // Проверяем наличие заделки
-        if (auto* support = dynamic_cast<FixedSupportItem*>(item)) {
-            if (!support->isBeingDestroyed()) {
-                auto supportPos = support->getPointConnector();
-                if (std::abs(supportPos.o_x - nodePos.o_x) < tolerance &&
-                    std::abs(supportPos.o_y - nodePos.o_y) < tolerance) {
-                    jointInfo.fixedSupport = 1;
-                }
-            }
-        }
-
-        // Проверяем наличие сосредоточенной силы
-        if (auto* force = dynamic_cast<ForceItem*>(item)) {
-            if (force->scene()) {
-                auto [lenFromBeam, forceH, posBeam] = force->getInfo();
-
-                // Получаем фактическую позицию силы в координатах сцены
-                QPointF forceScenePos = force->scenePos();
-
-                if (std::abs(forceScenePos.x() - nodePos.o_x) < tolerance &&
-                    std::abs(forceScenePos.y() - nodePos.o_y) < tolerance) {
-                    jointInfo.force_f += forceH; // Суммируем силы
-                }
-            }
-        }
-
-        // Проверяем наличие распределенной нагрузки
-        if (auto* lineLoad = dynamic_cast<LineLoadItem*>(item)) {
-            if (lineLoad->scene()) {
-                auto [q, beamDig] = lineLoad->getInfo();
-
-                // Получаем позицию начала распределенной нагрузки
-                QPointF lineLoadPos = lineLoad->scenePos();
-
-                // Проверяем, находится ли узел в начальной точке нагрузки
-                if (std::abs(lineLoadPos.x() - nodePos.o_x) < tolerance &&
-                    std::abs(lineLoadPos.y() - nodePos.o_y) < tolerance) {
-                    jointInfo.lineLoad_q = q;
-                }
-            }
-        }
-    }
-
-    return jointInfo;
-
-}
-
-bool superBAR::shouldHideRightLabel(int currentIndex, const std::vector<BeamResults>& results, const std::function<std::vector<double>(const BeamResults&)>& getValuesFunc)
-{
-    const double eps = 1e-9;
-
-    // Если это последний участок - показываем подпись
-    if (currentIndex >= static_cast<int>(results.size()) - 1) {
-        return false;
-    }
-
-    // Получаем значения текущего и следующего участков
-    std::vector<double> currentValues = getValuesFunc(results[currentIndex]);
-    std::vector<double> nextValues = getValuesFunc(results[currentIndex + 1]);
-
-    // Проверяем не пусты ли векторы
-    if (currentValues.empty() || nextValues.empty()) {
-        return false;
-    }
-
-    // Сравниваем с допуском
-    double rightCurrent = currentValues[currentValues.size() - 1];
-    double leftNext = nextValues[0];
-
-    return std::abs(rightCurrent - leftNext) < eps;
-}
-
-int superBAR::getNodeCount() const
-{
-    auto connectors = const_cast<superBAR*>(this)->collectAllConnectors();
-    return static_cast<int>(connectors.size());
-}
-
-int superBAR::getBeamCount() const
-{
-    if (!m_scene) return 0;
-
-    int count = 0;
-    for (auto* item : m_scene->items()) {
-        if (auto* beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) {
-                count++;
-            }
-        }
-    }
-    return count;
-}
-
-void superBAR::saveOnHotKey()
-{
-}
-
-void superBAR::serialization(std::string filename)
-{
-    if (!m_scene) return;
-
-
-    XMLDocument doc;
-
-    // Корневой элемент
-    XMLElement* root = doc.NewElement("Items");
-    doc.InsertFirstChild(root);
-
-    QList<QGraphicsItem*> allItems = m_scene->items();
-    std::reverse(allItems.begin(), allItems.end());
-    for (auto& item : allItems) {
-        if (auto beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) {
-                XMLElement* beam_main = doc.NewElement("Beam");
-                QPointF pos = beam->scenePos();
-                XMLElement* ox = doc.NewElement("ox");
-                ox->SetText(QString::number(pos.x()).toStdString().c_str());
-                XMLElement* oy = doc.NewElement("oy");
-                oy->SetText(QString::number(pos.y()).toStdString().c_str());
-
-                auto [len, sectArea_A, mod_Elast_E, maxStress_q] = beam->getInfo();
-                XMLElement* lenBeam = doc.NewElement("LengthBeam");
-                lenBeam->SetText(QString::number(len).toStdString().c_str());
-
-                XMLElement* Area = doc.NewElement("SectArea");
-                Area->SetText(QString::number(sectArea_A).toStdString().c_str());
-
-                XMLElement* ModElast = doc.NewElement("ModulusElastic");
-                ModElast->SetText(QString::number(mod_Elast_E).toStdString().c_str());
-
-                XMLElement* MaxStress = doc.NewElement("MaxStress");
-                MaxStress->SetText(QString::number(maxStress_q).toStdString().c_str());
-
-                beam_main->InsertEndChild(ox);
-                beam_main->InsertEndChild(oy);
-                beam_main->InsertEndChild(lenBeam);
-                beam_main->InsertEndChild(Area);
-                beam_main->InsertEndChild(ModElast);
-                beam_main->InsertEndChild(MaxStress);
-                root->InsertEndChild(beam_main);
-            }
-        }
-        else if (auto supportItem = dynamic_cast<FixedSupportItem*>(item)) {
-            if (!supportItem->isBeingDestroyed()) {
-                XMLElement* fix_supp = doc.NewElement("FixedSupport");
-                auto [_ox, _oy, el] = supportItem->getInfo();
-
-                QPointF pos = supportItem->scenePos();
-                XMLElement* ox = doc.NewElement("ox");
-                ox->SetText(QString::number(pos.x()).toStdString().c_str());
-                XMLElement* oy = doc.NewElement("oy");
-                oy->SetText(QString::number(pos.y()).toStdString().c_str());
-
-                XMLElement* direction = doc.NewElement("Direction");
-                std::string direct = (el == ElementDirection::Left) ? "Left" : "Right";
-                direction->SetText(direct.c_str());
-
-                fix_supp->InsertEndChild(ox);
-                fix_supp->InsertEndChild(oy);
-                fix_supp->InsertEndChild(direction);
-                root->InsertEndChild(fix_supp);
-            }
-        }
-        else if (auto forceItem = dynamic_cast<ForceItem*>(item)) {
-            auto [_len_b, forceH, pos] = forceItem->getInfo();
-            XMLElement* force_item = doc.NewElement("Force");
-
-            XMLElement* force = doc.NewElement("force_H");
-            force->SetText(QString::number(forceH).toStdString().c_str());
-
-            XMLElement* posOnbeam = doc.NewElement("pos");
-            posOnbeam->SetText(QString::number(pos).toStdString().c_str());
-
-            force_item->InsertEndChild(force);
-            force_item->InsertEndChild(posOnbeam);
-
-            root->InsertEndChild(force_item);
-        }
-        else if (auto lineLoadItem = dynamic_cast<LineLoadItem*>(item)) {
-            auto [q, _beamD] = lineLoadItem->getInfo();
-
-            XMLElement* force_item = doc.NewElement("LineLoad");
-
-            XMLElement* force = doc.NewElement("q");
-            force->SetText(QString::number(q).toStdString().c_str());
-
-            XMLElement* beamD = doc.NewElement("beamDig");
-            beamD->SetText(QString::number(_beamD).toStdString().c_str());
-
-            force_item->InsertEndChild(force);
-            force_item->InsertEndChild(beamD);
-            root->InsertEndChild(force_item);
-        }
-    }
-    doc.SaveFile(filename.c_str());
-}
-
-void superBAR::deserialization(std::string filename)
-{
-    fixedSupport_left = true;
-    fixedSupport_right = true;
-    XMLDocument doc;
-    if (doc.LoadFile(filename.c_str()) != XML_SUCCESS) {
-        std::cerr << "Ошибка загрузки XML\n";
-        return;
-    }
-
-    XMLElement* root = doc.FirstChildElement("Items");
-    if (!root) return;
-
-    for (XMLElement* elem = root->FirstChildElement();
-        elem != nullptr;
-        elem = elem->NextSiblingElement()) {
-
-        std::string tag = elem->Name();
-
-        if (tag == "Beam") {
-            qreal ox = 0, oy = 0, length = 0, selectArea=0, mod =0, maxStr =0 ;
-            elem->FirstChildElement("ox")->QueryDoubleText(&ox);
-            elem->FirstChildElement("oy")->QueryDoubleText(&oy);
-            elem->FirstChildElement("LengthBeam")->QueryDoubleText(&length);
-            elem->FirstChildElement("SectArea")->QueryDoubleText(&selectArea);
-            elem->FirstChildElement("ModulusElastic")->QueryDoubleText(&mod);
-            elem->FirstChildElement("MaxStress")->QueryDoubleText(&maxStr);
-
-            auto* beam = new BeamItem(ox, oy, length, 45);
-            beam->setPos(ox, oy);
-            m_scene->addItem(beam);
-            ConnectionManager::checkAndSnapNewItem(beam, m_scene);
-            beam->setInfo(selectArea, mod, maxStr);
-        }
-        else if (tag == "FixedSupport") {
-            qreal ox = 0, oy = 0;
-            std::string type;
-            ElementDirection el_type;
-            elem->FirstChildElement("ox")->QueryDoubleText(&ox);
-            elem->FirstChildElement("oy")->QueryDoubleText(&oy);
-            type = elem->FirstChildElement("Direction")->GetText();
-            el_type = (type == "Left") ? ElementDirection::Left : ElementDirection::Right;
-            if (el_type == ElementDirection::Left) {
-                fixedSupport_left = false;
-            }
-            if (el_type == ElementDirection::Right) {
-                fixedSupport_right = false;
-            }
-
-            FixedSupportItem* support = nullptr;
-            support = new FixedSupportItem(0, 0, FixSupportLen, el_type);
-            support->setPos(ox, oy);
-            if (support) {
-
-                connect(support, &FixedSupportItem::supportDeleted, this,
-                    [this](ElementDirection dir) {
-                        if (dir == ElementDirection::Left) {
-                            fixedSupport_left = true;
-                        }
-                        else {
-                            fixedSupport_right = true;
-                        }
-                    });
-
-                m_scene->addItem(support);
-                ConnectionManager::checkAndSnapNewItem(support, m_scene);
-            }
-        }
-        else if (tag == "Force") {
-            qreal H = 0;
-            int pos_b = 0;
-            elem->FirstChildElement("force_H")->QueryDoubleText(&H);
-            elem->FirstChildElement("pos")->QueryIntText(&pos_b);
-            auto [o_x, o_y] = getFirstPointBeam();
-            ForceItem* force = nullptr;
-            force = new ForceItem(o_x, o_y, ElementDirection::Right, 40);
-            m_scene->addItem(force);
-
-
-            auto [f_ox, f_oy] = getFirstPointBeam();
-            auto [_ox, _oy] = getPointBeam(pos_b);
-
-            if (H > 0) {
-
-                force->changeDirection(ElementDirection::Right);
-            }
-            else
-            {
-                force->changeDirection(ElementDirection::Left);
-            }
-
-            force->set_Len_fr_beam(_ox - f_ox);
-            force->setForce_H(H, pos_b);
-        }
-        else if (tag == "LineLoad") {
-            qreal q = 0;
-            int _beamDig = 0;
-            elem->FirstChildElement("q")->QueryDoubleText(&q);
-            elem->FirstChildElement("beamDig")->QueryIntText(&_beamDig);
-
-            auto [o_x_1, o_y_1] = getPointBeam(1);
-            auto [o_x_2, o_y_2] = getPointBeam(2);
-            LineLoadItem* line_l = new LineLoadItem(o_x_1, o_y_1, o_x_2, o_y_2, ElementDirection::Right);
-            m_scene->addItem(line_l);
-
-
-            auto [_ox, _oy, _ox2, _oy2] = getPointsBeam(_beamDig);
-            line_l->change_loc_joins(_ox, _oy, _ox2, _oy2);
-            line_l->set_LineLoad(q, _beamDig);
-            if (q > 0) {
-                line_l->change_direction(ElementDirection::Right);
-            }
-            else {
-                line_l->change_direction(ElementDirection::Left);
-            }
-        }
-    }
-}
-
-
-
-bool superBAR::checkNotEmpty(QTextEdit* edit)
-{
-    QString text = edit->toPlainText().trimmed();
-    if (text.isEmpty())
-        return false;
-
-    // Разбиваем по пробелам/переводам строк
-    QStringList parts = text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-
-    for (const QString& part : parts) {
-        if (part.trimmed().isEmpty())
-            return false;
-    }
-    return true;
-}
-
-
-bool superBAR::checkAllFilled(const QVector<QTextEdit*>& edits)
-{
-    for (auto* edit : edits) {
-        if (edit->toPlainText().trimmed().isEmpty())
-            return false;
-    }
-    return true;
-}
-
-void superBAR::changeBeamLength(BeamItem* beam, qreal newLength)
-{
-    if (!beam || beam->isBeingDestroyed()) return;
-
-    auto [currentLength, currentWidth] = beam->getParams();
-
-    if (qFuzzyCompare(currentLength, newLength)) {
-        QMessageBox::information(this, "Информация", "Длина балки не изменилась");
-        return;
-    }
-
-    bool wasConnected = beam->isConnected();
-    QGraphicsItem* connectedItem = beam->connectedTo;
-
-    beam->set_Length(newLength);
-
-    // Если балка была соединена, обновляем привязку
-    if (wasConnected && connectedItem && !beam->isBeingDestroyed()) {
-        m_scene->clearSelection();
-        beam->setSelected(true);
-        ConnectionManager::trySnapItems(m_scene);
-    }
-}
-
-std::tuple<qreal, qreal> superBAR::getLastPointBeam()
-{
-    qreal maxX = 0;
-    qreal correspondingY = 0;
-
-    if (!m_scene) return { 0, 0 };
-
-    // Оптимизированный поиск самой правой точки
-    for (auto& item : m_scene->items()) {
-        if (auto hasConn = dynamic_cast<IHasConnector*>(item)) {
-                auto point = hasConn->getPointConnector();
-                if (point.o_x > maxX) {
-                    maxX = point.o_x;
-                    correspondingY = point.o_y;
-                }
-            }
-        
-    }
-
-    return { maxX, correspondingY };
-}
-
-std::tuple<qreal, qreal> superBAR::getFirstPointBeam()
-{
-    qreal minX = 99999999;
-    qreal correspondingY = 0;
-
-    if (!m_scene) return { 0, 0 };
-
-    // Оптимизированный поиск самой левой точки
-    for (auto& item : m_scene->items()) {
-        if (auto hasConn = dynamic_cast<BeamItem*>(item)) {
-            if (!hasConn->isBeingDestroyed()) {
-                auto point = hasConn->getLeftConnector();
-                if (point.o_x < minX) {
-                    minX = point.o_x;
-                    correspondingY = point.o_y;
-                }
-            }
-        }
-    }
-
-    if (minX == 99999999) {
-        return { 0, 0 };
-    }
-
-    return { minX, correspondingY };
-}
-std::tuple<qreal, qreal> superBAR::getPointBeam(int order_beam)
-{
-    auto connectors = collectAllConnectors();
-    if (order_beam <= 0 || order_beam > (int)connectors.size())
-        return { 0, 0 };
-
-    auto& point = connectors[order_beam - 1]; // индексация с 1
-    return { point.o_x, point.o_y };
-}
-std::tuple<qreal, qreal, qreal, qreal> superBAR::getPointsBeam(int order_beam)
-{
-    auto connectors = collectAllConnectors();
-
-    if (order_beam <= 0 || order_beam > (int)connectors.size())
-        return { 0, 0, 0, 0};
-    auto& point1 = connectors[order_beam - 1];
-    auto& point2 = connectors[order_beam];
-    return { point1.o_x, point1.o_y, point2.o_x, point2.o_y };
-}
-std::vector<PointConnector> superBAR::collectAllConnectors()
-{
-    std::vector<PointConnector> connectors;
-    if (!m_scene) return connectors;
-
-    // --- Сбор всех коннекторов ---
-    for (auto& item : m_scene->items()) {
-        if (auto beam = dynamic_cast<BeamItem*>(item)) {
-            if (!beam->isBeingDestroyed()) {
-                connectors.push_back(beam->getLeftConnector());
-                connectors.push_back(beam->getRightConnector());
-            }
-        }
-        else if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
-            if (!support->isBeingDestroyed()) {
-                connectors.push_back(support->getPointConnector());
-            }
-        }
-    }
-
-    // --- Сортировка по X, затем по Y ---
-    std::sort(connectors.begin(), connectors.end(),
-        [](const PointConnector& a, const PointConnector& b) {
-            if (!qFuzzyCompare(a.o_x, b.o_x))
-                return a.o_x < b.o_x;
-            return a.o_y < b.o_y;
-        });
-
-    // --- Удаление дубликатов ---
-    connectors.erase(std::unique(connectors.begin(), connectors.end(),
-        [](const PointConnector& a, const PointConnector& b) {
-            return qFuzzyCompare(a.o_x, b.o_x) &&
-                qFuzzyCompare(a.o_y, b.o_y);
-        }),
-        connectors.end());
-
-    return connectors;
-}
-
-
-void superBAR::setupSceneAndView()
-{
-    m_scene = new QGraphicsScene(this);
-    ui.graphicsView_1->setScene(m_scene);
-    ui.graphicsView_1->setRenderHint(QPainter::Antialiasing);
-    ui.graphicsView_1->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
-
-    ui.graphicsView_1->setFocusPolicy(Qt::StrongFocus);
-    ui.graphicsView_1->setFocus();
-    // Устанавливаем фильтр событий для обработки зума
-    ui.graphicsView_1->viewport()->installEventFilter(this);
-
-    connect(m_scene, &QGraphicsScene::changed, this, [this]() {
-        if (m_scene) {
-            ConnectionManager::trySnapItems(m_scene);
-        }
-        });
-}
-template<typename T>
-inline void superBAR::removeItemsOfType()
-{
-    QList<QGraphicsItem*> allItems = m_scene->items();
-    for (auto item : allItems) {
-        if (auto sign = dynamic_cast<T*>(item)) {
-            sign->remove();
-        }
-    }
-}
-
-std::string superBAR::choosePath(bool isSave)
-{
-    QString fileName;
-
-    if (isSave) {
-        fileName = QFileDialog::getSaveFileName(
-            this,
-            tr("Сохранить файл"),            
-            QDir::currentPath() + "/example.xml",
-            tr("XML файлы (*.xml);;Все файлы (*.*)")
-        );
-    }
-    else {
-        fileName = QFileDialog::getOpenFileName(
-            this,
-            tr("Открыть файл"),              
-            QDir::currentPath(),
-            tr("XML файлы (*.xml);;Все файлы (*.*)")
-        );
-    }
-
-    return fileName.toStdString();
-}
-
-void superBAR::onMenuActionTriggered()
-{
-    QAction* action = qobject_cast<QAction*>(sender());
-    if (!action) return;
-
-    QString name = action->objectName();
-
-    // открыть
-    if (name == "action") {
-        m_scene->clear();
-
-        _file_name = choosePath(false);
-
-        deserialization(_file_name);
-    }
-    // сохранить
-    if (name == "action_2") {
-        if (_file_name != "") {
-            serialization(_file_name);
-        }
-        else {
-            _file_name = choosePath(true);
-
-            serialization(_file_name);
-        }
-        
-    }
-    // сохранить как
-    if (name == "action_3") {
-        
-        _file_name = choosePath(true);
-
-        serialization(_file_name);
-    }
-    // вкл/выкл подписи
-    if (name == "action_4") {
-        if (!beams_sign_b)  {
-            int inx = 1;
-            
-            auto pConnectors = collectAllConnectors();
-            int lenArray = pConnectors.size();
-            for (int i = 0; i < lenArray - 1; i ++) {
-                qreal sredX = (pConnectors[i].o_x + pConnectors[i + 1].o_x) / 2.0;
-                qreal sredY = (pConnectors[i].o_y + pConnectors[i + 1].o_y) / 2.0;
-
-                m_scene->addItem(new BeamSign(sredX, sredY - 60, inx));
-                inx++;
-            }
-
-            
-            beams_sign_b = true;
-        }
-        else {
-            if (!m_scene) return;
-
-            removeItemsOfType<BeamSign>();
-
-            beams_sign_b = false;
-        }
-    }
-    else if (name == "action_5") {
-        if (!joins_sign_b) {
-            int inx = 1;
-            auto pConnectors = collectAllConnectors();
-            int lenArray = pConnectors.size();
-            for (int i = 0; i < lenArray; i++) {
-                qreal sredX = pConnectors[i].o_x;
-                qreal sredY = pConnectors[i].o_y ;
-
-                m_scene->addItem(new BeamJoint(sredX+10, sredY + 60, inx));
-                inx++;
-            }
-
-            joins_sign_b = true;
-        }
-        else {
-
-            if (!m_scene) return;
-
-            removeItemsOfType<BeamJoint>();
-            joins_sign_b = false;
-        }
-    }
-    else if (name == "action_6") {
-        m_scene->clear();
-        fixedSupport_left = true;
-        fixedSupport_right = true;
-        _file_name = "";
-    }
-
-    else if (name == "action_7") {
-        removeItemsOfType<PlotItem>();
-        removeItemsOfType<DiagramItem>();
-    }
-
-    else if (name == "action_8") {
-        // перерисовка графика
-        std::tuple<int, int, int> scaling_default = { Nx_scaling, Ux_scaling, sigma_scaling};
-
-        sliderDialog* slider_form = new sliderDialog(scaling_default);
-        connect(slider_form, &sliderDialog::scalesConfirmed,
-            this, &superBAR::onScalesConfirmed);
-
-        slider_form->setAttribute(Qt::WA_DeleteOnClose);
-        slider_form->setWindowModality(Qt::ApplicationModal);
-        slider_form->show();
-       // removeItemsOfType<DiagramItem>();
-    }
-}
-
-void superBAR::connectUi()
-{
-    connect(ui.action, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_2, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_3, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_4, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_5, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_6, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_7, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-    connect(ui.action_8, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
-
-
-    ui.action_2->setShortcut(QKeySequence::Save);
-    connect(ui.action_2, &QAction::triggered, this, &superBAR::saveOnHotKey);
-    // Добавляем в меню
-  //  menuBar()->addAction(ui.action_2);
-
-
-    // Добавление балки
-    connect(ui.pushButton_1, &QPushButton::clicked, this, [this]() {
-        auto [o_x, o_y] = getLastPointBeam();
-        auto* beam = new BeamItem(o_x, o_y, SCALE, 45);
-        m_scene->addItem(beam);
-        ConnectionManager::checkAndSnapNewItem(beam, m_scene);
-
-        beam->setInfo(1, 1, 1);
-        });
-
-    // Добавление заделки
-    connect(ui.pushButton_2, &QPushButton::clicked, this, [this]() {
-        QMessageBox msgBox(this);
-        msgBox.setWindowTitle("Подтверждение");
-        msgBox.setText("Заделка будет левая или правая?");
-
-        auto* leftButton = msgBox.addButton("Левая", QMessageBox::AcceptRole);
-        auto* rightButton = msgBox.addButton("Правая", QMessageBox::AcceptRole);
-        msgBox.addButton("Отмена", QMessageBox::DestructiveRole);
-        leftButton->setEnabled(fixedSupport_left);
-        rightButton->setEnabled(fixedSupport_right);
-        msgBox.exec();
-
-        FixedSupportItem* support = nullptr;
-        if (msgBox.clickedButton() == leftButton) {
-            support = new FixedSupportItem(firstBeam_x, 50, FixSupportLen, ElementDirection::Left);
-            fixedSupport_left = false;
-        }
-        else if (msgBox.clickedButton() == rightButton) {
-            support = new FixedSupportItem(firstBeam_x, 50, FixSupportLen, ElementDirection::Right);
-            fixedSupport_right = false;
-        }
-        firstBeam_x += 50;
-
-        if (support) {
-
-            connect(support, &FixedSupportItem::supportDeleted, this,
-                [this](ElementDirection dir) {
-                    if (dir == ElementDirection::Left) {
-                        fixedSupport_left = true;
-                    }
-                    else {
-                        fixedSupport_right = true;
-                    }
-                });
-
-
-            m_scene->addItem(support);
-            ConnectionManager::checkAndSnapNewItem(support, m_scene);
-        }
-        });
-
-    // Добавление силы
-    connect(ui.pushButton_3, &QPushButton::clicked, this, [this]() {
-        auto [o_x, o_y] = getFirstPointBeam();
-
-        ForceItem* item = new ForceItem(o_x, o_y, ElementDirection::Right, 40);
-        m_scene->addItem(item);
-        item->set_Len_fr_beam(1);
-        item->setForce_H(1, 1);
-        });
-    // добавление погонной нагрузки
-    connect(ui.pushButton_7, &QPushButton::clicked, this, [this]() {
-        auto [o_x_1, o_y_1] = getPointBeam(1);
-        auto [o_x_2, o_y_2] = getPointBeam(2);
-        LineLoadItem* lineL = new LineLoadItem(o_x_1, o_y_1, o_x_2, o_y_2, ElementDirection::Right);
-        m_scene->addItem(lineL);
-        lineL->set_LineLoad(1, 1);
-        });
-
-    // Обработка выделения
-    connect(m_scene, &QGraphicsScene::selectionChanged, this, [this]() {
-        BeamItem* selectedBeam = nullptr;
-        ForceItem* selectedForce = nullptr;
-        LineLoadItem* selectedLineLoad = nullptr;
-
-        for (auto item : m_scene->selectedItems()) {
-            if (auto beam = dynamic_cast<BeamItem*>(item)) {
-                if (!beam->isBeingDestroyed()) {
-                    selectedBeam = beam;
-                }
-            }
-            if (auto force = dynamic_cast<ForceItem*>(item)) {
-                selectedForce = force;
-            }
-            if (auto l_load = dynamic_cast<LineLoadItem*>(item)) {
-                selectedLineLoad = l_load;
-            }
-        }
-
-        // --- Балка ---
-        if (selectedBeam) {
-            ui.widget_beam->show();
-            qreal length = std::get<0>(selectedBeam->getParams());
-            auto [d, d2, d3, d4] = selectedBeam->getInfo();
-            ui.textEdit_3->setText(QString::number(qrealToMeters(length)));
-            ui.textEdit_4->setText(QString::number(d2));
-            ui.textEdit_5->setText(QString::number(d3));
-            ui.textEdit_6->setText(QString::number(d4));
-        }
-        else {
-            ui.widget_beam->hide();
-            ui.textEdit_3->clear();
-            ui.textEdit_4->clear();
-            ui.textEdit_5->clear();
-            ui.textEdit_6->clear();
-        }
-        // --- Сила ---
-        if (selectedForce) {
-            ui.widget_force->show();
-            auto [d_l, d_f_h, pos_beam] = selectedForce->getInfo();
-            ui.textEdit_7->setText(QString::number(pos_beam));
-            ui.textEdit_8->setText(QString::number(d_f_h));
-        }
-        else {
-            ui.widget_force->hide();
-            ui.textEdit_7->clear();
-            ui.textEdit_8->clear();
-        }
-        // --- погонная нагрузка ---
-        if (selectedLineLoad) {
-            auto [forc_line, beamD] = selectedLineLoad->getInfo();
-            ui.textEdit_9->setText(QString::number(beamD));
-            ui.textEdit_11->setText(QString::number(forc_line));
-
-            ui.widget_l_load->show();
-        }
-        else {
-            ui.widget_l_load->hide();
-            ui.textEdit_9->clear();
-            ui.textEdit_11->clear();
-        }
-    });
-
-
-    // Изменение длины балки
-    connect(ui.pushButton_4, &QPushButton::clicked, this, [this]() {
-        QString lengthText = ui.textEdit_3->toPlainText();
-        bool ok;
-
-        qreal newLength = metersToQreal(lengthText.toDouble(&ok));
-   //     qreal newLength = lengthText.toDouble(&ok);
-
-        if (!ok || newLength <= 0) {
-            QMessageBox::warning(this, "Ошибка", "Введите корректное значение длины!");
-            return;
-        }
-
-        BeamItem* selectedBeam = nullptr;
-        for (auto item : m_scene->selectedItems()) {
-            if (auto beam = dynamic_cast<BeamItem*>(item)) {
-                if (!beam->isBeingDestroyed()) {
-                    selectedBeam = beam;
-                    break;
-                }
-            }
-        }
-
-        if (!selectedBeam) {
-            QMessageBox::warning(this, "Ошибка", "Не выбрана балка!");
-            return;
-        }
-        QVector<QTextEdit*> vec = { ui.textEdit_3, ui.textEdit_4, ui.textEdit_5, ui.textEdit_6 };
-        auto d = ui.textEdit_4->toPlainText().toDouble();
-        auto d1 = ui.textEdit_5->toPlainText().toDouble();
-        auto d2 = ui.textEdit_6->toPlainText().toDouble();
-        if (checkAllFilled(vec)) {
-            
-            if (d > 0 && d1 > 0 && d2 > 0) {
-                selectedBeam->setInfo(d, d1, d2);
-                changeBeamLength(selectedBeam, newLength);
-            }
-            else {
-                QMessageBox::information(this, "Info", "Какой-то параметр отрицательный");
-                return;
-            }
-            
-        }
-        else
-        {
-            QMessageBox::information(this, "Info", "не все поля заполнены");
-            return;
-        }
-
-        
-    });
-
-    // Применение параметров силы
-    connect(ui.pushButton_5, &QPushButton::clicked, this, [this]() {
-        ForceItem* forceM = nullptr;
-
-        for (auto item : m_scene->selectedItems()) {
-            if (auto forceTMP = dynamic_cast<ForceItem*>(item)) {
-                forceM = forceTMP;
-                break;
-            }
-        }
-
-        if (forceM) {
-            bool ok1, ok2;
-            int dig = ui.textEdit_7->toPlainText().toInt(&ok1);
-            qreal dig_forc = ui.textEdit_8->toPlainText().toDouble(&ok2);
-
-            int nodeCount = getNodeCount();
-            if (dig < 1 || dig > nodeCount) {
-                QMessageBox::warning(
-                    this,
-                    "Ошибка валидации",
-                    QString("Узел №%1 не существует!\nВсего узлов: %2\nДиапазон: 1-%2")
-                    .arg(dig)
-                    .arg(nodeCount)
-                );
-                return;
-            }
-
-            if (ok1 && ok2) {
-
-                auto [f_ox, f_oy] = getFirstPointBeam();
-                auto [_ox, _oy] = getPointBeam(dig);
-
-                if (dig_forc > 0) {
-                    
-                    forceM->changeDirection(ElementDirection::Right);
-                }
-                else
-                {
-                    forceM->changeDirection(ElementDirection::Left);
-                }
-                
-                forceM->set_Len_fr_beam(_ox - f_ox);
-                forceM->setForce_H(dig_forc, dig);
-            }
-            else {
-                QMessageBox::warning(this, "Ошибка", "Введите корректные числовые значения!");
-            }
-        }
-    });
-    // применение параметров погоннной нагрузки
-    connect(ui.pushButton_6, &QPushButton::clicked, this, [this]() {
-        
-        LineLoadItem* selectedLineLoad = nullptr;
-        for (auto item : m_scene->selectedItems()) {
-            if (auto l_load = dynamic_cast<LineLoadItem*>(item)) {
-                selectedLineLoad = l_load;
-            }
-        }
-        if (selectedLineLoad == nullptr) {
-            return;
-        }
-        bool ok1, ok3;
-        int dig_beam = ui.textEdit_9->toPlainText().toInt(&ok1);
-        qreal line_load = ui.textEdit_11->toPlainText().toDouble(&ok3);
-        
-        if (dig_beam < 1) {
-            QMessageBox::warning(this, "Предупреждение", "Не может быть отрицательным");
-            return;
-        }
-        int beamCount = getBeamCount();
-        if (dig_beam < 1 || dig_beam > beamCount) {
-            QMessageBox::warning(
-                this,
-                "Ошибка валидации",
-                QString("Стержень №%1 не существует!\nВсего стержней: %2\nДиапазон: 1-%2")
-                .arg(dig_beam)
-                .arg(beamCount)
-            );
-            return;
-        }
-        auto [_ox, _oy, _ox2, _oy2] = getPointsBeam(dig_beam);
-        selectedLineLoad->change_loc_joins(_ox, _oy, _ox2, _oy2);
-        selectedLineLoad->set_LineLoad(line_load, dig_beam);
-        if (line_load > 0) {
-            selectedLineLoad->change_direction(ElementDirection::Right);
-        }
-        else {
-            selectedLineLoad->change_direction(ElementDirection::Left);
-        }
-    });
-}
-
-void superBAR::centerWindowOnScreen()
-{ //Центрирование окна по экрану
-    QScreen* screen = QGuiApplication::primaryScreen();
-    if (screen) {
-        QRect screenGeometry = screen->geometry();
-        int x = (screenGeometry.width() - this->width()) / 2;
-        int y = (screenGeometry.height() - this->height()) / 2;
-        this->move(x, y);
-	}
-
-}
+#include "superBAR.h"
+
+superBAR::superBAR(QWidget* parent)
+    : QMainWindow(parent)
+{
+    ui.setupUi(this);
+    this->setWindowTitle("super-BAR");
+
+    ui.widget_beam->hide();
+    ui.widget_force->hide();
+    ui.widget_l_load->hide();
+    centerWindowOnScreen();
+    setupSceneAndView();
+    connectUi();
+}
+
+superBAR::~superBAR()
+{
+    disconnectAllItems();
+
+    if (m_scene) {
+        m_scene->clear();
+        delete m_scene;
+        m_scene = nullptr;
+    }
+}
+
+void superBAR::disconnectAllItems()
+{
+    if (!m_scene) return;
+
+    // Сначала отключаем все соединения безопасным способом
+    QList<QGraphicsItem*> allItems = m_scene->items();
+
+    // Отключаем все балки
+    for (auto item : allItems) {
+        if (auto beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) {
+                beam->disconnect();
+            }
+        }
+    }
+
+    // Отключаем все заделки
+    for (auto item : allItems) {
+        if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
+            if (!support->isBeingDestroyed()) {
+                support->disconnect();
+            }
+        }
+    }
+}
+
+void superBAR::on_pushButton_8_clicked()
+{
+
+    collectBeamInfo(collectedBeam_info);
+    if (collectedBeam_info.size() < 1) {
+        QMessageBox::warning(this, "", "Нет исходных данных");
+        return;
+    }
+    cProcessor* form = new cProcessor(&collectedBeam_info);
+
+    connect(form, &cProcessor::sendResults,
+        this, &superBAR::create_Plot);
+    connect(form, &cProcessor::sendAreas,
+        this, &superBAR::applyOptimizedAreas);
+
+    form->setAttribute(Qt::WA_DeleteOnClose);
+    form->setWindowModality(Qt::ApplicationModal);
+    form->show();
+   
+}
+
+void superBAR::onScalesConfirmed(int nxScale, int uxScale, int sigmaScale)
+{
+    removeItemsOfType<PlotItem>();
+    removeItemsOfType<DiagramItem>();
+    Nx_scaling = nxScale;
+    Ux_scaling = uxScale;
+    sigma_scaling = sigmaScale;
+    displayDiagrams(_results);
+}
+
+void superBAR::closeEvent(QCloseEvent* event)
+{
+    disconnectAllItems();
+
+    if (m_scene) {
+        m_scene->clear();
+        delete m_scene;
+        m_scene = nullptr;
+    }
+
+    QMainWindow::closeEvent(event);
+}
+
+bool superBAR::eventFilter(QObject* obj, QEvent* event)
+{
+    if (m_performanceMode && obj == ui.graphicsView_1->viewport()) {
+        if (event->type() == QEvent::Paint && !m_inTimedPaint) {
+            return timeViewportPaint(obj, event);
+        }
+        if (event->type() == QEvent::MouseMove &&
+            static_cast<QMouseEvent*>(event)->buttons() != Qt::NoButton) {
+            beginViewInteraction();
+        }
+    }
+
+    // Обработка зума колесиком мыши
+    if (obj == ui.graphicsView_1->viewport() && event->type() == QEvent::Wheel) {
+        QWheelEvent* wheelEvent = static_cast<QWheelEvent*>(event);
+
+        if (wheelEvent->modifiers() & Qt::ControlModifier) {
+            beginViewInteraction();
+
+            const int delta = wheelEvent->angleDelta().y();
+            const qreal factor = 1.15;
+
+            if (delta > 0) {
+                // Приближение
+                if (m_currentZoom * factor <= 10.0) {
+                    ui.graphicsView_1->scale(factor, factor);
+                    m_currentZoom *= factor;
+                }
+            }
+            else {
+                // Отдаление
+                if (m_currentZoom / factor >= 0.1) {
+                    ui.graphicsView_1->scale(1.0 / factor, 1.0 / factor);
+                    m_currentZoom /= factor;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    return QMainWindow::eventFilter(obj, event);
+}
+void superBAR::create_Plot(std::vector<BeamResults> results) {
+    _results = results;
+
+    removeItemsOfType<PlotItem>();
+    removeItemsOfType<DiagramItem>();
+
+    displayDiagrams(results);
+}
+std::tuple<double, double, double> superBAR::findMinMax(const std::vector<double>& values)
+{
+    if (values.empty()) {
+        return std::make_tuple(0.0, 0.0, 0.0);
+    }
+
+    auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+
+    double mod1 = std::abs(*minIt);
+    double mod2 = std::abs(*maxIt);
+    double mod_max = std::max(mod1, mod2);
+    return std::make_tuple(*minIt, *maxIt, mod_max);
+}
+void superBAR::displayDiagrams(const std::vector<BeamResults>& results)
+{
+    auto connectors = collectAllConnectors();
+
+    if (connectors.empty()) {
+        qDebug() << "No connectors found!";
+        return;
+    }
+
+    const qreal lineHeight = 2100.0;
+    const qreal yOffset = 25;
+
+    // Для каждого узла создаем PlotItem
+    for (size_t i = 0; i < connectors.size(); i++)
+    {
+        const auto& conn = connectors[i];
+
+        // Создаем PlotItem для этого узла
+        PlotItem* plotItem = new PlotItem(
+            conn.o_x,                // X координата узла
+            conn.o_y+ yOffset,      // Y координата + смещение вниз
+            lineHeight              // Высота линии
+        );
+        m_scene->addItem(plotItem);
+
+    }
+
+    std::vector<double> Nx;
+    std::vector<double> Ux;
+    std::vector<double> sigma_x;
+    for (int i = 0; i < results.size(); i++) {
+        Nx.insert(Nx.end(), results[i].N_x.begin(), results[i].N_x.end());
+        Ux.insert(Ux.end(), results[i].U_x.begin(), results[i].U_x.end());
+        sigma_x.insert(sigma_x.end(), results[i].sigma.begin(), results[i].sigma.end());
+    }
+    auto[min_Nx, max_Nx, mod_Nx] = findMinMax(Nx);
+    auto[min_Ux, max_Ux, mod_Ux] = findMinMax(Ux);
+    auto[min_sig, max_sig, mod_sig] = findMinMax(sigma_x);
+    
+    for (int i = 0; i < connectors.size()-1; i++) {
+
+        double offset;
+
+
+        double opt = std::min(std::abs(min_Nx), std::abs(max_Nx));
+        offset = metersToQreal(opt);
+
+        if (offset < 100) {
+            offset = 300;
+        }
+        else if (offset > 500 && offset < 800) {
+            offset = offset / 1.7f;
+        }
+        else if (offset > 800) {
+            offset = offset / 3.0f;
+        }
+        double now_x = connectors[i].o_x;
+
+        std::string param_nx = (i == 0) ? "Nx" : "";
+
+        bool Nx_right = !shouldHideRightLabel(i, results,
+            [](const BeamResults& r) { return r.N_x; });
+
+        // Точки сетки неравномерны, если внутри стержня есть силы
+        std::vector<double> positions(results[i].X.size());
+        for (size_t k = 0; k < positions.size(); k++) {
+            positions[k] = results[i].X[k] / results[i].L;
+        }
+
+        DiagramItem* diag1 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), 
+            results[i].N_x, QString::fromStdString(param_nx), Nx_scaling, true, Nx_right);
+        diag1->setPositions(positions);
+
+        m_scene->addItem(diag1);
+        offset += metersToQreal(mod_Ux) / 4;
+        offset += 70.0;
+
+        
+        
+      //  bool Ux_right = true;
+
+        //const double eps = 1e-9;
+
+        //// Проверяем только правую подпись
+        //if (i < static_cast<int>(results.size()) - 1) {
+        //    if (!results[i].U_x.empty() && !results[i + 1].U_x.empty()) {
+        //        double rightCurrent = results[i].U_x[results[i].U_x.size() - 1];
+        //        double leftNext = results[i + 1].U_x[0];
+
+        //        // Используем сравнение с допуском
+        //        if (std::abs(rightCurrent - leftNext) < eps) {
+        //            Ux_right = false;
+        //        }
+        //    }
+        //}
+
+        std::string param_ux = (i == 0) ? "Ux" : "";
+
+        bool Ux_right = !shouldHideRightLabel(i, results,
+            [](const BeamResults& r) { return r.U_x; });
+
+        DiagramItem* diag2 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), 
+            results[i].U_x, QString::fromStdString(param_ux), Ux_scaling, true, Ux_right);
+        diag2->setPositions(positions);
+        m_scene->addItem(diag2);
+        offset += metersToQreal(mod_sig) / 4;
+        offset += 70.0;
+
+        std::string param_sigma = (i == 0) ? "σ" : "";
+        bool Sigma_x_right = !shouldHideRightLabel(i, results,
+            [](const BeamResults& r) { return r.sigma; });
+        DiagramItem* diag3 = new DiagramItem(now_x, connectors[0].o_y + offset, metersToQreal(results[i].L), results[i].sigma,
+            QString::fromStdString(param_sigma), sigma_scaling, true, Sigma_x_right);
+        diag3->setPositions(positions);
+        m_scene->addItem(diag3);
+
+    }
+}
+
+
+void superBAR::collectBeamInfo(std::vector<Core_of_Beam>& data)
+{
+    collectedBeam_info.clear();
+    collectedBeams.clear();
+
+    if (!m_scene) return;
+
+    // 1. Собираем ВСЕ балки и распределенные нагрузки из сцены
+    std::vector<BeamItem*> allBeams;
+    std::vector<LineLoadItem*> lineLoadItems;
+    std::vector<ForceItem*> forceItems;
+
+    for (auto* item : m_scene->items()) {
+        if (auto* beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) {
+                allBeams.push_back(beam);
+            }
+        }
+        else if (auto* lineLoad = dynamic_cast<LineLoadItem*>(item)) {
+            if (lineLoad->scene()) {
+                lineLoadItems.push_back(lineLoad);
+            }
+        }
+        else if (auto* force = dynamic_cast<ForceItem*>(item)) {
+            if (force->scene()) {
+                forceItems.push_back(force);
+            }
+        }
+    }
+
+    // 2. Сортируем балки слева направо по координате X
+    std::sort(allBeams.begin(), allBeams.end(),
+        [](BeamItem* a, BeamItem* b) {
+            auto leftConnA = a->getLeftConnector();
+            auto leftConnB = b->getLeftConnector();
+            return leftConnA.o_x < leftConnB.o_x;
+        });
+
+    // 3. Узлы — совпадающие концы балок: стержни с общим концом делят узел,
+    //    так описываются и цепочки, и разветвленные системы
+    const qreal tolerance = ConnectionManager::SNAP_DISTANCE;
+    std::vector<PointConnector> nodes;
+    nodes.reserve(allBeams.size() * 2);
+    for (BeamItem* beam : allBeams) {
+        nodes.push_back(beam->getLeftConnector());
+        nodes.push_back(beam->getRightConnector());
+    }
+    std::sort(nodes.begin(), nodes.end(),
+        [](const PointConnector& a, const PointConnector& b) {
+            return (a.o_x != b.o_x) ? a.o_x < b.o_x : a.o_y < b.o_y;
+        });
+    nodes.erase(std::unique(nodes.begin(), nodes.end(),
+        [tolerance](const PointConnector& a, const PointConnector& b) {
+            return a.distanceSquaredTo(b) < tolerance * tolerance;
+        }),
+        nodes.end());
+
+    auto findNode = [&nodes, tolerance](const PointConnector& p) {
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), p.o_x - tolerance,
+            [](const PointConnector& a, qreal x) { return a.o_x < x; });
+        for (; it != nodes.end() && it->o_x <= p.o_x + tolerance; ++it) {
+            if (it->distanceSquaredTo(p) < tolerance * tolerance) {
+                return static_cast<int>(it - nodes.begin());
+            }
+        }
+        return -1;
+    };
+
+    // 4. Собираем информацию по каждой балке
+    for (BeamItem* beam : allBeams) {
+        Core_of_Beam beamInfo;
+
+        // Получаем характеристики балки
+        auto [len, sectArea, modElast, maxStress] = beam->getInfo();
+        beamInfo.len_L = qrealToMeters(len);
+        beamInfo.selectArea_A = sectArea;
+        beamInfo.mod_elasticity = modElast;
+        beamInfo.maxVoltage = maxStress;
+
+        // Получаем координаты концов балки
+        auto leftConn = beam->getLeftConnector();
+        auto rightConn = beam->getRightConnector();
+
+        // Собираем информацию об узлах
+        beamInfo.Joint_left = collectJointInfo(leftConn);
+        beamInfo.Joint_right = collectJointInfo(rightConn);
+        beamInfo.node_left = findNode(leftConn);
+        beamInfo.node_right = findNode(rightConn);
+        beamInfo.Joint_right.gap = beam->getGapRight();
+        std::tie(beamInfo.thermalExpansion, beamInfo.deltaT, beamInfo.initialStrain) = beam->getStrainInfo();
+        beamInfo.section = beam->getSection();
+        beamInfo.density = beam->getDensity();
+        beamInfo.tangentModulus = beam->getTangentModulus();
+
+        // Распределенные нагрузки стержня: все, что начинаются у его левого
+        // конца, а не последняя найденная — нагрузки на одном стержне складываются
+        for (LineLoadItem* lineLoad : lineLoadItems) {
+            QPointF lineLoadPos = lineLoad->scenePos();
+            if (std::abs(lineLoadPos.x() - leftConn.o_x) >= tolerance ||
+                std::abs(lineLoadPos.y() - leftConn.o_y) >= tolerance) {
+                continue;
+            }
+            auto [q, beamDig] = lineLoad->getInfo();
+            auto [start, end, qEnd] = lineLoad->getSpan();
+            beamInfo.lineLoads.push_back({ start * beamInfo.len_L, end * beamInfo.len_L, q, qEnd });
+        }
+
+        // Сосредоточенные силы внутри пролета; силы у концов собирает collectJointInfo
+        for (ForceItem* force : forceItems) {
+            QPointF forcePos = force->scenePos();
+            if (forcePos.x() <= leftConn.o_x + tolerance ||
+                forcePos.x() >= rightConn.o_x - tolerance ||
+                std::abs(forcePos.y() - leftConn.o_y) >= tolerance) {
+                continue;
+            }
+            auto [lenFromBeam, forceH, posBeam] = force->getInfo();
+            beamInfo.pointLoads.push_back({ qrealToMeters(forcePos.x() - leftConn.o_x), forceH });
+        }
+
+        collectedBeam_info.push_back(beamInfo);
+        collectedBeams.push_back(beam);
+    }
+
+}
+
+void superBAR::applyOptimizedAreas(std::vector<double> areas)
+{
+    // Окно процессора модальное: пока оно открыто, балки сцены не меняются
+    for (size_t i = 0; i < areas.size() && i < collectedBeams.size(); ++i) {
+        BeamItem* beam = collectedBeams[i];
+        auto [len, sectArea, modElast, maxStress] = beam->getInfo();
+        beam->setInfo(areas[i], modElast, maxStress);
+        collectedBeam_info[i].selectArea_A = areas[i];
+    }
+
+    // Открытый файл модели перезаписывается с новыми площадями
+    if (!_file_name.empty()) {
+        serialization(_file_name);
+    }
+}
+
+Joint_info superBAR::collectJointInfo(const PointConnector& nodePos)
+{
+    Joint_info jointInfo;
+    jointInfo.fixedSupport = 0;
+    jointInfo.lineLoad_q = 0.0;
+    jointInfo.force_f = 0.0;
+
+    const qreal tolerance = 15.0; // Используем SNAP_DISTANCE для согласованности
+    std::vector<ForceItem*> nodeForces;
+
+    // Проходим по всем элементам сцены
+    for (auto* item : m_scene->items()) {
+
+        // Проверяем наличие заделки
+        if (auto* support = dynamic_cast<FixedSupportItem*>(item)) {
+            if (!support->isBeingDestroyed()) {
+                auto supportPos = support->getPointConnector();
+                if (std::abs(supportPos.o_x - nodePos.o_x) < tolerance &&
+                    std::abs(supportPos.o_y - nodePos.o_y) < tolerance) {
+                    // Опора с жесткостью — пружина на землю, а не заделка
+                    if (support->getStiffness() > 0.0) {
+                        jointInfo.springStiffness = support->getStiffness();
+                    }
+                    else {
+                        jointInfo.fixedSupport = 1;
+                        jointInfo.settlement = support->getSettlement();
+                    }
+                }
+            }
+        }
+
+        // Проверяем наличие сосредоточенной силы
+        if (auto* force = dynamic_cast<ForceItem*>(item)) {
+            if (force->scene()) {
+                auto [lenFromBeam, forceH, posBeam] = force->getInfo();
+
+                // Получаем фактическую позицию силы в координатах сцены
+                QPointF forceScenePos = force->scenePos();
+
+                if (std::abs(forceScenePos.x() - nodePos.o_x) < tolerance &&
+                    std::abs(forceScenePos.y() - nodePos.o_y) < tolerance) {
+                    jointInfo.force_f += forceH; // Суммируем силы
+                    nodeForces.push_back(force);
+                }
+            }
+        }
+    }
+
+    // Закон F(t) узла: сумма F_i·f_i(t) по объединению точек таблиц,
+    // сила без таблицы постоянна
+    std::vector<double> times;
+    for (ForceItem* force : nodeForces) {
+        const auto& history = force->getHistory().times;
+        times.insert(times.end(), history.begin(), history.end());
+    }
+    if (!times.empty()) {
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+        for (double t : times) {
+            double value = 0.0;
+            for (ForceItem* force : nodeForces) {
+                const LoadHistory& history = force->getHistory();
+                value += std::get<1>(force->getInfo()) * (history.empty() ? 1.0 : history.at(t));
+            }
+            jointInfo.forceHistory.times.push_back(t);
+            jointInfo.forceHistory.values.push_back(value);
+        }
+    }
+
+    return jointInfo;
+
+}
+
+bool superBAR::shouldHideRightLabel(int currentIndex, const std::vector<BeamResults>& results, const std::function<std::vector<double>(const BeamResults&)>& getValuesFunc)
+{
+    const double eps = 1e-9;
+
+    // Если это последний участок - показываем подпись
+    if (currentIndex >= static_cast<int>(results.size()) - 1) {
+        return false;
+    }
+
+    // Получаем значения текущего и следующего участков
+    std::vector<double> currentValues = getValuesFunc(results[currentIndex]);
+    std::vector<double> nextValues = getValuesFunc(results[currentIndex + 1]);
+
+    // Проверяем не пусты ли векторы
+    if (currentValues.empty() || nextValues.empty()) {
+        return false;
+    }
+
+    // Сравниваем с допуском
+    double rightCurrent = currentValues[currentValues.size() - 1];
+    double leftNext = nextValues[0];
+
+    return std::abs(rightCurrent - leftNext) < eps;
+}
+
+int superBAR::getNodeCount() const
+{
+    auto connectors = const_cast<superBAR*>(this)->collectAllConnectors();
+    return static_cast<int>(connectors.size());
+}
+
+int superBAR::getBeamCount() const
+{
+    if (!m_scene) return 0;
+
+    int count = 0;
+    for (auto* item : m_scene->items()) {
+        if (auto* beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void superBAR::saveOnHotKey()
+{
+}
+
+void superBAR::serialization(std::string filename)
+{
+    if (!m_scene) return;
+
+
+    XMLDocument doc;
+
+    // Корневой элемент
+    XMLElement* root = doc.NewElement("Items");
+    doc.InsertFirstChild(root);
+
+    QList<QGraphicsItem*> allItems = m_scene->items();
+    std::reverse(allItems.begin(), allItems.end());
+    for (auto& item : allItems) {
+        if (auto beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) {
+                XMLElement* beam_main = doc.NewElement("Beam");
+                QPointF pos = beam->scenePos();
+                XMLElement* ox = doc.NewElement("ox");
+                ox->SetText(QString::number(pos.x()).toStdString().c_str());
+                XMLElement* oy = doc.NewElement("oy");
+                oy->SetText(QString::number(pos.y()).toStdString().c_str());
+
+                auto [len, sectArea_A, mod_Elast_E, maxStress_q] = beam->getInfo();
+                XMLElement* lenBeam = doc.NewElement("LengthBeam");
+                lenBeam->SetText(QString::number(len).toStdString().c_str());
+
+                XMLElement* Area = doc.NewElement("SectArea");
+                Area->SetText(QString::number(sectArea_A).toStdString().c_str());
+
+                XMLElement* ModElast = doc.NewElement("ModulusElastic");
+                ModElast->SetText(QString::number(mod_Elast_E).toStdString().c_str());
+
+                XMLElement* MaxStress = doc.NewElement("MaxStress");
+                MaxStress->SetText(QString::number(maxStress_q).toStdString().c_str());
+
+                beam_main->InsertEndChild(ox);
+                beam_main->InsertEndChild(oy);
+                beam_main->InsertEndChild(lenBeam);
+                beam_main->InsertEndChild(Area);
+                beam_main->InsertEndChild(ModElast);
+                beam_main->InsertEndChild(MaxStress);
+                if (beam->getGapRight() >= 0.0) {
+                    XMLElement* gapRight = doc.NewElement("GapRight");
+                    gapRight->SetText(QString::number(beam->getGapRight()).toStdString().c_str());
+                    beam_main->InsertEndChild(gapRight);
+                }
+                auto [alpha, deltaT, initialStrain] = beam->getStrainInfo();
+                if (alpha != 0.0 || deltaT != 0.0) {
+                    XMLElement* thermal = doc.NewElement("ThermalExpansion");
+                    thermal->SetText(QString::number(alpha).toStdString().c_str());
+                    XMLElement* temperature = doc.NewElement("DeltaT");
+                    temperature->SetText(QString::number(deltaT).toStdString().c_str());
+                    beam_main->InsertEndChild(thermal);
+                    beam_main->InsertEndChild(temperature);
+                }
+                if (initialStrain != 0.0) {
+                    XMLElement* strain = doc.NewElement("InitialStrain");
+                    strain->SetText(QString::number(initialStrain).toStdString().c_str());
+                    beam_main->InsertEndChild(strain);
+                }
+                if (beam->getDensity() > 0.0) {
+                    XMLElement* density = doc.NewElement("Density");
+                    density->SetText(QString::number(beam->getDensity()).toStdString().c_str());
+                    beam_main->InsertEndChild(density);
+                }
+                if (beam->getTangentModulus() > 0.0) {
+                    XMLElement* tangent = doc.NewElement("TangentModulus");
+                    tangent->SetText(QString::number(beam->getTangentModulus()).toStdString().c_str());
+                    beam_main->InsertEndChild(tangent);
+                }
+                const SectionProfile& section = beam->getSection();
+                if (!section.isConstant()) {
+                    // Числа через пробел; точки таблицы — в долях длины
+                    auto joinValues = [](const std::vector<double>& values) {
+                        QStringList parts;
+                        for (double v : values) parts << QString::number(v, 'g', 17);
+                        return parts.join(' ').toStdString();
+                    };
+                    const char* kindNames[] = { "Constant", "Linear", "Polynomial", "Table" };
+                    XMLElement* sectionEl = doc.NewElement("Section");
+                    XMLElement* kind = doc.NewElement("Kind");
+                    kind->SetText(kindNames[static_cast<int>(section.kind)]);
+                    XMLElement* values = doc.NewElement("Values");
+                    values->SetText(joinValues(section.values).c_str());
+                    sectionEl->InsertEndChild(kind);
+                    sectionEl->InsertEndChild(values);
+                    if (section.kind == SectionKind::Table) {
+                        XMLElement* points = doc.NewElement("Points");
+                        points->SetText(joinValues(section.points).c_str());
+                        sectionEl->InsertEndChild(points);
+                    }
+                    beam_main->InsertEndChild(sectionEl);
+                }
+                root->InsertEndChild(beam_main);
+            }
+        }
+        else if (auto supportItem = dynamic_cast<FixedSupportItem*>(item)) {
+            if (!supportItem->isBeingDestroyed()) {
+                XMLElement* fix_supp = doc.NewElement("FixedSupport");
+                auto [_ox, _oy, el] = supportItem->getInfo();
+
+                QPointF pos = supportItem->scenePos();
+                XMLElement* ox = doc.NewElement("ox");
+                ox->SetText(QString::number(pos.x()).toStdString().c_str());
+                XMLElement* oy = doc.NewElement("oy");
+                oy->SetText(QString::number(pos.y()).toStdString().c_str());
+
+                XMLElement* direction = doc.NewElement("Direction");
+                std::string direct = (el == ElementDirection::Left) ? "Left" : "Right";
+                direction->SetText(direct.c_str());
+
+                XMLElement* settlement = doc.NewElement("Settlement");
+                settlement->SetText(QString::number(supportItem->getSettlement()).toStdString().c_str());
+
+                XMLElement* internal = doc.NewElement("Internal");
+                internal->SetText(supportItem->isInternal() ? "1" : "0");
+
+                XMLElement* stiffness = doc.NewElement("Stiffness");
+                stiffness->SetText(QString::number(supportItem->getStiffness()).toStdString().c_str());
+
+                fix_supp->InsertEndChild(ox);
+                fix_supp->InsertEndChild(oy);
+                fix_supp->InsertEndChild(direction);
+                fix_supp->InsertEndChild(settlement);
+                fix_supp->InsertEndChild(internal);
+                fix_supp->InsertEndChild(stiffness);
+                root->InsertEndChild(fix_supp);
+            }
+        }
+        else if (auto forceItem = dynamic_cast<ForceItem*>(item)) {
+            auto [_len_b, forceH, pos] = forceItem->getInfo();
+            XMLElement* force_item = doc.NewElement("Force");
+
+            XMLElement* force = doc.NewElement("force_H");
+            force->SetText(QString::number(forceH).toStdString().c_str());
+
+            XMLElement* posOnbeam = doc.NewElement("pos");
+            posOnbeam->SetText(QString::number(pos).toStdString().c_str());
+
+            force_item->InsertEndChild(force);
+            force_item->InsertEndChild(posOnbeam);
+
+            // Смещение от узла вдоль стержня, м — только для сил внутри пролета
+            if (forceItem->getOffset() != 0.0) {
+                XMLElement* offset = doc.NewElement("Offset");
+                offset->SetText(QString::number(forceItem->getOffset()).toStdString().c_str());
+                force_item->InsertEndChild(offset);
+            }
+
+            // Закон F(t) — точки "t:f" через пробел
+            const LoadHistory& history = forceItem->getHistory();
+            if (!history.empty()) {
+                QStringList points;
+                for (size_t i = 0; i < history.times.size(); ++i) {
+                    points << QString("%1:%2").arg(history.times[i]).arg(history.values[i]);
+                }
+                XMLElement* historyEl = doc.NewElement("History");
+                historyEl->SetText(points.join(' ').toStdString().c_str());
+                force_item->InsertEndChild(historyEl);
+            }
+
+            root->InsertEndChild(force_item);
+        }
+        else if (auto lineLoadItem = dynamic_cast<LineLoadItem*>(item)) {
+            auto [q, _beamD] = lineLoadItem->getInfo();
+
+            XMLElement* force_item = doc.NewElement("LineLoad");
+
+            XMLElement* force = doc.NewElement("q");
+            force->SetText(QString::number(q).toStdString().c_str());
+
+            XMLElement* beamD = doc.NewElement("beamDig");
+            beamD->SetText(QString::number(_beamD).toStdString().c_str());
+
+            force_item->InsertEndChild(force);
+            force_item->InsertEndChild(beamD);
+
+            // Частичная или трапециевидная нагрузка — необязательные поля
+            auto [start, end, qEnd] = lineLoadItem->getSpan();
+            if (start != 0.0 || end != 1.0 || qEnd != q) {
+                XMLElement* startEl = doc.NewElement("Start");
+                startEl->SetText(QString::number(start).toStdString().c_str());
+                XMLElement* endEl = doc.NewElement("End");
+                endEl->SetText(QString::number(end).toStdString().c_str());
+                XMLElement* qEndEl = doc.NewElement("qEnd");
+                qEndEl->SetText(QString::number(qEnd).toStdString().c_str());
+                force_item->InsertEndChild(startEl);
+                force_item->InsertEndChild(endEl);
+                force_item->InsertEndChild(qEndEl);
+            }
+            root->InsertEndChild(force_item);
+        }
+    }
+    doc.SaveFile(filename.c_str());
+}
+
+void superBAR::deserialization(std::string filename)
+{
+    fixedSupport_left = true;
+    fixedSupport_right = true;
+    XMLDocument doc;
+    if (doc.LoadFile(filename.c_str()) != XML_SUCCESS) {
+        std::cerr << "Ошибка загрузки XML\n";
+        return;
+    }
+
+    XMLElement* root = doc.FirstChildElement("Items");
+    if (!root) return;
+
+    beginBulkEdit();
+    int invalidSections = 0;
+
+    for (XMLElement* elem = root->FirstChildElement();
+        elem != nullptr;
+        elem = elem->NextSiblingElement()) {
+
+        std::string tag = elem->Name();
+
+        if (tag == "Beam") {
+            qreal ox = 0, oy = 0, length = 0, selectArea=0, mod =0, maxStr =0 ;
+            elem->FirstChildElement("ox")->QueryDoubleText(&ox);
+            elem->FirstChildElement("oy")->QueryDoubleText(&oy);
+            elem->FirstChildElement("LengthBeam")->QueryDoubleText(&length);
+            elem->FirstChildElement("SectArea")->QueryDoubleText(&selectArea);
+            elem->FirstChildElement("ModulusElastic")->QueryDoubleText(&mod);
+            elem->FirstChildElement("MaxStress")->QueryDoubleText(&maxStr);
+
+            auto* beam = new BeamItem(ox, oy, length, 45);
+            beam->setPos(ox, oy);
+            m_scene->addItem(beam);
+            beam->setInfo(selectArea, mod, maxStr);
+
+            double gapRight = -1.0;
+            if (auto* gapEl = elem->FirstChildElement("GapRight")) {
+                gapEl->QueryDoubleText(&gapRight);
+            }
+            beam->setGapRight(gapRight);
+
+            // Температурная и начальная деформации — необязательные поля
+            double alpha = 0.0, deltaT = 0.0, initialStrain = 0.0;
+            if (auto* thermalEl = elem->FirstChildElement("ThermalExpansion")) {
+                thermalEl->QueryDoubleText(&alpha);
+            }
+            if (auto* temperatureEl = elem->FirstChildElement("DeltaT")) {
+                temperatureEl->QueryDoubleText(&deltaT);
+            }
+            if (auto* strainEl = elem->FirstChildElement("InitialStrain")) {
+                strainEl->QueryDoubleText(&initialStrain);
+            }
+            beam->setStrainInfo(alpha, deltaT, initialStrain);
+
+            double density = 0.0;
+            if (auto* densityEl = elem->FirstChildElement("Density")) {
+                densityEl->QueryDoubleText(&density);
+            }
+            beam->setDensity(density);
+
+            double tangentModulus = 0.0;
+            if (auto* tangentEl = elem->FirstChildElement("TangentModulus")) {
+                tangentEl->QueryDoubleText(&tangentModulus);
+            }
+            beam->setTangentModulus(tangentModulus);
+
+            if (auto* sectionEl = elem->FirstChildElement("Section")) {
+                auto splitValues = [](XMLElement* el) {
+                    std::vector<double> values;
+                    if (el && el->GetText()) {
+                        for (const QString& token : QString(el->GetText()).split(' ', Qt::SkipEmptyParts)) {
+                            values.push_back(token.toDouble());
+                        }
+                    }
+                    return values;
+                };
+                SectionProfile section;
+                const char* kindText = sectionEl->FirstChildElement("Kind") ?
+                    sectionEl->FirstChildElement("Kind")->GetText() : nullptr;
+                std::string kind = kindText ? kindText : "Constant";
+                section.kind = kind == "Linear" ? SectionKind::Linear
+                    : kind == "Polynomial" ? SectionKind::Polynomial
+                    : kind == "Table" ? SectionKind::Table : SectionKind::Constant;
+                section.values = splitValues(sectionEl->FirstChildElement("Values"));
+                section.points = splitValues(sectionEl->FirstChildElement("Points"));
+                // Неполный закон A(ξ) ломает area() при первом расчете — стержень
+                // остается с постоянным сечением
+                if (!section.isValid()) {
+                    section = SectionProfile();
+                    invalidSections++;
+                }
+                beam->setSection(section);
+            }
+        }
+        else if (tag == "FixedSupport") {
+            qreal ox = 0, oy = 0;
+            std::string type;
+            ElementDirection el_type;
+            elem->FirstChildElement("ox")->QueryDoubleText(&ox);
+            elem->FirstChildElement("oy")->QueryDoubleText(&oy);
+            type = elem->FirstChildElement("Direction")->GetText();
+            el_type = (type == "Left") ? ElementDirection::Left : ElementDirection::Right;
+
+            // Осадка, признак промежуточной опоры и жесткость — необязательные поля
+            double settlement = 0.0;
+            double stiffness = 0.0;
+            int internal = 0;
+            if (auto* settlementEl = elem->FirstChildElement("Settlement")) {
+                settlementEl->QueryDoubleText(&settlement);
+            }
+            if (auto* internalEl = elem->FirstChildElement("Internal")) {
+                internalEl->QueryIntText(&internal);
+            }
+            if (auto* stiffnessEl = elem->FirstChildElement("Stiffness")) {
+                stiffnessEl->QueryDoubleText(&stiffness);
+            }
+
+            if (el_type == ElementDirection::Left && !internal) {
+                fixedSupport_left = false;
+            }
+            if (el_type == ElementDirection::Right && !internal) {
+                fixedSupport_right = false;
+            }
+
+            FixedSupportItem* support = nullptr;
+            support = new FixedSupportItem(0, 0, FixSupportLen, el_type);
+            support->setPos(ox, oy);
+            support->setSettlement(settlement);
+            support->setInternal(internal != 0);
+            support->setStiffness(stiffness);
+            if (support) {
+
+                // Промежуточная опора края не освобождает
+                if (!internal) {
+                    connect(support, &FixedSupportItem::supportDeleted, this,
+                        [this](ElementDirection dir) {
+                            if (dir == ElementDirection::Left) {
+                                fixedSupport_left = true;
+                            }
+                            else {
+                                fixedSupport_right = true;
+                            }
+                        });
+                }
+
+                m_scene->addItem(support);
+            }
+        }
+        else if (tag == "Force") {
+            qreal H = 0;
+            int pos_b = 0;
+            elem->FirstChildElement("force_H")->QueryDoubleText(&H);
+            elem->FirstChildElement("pos")->QueryIntText(&pos_b);
+            auto [o_x, o_y] = getFirstPointBeam();
+            ForceItem* force = nullptr;
+            force = new ForceItem(o_x, o_y, ElementDirection::Right, 40);
+            m_scene->addItem(force);
+
+
+            auto [f_ox, f_oy] = getFirstPointBeam();
+            auto [_ox, _oy] = getPointBeam(pos_b);
+
+            if (H > 0) {
+
+                force->changeDirection(ElementDirection::Right);
+            }
+            else
+            {
+                force->changeDirection(ElementDirection::Left);
+            }
+
+            double offset = 0.0;
+            if (auto* offsetEl = elem->FirstChildElement("Offset")) offsetEl->QueryDoubleText(&offset);
+            force->setOffset(offset);
+
+            if (auto* historyEl = elem->FirstChildElement("History"); historyEl && historyEl->GetText()) {
+                LoadHistory history;
+                for (const QString& token : QString(historyEl->GetText()).split(' ', Qt::SkipEmptyParts)) {
+                    QStringList pair = token.split(':');
+                    if (pair.size() != 2) continue;
+                    history.times.push_back(pair[0].toDouble());
+                    history.values.push_back(pair[1].toDouble());
+                }
+                force->setHistory(history);
+            }
+
+            force->set_Len_fr_beam(_ox - f_ox);
+            force->setForce_H(H, pos_b);
+        }
+        else if (tag == "LineLoad") {
+            qreal q = 0;
+            int _beamDig = 0;
+            elem->FirstChildElement("q")->QueryDoubleText(&q);
+            elem->FirstChildElement("beamDig")->QueryIntText(&_beamDig);
+
+            auto [o_x_1, o_y_1] = getPointBeam(1);
+            auto [o_x_2, o_y_2] = getPointBeam(2);
+            LineLoadItem* line_l = new LineLoadItem(o_x_1, o_y_1, o_x_2, o_y_2, ElementDirection::Right);
+            m_scene->addItem(line_l);
+
+
+            auto [_ox, _oy, _ox2, _oy2] = getPointsBeam(_beamDig);
+            line_l->change_loc_joins(_ox, _oy, _ox2, _oy2);
+            line_l->set_LineLoad(q, _beamDig);
+
+            double start = 0.0, end = 1.0, qEnd = q;
+            if (auto* startEl = elem->FirstChildElement("Start")) {
+                startEl->QueryDoubleText(&start);
+            }
+            if (auto* endEl = elem->FirstChildElement("End")) {
+                endEl->QueryDoubleText(&end);
+            }
+            if (auto* qEndEl = elem->FirstChildElement("qEnd")) {
+                qEndEl->QueryDoubleText(&qEnd);
+            }
+            line_l->setSpan(start, end, qEnd);
+            if (q > 0) {
+                line_l->change_direction(ElementDirection::Right);
+            }
+            else {
+                line_l->change_direction(ElementDirection::Left);
+            }
+        }
+    }
+
+    endBulkEdit();
+
+    if (invalidSections > 0) {
+        QMessageBox::warning(this, "Ошибка",
+            QString("Некорректный закон сечения у стержней: %1. Сечение принято постоянным")
+            .arg(invalidSections));
+    }
+}
+
+
+
+bool superBAR::checkNotEmpty(QTextEdit* edit)
+{
+    QString text = edit->toPlainText().trimmed();
+    if (text.isEmpty())
+        return false;
+
+    // Разбиваем по пробелам/переводам строк
+    QStringList parts = text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+
+    for (const QString& part : parts) {
+        if (part.trimmed().isEmpty())
+            return false;
+    }
+    return true;
+}
+
+
+bool superBAR::checkAllFilled(const QVector<QTextEdit*>& edits)
+{
+    for (auto* edit : edits) {
+        if (edit->toPlainText().trimmed().isEmpty())
+            return false;
+    }
+    return true;
+}
+
+void superBAR::changeBeamLength(BeamItem* beam, qreal newLength)
+{
+    if (!beam || beam->isBeingDestroyed()) return;
+
+    auto [currentLength, currentWidth] = beam->getParams();
+
+    if (qFuzzyCompare(currentLength, newLength)) {
+        QMessageBox::information(this, "Информация", "Длина балки не изменилась");
+        return;
+    }
+
+    bool wasConnected = beam->isConnected();
+    QGraphicsItem* connectedItem = beam->connectedTo;
+
+    beam->set_Length(newLength);
+
+    // Если балка была соединена, обновляем привязку
+    if (wasConnected && connectedItem && !beam->isBeingDestroyed()) {
+        m_scene->clearSelection();
+        beam->setSelected(true);
+        ConnectionManager::trySnapItems(m_scene);
+    }
+}
+
+std::tuple<qreal, qreal> superBAR::getLastPointBeam()
+{
+    qreal maxX = 0;
+    qreal correspondingY = 0;
+
+    if (!m_scene) return { 0, 0 };
+
+    // Оптимизированный поиск самой правой точки
+    for (auto& item : m_scene->items()) {
+        if (auto hasConn = dynamic_cast<IHasConnector*>(item)) {
+                auto point = hasConn->getPointConnector();
+                if (point.o_x > maxX) {
+                    maxX = point.o_x;
+                    correspondingY = point.o_y;
+                }
+            }
+        
+    }
+
+    return { maxX, correspondingY };
+}
+
+std::tuple<qreal, qreal> superBAR::getFirstPointBeam()
+{
+    qreal minX = 99999999;
+    qreal correspondingY = 0;
+
+    if (!m_scene) return { 0, 0 };
+
+    // Оптимизированный поиск самой левой точки
+    for (auto& item : m_scene->items()) {
+        if (auto hasConn = dynamic_cast<BeamItem*>(item)) {
+            if (!hasConn->isBeingDestroyed()) {
+                auto point = hasConn->getLeftConnector();
+                if (point.o_x < minX) {
+                    minX = point.o_x;
+                    correspondingY = point.o_y;
+                }
+            }
+        }
+    }
+
+    if (minX == 99999999) {
+        return { 0, 0 };
+    }
+
+    return { minX, correspondingY };
+}
+std::tuple<qreal, qreal> superBAR::getPointBeam(int order_beam)
+{
+    auto connectors = collectAllConnectors();
+    if (order_beam <= 0 || order_beam > (int)connectors.size())
+        return { 0, 0 };
+
+    auto& point = connectors[order_beam - 1]; // индексация с 1
+    return { point.o_x, point.o_y };
+}
+std::tuple<qreal, qreal, qreal, qreal> superBAR::getPointsBeam(int order_beam)
+{
+    auto connectors = collectAllConnectors();
+
+    if (order_beam <= 0 || order_beam > (int)connectors.size())
+        return { 0, 0, 0, 0};
+    auto& point1 = connectors[order_beam - 1];
+    auto& point2 = connectors[order_beam];
+    return { point1.o_x, point1.o_y, point2.o_x, point2.o_y };
+}
+std::vector<PointConnector> superBAR::collectAllConnectors()
+{
+    std::vector<PointConnector> connectors;
+    if (!m_scene) return connectors;
+
+    // --- Сбор всех коннекторов ---
+    for (auto& item : m_scene->items()) {
+        if (auto beam = dynamic_cast<BeamItem*>(item)) {
+            if (!beam->isBeingDestroyed()) {
+                connectors.push_back(beam->getLeftConnector());
+                connectors.push_back(beam->getRightConnector());
+            }
+        }
+        else if (auto support = dynamic_cast<FixedSupportItem*>(item)) {
+            if (!support->isBeingDestroyed()) {
+                connectors.push_back(support->getPointConnector());
+            }
+        }
+    }
+
+    // --- Сортировка по X, затем по Y ---
+    std::sort(connectors.begin(), connectors.end(),
+        [](const PointConnector& a, const PointConnector& b) {
+            if (!qFuzzyCompare(a.o_x, b.o_x))
+                return a.o_x < b.o_x;
+            return a.o_y < b.o_y;
+        });
+
+    // --- Удаление дубликатов ---
+    connectors.erase(std::unique(connectors.begin(), connectors.end(),
+        [](const PointConnector& a, const PointConnector& b) {
+            return qFuzzyCompare(a.o_x, b.o_x) &&
+                qFuzzyCompare(a.o_y, b.o_y);
+        }),
+        connectors.end());
+
+    return connectors;
+}
+
+
+void superBAR::setupSceneAndView()
+{
+    m_scene = new QGraphicsScene(this);
+    ui.graphicsView_1->setScene(m_scene);
+    ui.graphicsView_1->setRenderHint(QPainter::Antialiasing);
+    ui.graphicsView_1->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+
+    ui.graphicsView_1->setFocusPolicy(Qt::StrongFocus);
+    ui.graphicsView_1->setFocus();
+    // Устанавливаем фильтр событий для обработки зума
+    ui.graphicsView_1->viewport()->installEventFilter(this);
+
+    m_interactionTimer = new QTimer(this);
+    m_interactionTimer->setSingleShot(true);
+    m_interactionTimer->setInterval(150);
+    connect(m_interactionTimer, &QTimer::timeout, this, [this]() {
+        ui.graphicsView_1->setRenderHint(QPainter::Antialiasing, true);
+        ui.graphicsView_1->viewport()->update();
+        });
+    connect(ui.graphicsView_1->horizontalScrollBar(), &QScrollBar::valueChanged,
+        this, &superBAR::beginViewInteraction);
+    connect(ui.graphicsView_1->verticalScrollBar(), &QScrollBar::valueChanged,
+        this, &superBAR::beginViewInteraction);
+
+    m_sceneChanged = connect(m_scene, &QGraphicsScene::changed,
+        this, &superBAR::onSceneChanged);
+}
+
+void superBAR::onSceneChanged()
+{
+    if (m_scene) {
+        ConnectionManager::trySnapItems(m_scene);
+    }
+}
+
+void superBAR::setPerformanceMode(bool enabled)
+{
+    if (!m_scene) return;
+
+    m_performanceMode = enabled;
+    RenderDetail::cullSmallDetails = enabled;
+    QGraphicsView* view = ui.graphicsView_1;
+
+    if (enabled) {
+        // Одна перерисовка общей области вместо множества мелких регионов
+        view->setViewportUpdateMode(QGraphicsView::BoundingRectViewportUpdate);
+        tuneSceneIndex();
+
+        if (!m_frameOverlay) {
+            m_frameOverlay = new QLabel(view);
+            m_frameOverlay->setStyleSheet("background: white; color: black; padding: 2px;");
+            m_frameOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+            m_frameOverlay->setAttribute(Qt::WA_OpaquePaintEvent);
+            m_frameOverlay->move(8, 8);
+        }
+        m_avgFrameMs = 0.0;
+        m_frameOverlay->setText("кадр: - мс");
+        m_frameOverlay->adjustSize();
+        m_frameOverlay->show();
+    }
+    else {
+        view->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+        if (m_scene->itemIndexMethod() == QGraphicsScene::BspTreeIndex) {
+            m_scene->setBspTreeDepth(0); // автоматический подбор Qt
+        }
+        m_interactionTimer->stop();
+        view->setRenderHint(QPainter::Antialiasing, true);
+        if (m_frameOverlay) {
+            m_frameOverlay->hide();
+        }
+    }
+
+    m_scene->update();
+}
+
+void superBAR::tuneSceneIndex()
+{
+    if (!m_performanceMode || !m_scene) return;
+    if (m_scene->itemIndexMethod() != QGraphicsScene::BspTreeIndex) return;
+
+    // Цепочка балок вытянута вдоль X: по ~4 элемента на лист дерева
+    const int itemCount = std::max<int>(1, m_scene->items().size());
+    const int depth = std::clamp(static_cast<int>(std::ceil(std::log2(itemCount))) - 2, 4, 18);
+    m_scene->setBspTreeDepth(depth);
+}
+
+void superBAR::beginViewInteraction()
+{
+    if (!m_performanceMode) return;
+
+    // Сглаживание возвращается после паузы в зуме/панорамировании
+    if (ui.graphicsView_1->renderHints() & QPainter::Antialiasing) {
+        ui.graphicsView_1->setRenderHint(QPainter::Antialiasing, false);
+    }
+    m_interactionTimer->start();
+}
+
+bool superBAR::timeViewportPaint(QObject* obj, QEvent* event)
+{
+    // Прогоняем отрисовку вложенно через обычную цепочку, чтобы замерить ее целиком
+    QElapsedTimer timer;
+    timer.start();
+    m_inTimedPaint = true;
+    QCoreApplication::sendEvent(obj, event);
+    m_inTimedPaint = false;
+    const double frameMs = timer.nsecsElapsed() / 1e6;
+
+    m_avgFrameMs = (m_avgFrameMs == 0.0) ? frameMs : 0.9 * m_avgFrameMs + 0.1 * frameMs;
+
+    // Подпись обновляется не чаще 4 раз в секунду
+    if (m_frameOverlay && (!m_overlayRefresh.isValid() || m_overlayRefresh.elapsed() > 250)) {
+        m_overlayRefresh.restart();
+        m_frameOverlay->setText(QString("кадр: %1 мс (ср. %2 мс)")
+            .arg(frameMs, 0, 'f', 1)
+            .arg(m_avgFrameMs, 0, 'f', 1));
+        m_frameOverlay->adjustSize();
+    }
+    return true;
+}
+
+void superBAR::beginBulkEdit()
+{
+    if (!m_scene) return;
+
+    if (m_bulkEditDepth++ == 0) {
+        // Соединение по changed на время транзакции отключено: его выполняет
+        // endBulkEdit одним проходом
+        disconnect(m_sceneChanged);
+        // Без индекса addItem не перестраивает BSP-дерево на каждый элемент
+        m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    }
+}
+
+void superBAR::endBulkEdit()
+{
+    if (!m_scene || m_bulkEditDepth == 0) return;
+    if (--m_bulkEditDepth > 0) return;
+
+    ConnectionManager::snapAllItems(m_scene);
+
+    // Индекс строится один раз по всем добавленным элементам
+    m_scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    tuneSceneIndex();
+
+    // Сцена отправляет changed отложенным вызовом: изменения транзакции
+    // доставляются здесь, пока обработчик отключен, и последующие правки
+    // приходят к нему как обычно. Если changed все же дойдет позже, обработчик
+    // лишь повторит уже выполненное соединение
+    QCoreApplication::sendPostedEvents(m_scene, QEvent::MetaCall);
+    m_sceneChanged = connect(m_scene, &QGraphicsScene::changed,
+        this, &superBAR::onSceneChanged);
+}
+template<typename T>
+inline void superBAR::removeItemsOfType()
+{
+    QList<QGraphicsItem*> allItems = m_scene->items();
+    for (auto item : allItems) {
+        if (auto sign = dynamic_cast<T*>(item)) {
+            sign->remove();
+        }
+    }
+}
+
+std::string superBAR::choosePath(bool isSave)
+{
+    QString fileName;
+
+    if (isSave) {
+        fileName = QFileDialog::getSaveFileName(
+            this,
+            tr("Сохранить файл"),            
+            QDir::currentPath() + "/example.xml",
+            tr("XML файлы (*.xml);;Все файлы (*.*)")
+        );
+    }
+    else {
+        fileName = QFileDialog::getOpenFileName(
+            this,
+            tr("Открыть файл"),              
+            QDir::currentPath(),
+            tr("XML файлы (*.xml);;Все файлы (*.*)")
+        );
+    }
+
+    return fileName.toStdString();
+}
+
+void superBAR::onMenuActionTriggered()
+{
+    QAction* action = qobject_cast<QAction*>(sender());
+    if (!action) return;
+
+    QString name = action->objectName();
+
+    // открыть
+    if (name == "action") {
+        m_scene->clear();
+
+        _file_name = choosePath(false);
+
+        deserialization(_file_name);
+    }
+    // сохранить
+    if (name == "action_2") {
+        if (_file_name != "") {
+            serialization(_file_name);
+        }
+        else {
+            _file_name = choosePath(true);
+
+            serialization(_file_name);
+        }
+        
+    }
+    // сохранить как
+    if (name == "action_3") {
+        
+        _file_name = choosePath(true);
+
+        serialization(_file_name);
+    }
+    // вкл/выкл подписи
+    if (name == "action_4") {
+        if (!beams_sign_b)  {
+            int inx = 1;
+            
+            auto pConnectors = collectAllConnectors();
+            int lenArray = pConnectors.size();
+            for (int i = 0; i < lenArray - 1; i ++) {
+                qreal sredX = (pConnectors[i].o_x + pConnectors[i + 1].o_x) / 2.0;
+                qreal sredY = (pConnectors[i].o_y + pConnectors[i + 1].o_y) / 2.0;
+
+                m_scene->addItem(new BeamSign(sredX, sredY - 60, inx));
+                inx++;
+            }
+
+            
+            beams_sign_b = true;
+        }
+        else {
+            if (!m_scene) return;
+
+            removeItemsOfType<BeamSign>();
+
+            beams_sign_b = false;
+        }
+    }
+    else if (name == "action_5") {
+        if (!joins_sign_b) {
+            int inx = 1;
+            auto pConnectors = collectAllConnectors();
+            int lenArray = pConnectors.size();
+            for (int i = 0; i < lenArray; i++) {
+                qreal sredX = pConnectors[i].o_x;
+                qreal sredY = pConnectors[i].o_y ;
+
+                m_scene->addItem(new BeamJoint(sredX+10, sredY + 60, inx));
+                inx++;
+            }
+
+            joins_sign_b = true;
+        }
+        else {
+
+            if (!m_scene) return;
+
+            removeItemsOfType<BeamJoint>();
+            joins_sign_b = false;
+        }
+    }
+    else if (name == "action_6") {
+        m_scene->clear();
+        fixedSupport_left = true;
+        fixedSupport_right = true;
+        _file_name = "";
+    }
+
+    else if (name == "action_7") {
+        removeItemsOfType<PlotItem>();
+        removeItemsOfType<DiagramItem>();
+    }
+
+    else if (name == "action_8") {
+        // перерисовка графика
+        std::tuple<int, int, int> scaling_default = { Nx_scaling, Ux_scaling, sigma_scaling};
+
+        sliderDialog* slider_form = new sliderDialog(scaling_default);
+        connect(slider_form, &sliderDialog::scalesConfirmed,
+            this, &superBAR::onScalesConfirmed);
+
+        slider_form->setAttribute(Qt::WA_DeleteOnClose);
+        slider_form->setWindowModality(Qt::ApplicationModal);
+        slider_form->show();
+       // removeItemsOfType<DiagramItem>();
+    }
+
+    else if (name == "action_9") {
+        setPerformanceMode(ui.action_9->isChecked());
+    }
+}
+
+void superBAR::connectUi()
+{
+    connect(ui.action, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_2, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_3, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_4, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_5, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_6, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_7, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_8, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+    connect(ui.action_9, &QAction::triggered, this, &superBAR::onMenuActionTriggered);
+
+
+    ui.action_2->setShortcut(QKeySequence::Save);
+    connect(ui.action_2, &QAction::triggered, this, &superBAR::saveOnHotKey);
+    // Добавляем в меню
+  //  menuBar()->addAction(ui.action_2);
+
+
+    // Добавление балки
+    connect(ui.pushButton_1, &QPushButton::clicked, this, [this]() {
+        auto [o_x, o_y] = getLastPointBeam();
+        auto* beam = new BeamItem(o_x, o_y, SCALE, 45);
+        m_scene->addItem(beam);
+        ConnectionManager::checkAndSnapNewItem(beam, m_scene);
+
+        beam->setInfo(1, 1, 1);
+        });
+
+    // Добавление заделки
+    connect(ui.pushButton_2, &QPushButton::clicked, this, [this]() {
+        QMessageBox msgBox(this);
+        msgBox.setWindowTitle("Подтверждение");
+        msgBox.setText("Заделка будет левая, правая или промежуточная?");
+
+        auto* leftButton = msgBox.addButton("Левая", QMessageBox::AcceptRole);
+        auto* rightButton = msgBox.addButton("Правая", QMessageBox::AcceptRole);
+        auto* internalButton = msgBox.addButton("Промежуточная", QMessageBox::AcceptRole);
+        msgBox.addButton("Отмена", QMessageBox::DestructiveRole);
+        leftButton->setEnabled(fixedSupport_left);
+        rightButton->setEnabled(fixedSupport_right);
+        msgBox.exec();
+
+        FixedSupportItem* support = nullptr;
+        if (msgBox.clickedButton() == leftButton) {
+            support = new FixedSupportItem(firstBeam_x, 50, FixSupportLen, ElementDirection::Left);
+            fixedSupport_left = false;
+        }
+        else if (msgBox.clickedButton() == rightButton) {
+            support = new FixedSupportItem(firstBeam_x, 50, FixSupportLen, ElementDirection::Right);
+            fixedSupport_right = false;
+        }
+        else if (msgBox.clickedButton() == internalButton) {
+            // Промежуточных опор может быть сколько угодно, края они не занимают
+            support = new FixedSupportItem(firstBeam_x, 50, FixSupportLen, ElementDirection::Left);
+            support->setInternal(true);
+            m_scene->addItem(support);
+            ConnectionManager::checkAndSnapNewItem(support, m_scene);
+            support = nullptr;
+        }
+        firstBeam_x += 50;
+
+        if (support) {
+
+            connect(support, &FixedSupportItem::supportDeleted, this,
+                [this](ElementDirection dir) {
+                    if (dir == ElementDirection::Left) {
+                        fixedSupport_left = true;
+                    }
+                    else {
+                        fixedSupport_right = true;
+                    }
+                });
+
+
+            m_scene->addItem(support);
+            ConnectionManager::checkAndSnapNewItem(support, m_scene);
+        }
+        });
+
+    // Добавление силы
+    connect(ui.pushButton_3, &QPushButton::clicked, this, [this]() {
+        auto [o_x, o_y] = getFirstPointBeam();
+
+        ForceItem* item = new ForceItem(o_x, o_y, ElementDirection::Right, 40);
+        m_scene->addItem(item);
+        item->set_Len_fr_beam(1);
+        item->setForce_H(1, 1);
+        });
+    // добавление погонной нагрузки
+    connect(ui.pushButton_7, &QPushButton::clicked, this, [this]() {
+        auto [o_x_1, o_y_1] = getPointBeam(1);
+        auto [o_x_2, o_y_2] = getPointBeam(2);
+        LineLoadItem* lineL = new LineLoadItem(o_x_1, o_y_1, o_x_2, o_y_2, ElementDirection::Right);
+        m_scene->addItem(lineL);
+        lineL->set_LineLoad(1, 1);
+        });
+
+    // Обработка выделения
+    connect(m_scene, &QGraphicsScene::selectionChanged, this, [this]() {
+        BeamItem* selectedBeam = nullptr;
+        ForceItem* selectedForce = nullptr;
+        LineLoadItem* selectedLineLoad = nullptr;
+
+        for (auto item : m_scene->selectedItems()) {
+            if (auto beam = dynamic_cast<BeamItem*>(item)) {
+                if (!beam->isBeingDestroyed()) {
+                    selectedBeam = beam;
+                }
+            }
+            if (auto force = dynamic_cast<ForceItem*>(item)) {
+                selectedForce = force;
+            }
+            if (auto l_load = dynamic_cast<LineLoadItem*>(item)) {
+                selectedLineLoad = l_load;
+            }
+        }
+
+        // --- Балка ---
+        if (selectedBeam) {
+            ui.widget_beam->show();
+            qreal length = std::get<0>(selectedBeam->getParams());
+            auto [d, d2, d3, d4] = selectedBeam->getInfo();
+            ui.textEdit_3->setText(QString::number(qrealToMeters(length)));
+            ui.textEdit_4->setText(QString::number(d2));
+            ui.textEdit_5->setText(QString::number(d3));
+            ui.textEdit_6->setText(QString::number(d4));
+        }
+        else {
+            ui.widget_beam->hide();
+            ui.textEdit_3->clear();
+            ui.textEdit_4->clear();
+            ui.textEdit_5->clear();
+            ui.textEdit_6->clear();
+        }
+        // --- Сила ---
+        if (selectedForce) {
+            ui.widget_force->show();
+            auto [d_l, d_f_h, pos_beam] = selectedForce->getInfo();
+            ui.textEdit_7->setText(QString::number(pos_beam));
+            ui.textEdit_8->setText(QString::number(d_f_h));
+        }
+        else {
+            ui.widget_force->hide();
+            ui.textEdit_7->clear();
+            ui.textEdit_8->clear();
+        }
+        // --- погонная нагрузка ---
+        if (selectedLineLoad) {
+            auto [forc_line, beamD] = selectedLineLoad->getInfo();
+            ui.textEdit_9->setText(QString::number(beamD));
+            ui.textEdit_11->setText(QString::number(forc_line));
+
+            ui.widget_l_load->show();
+        }
+        else {
+            ui.widget_l_load->hide();
+            ui.textEdit_9->clear();
+            ui.textEdit_11->clear();
+        }
+    });
+
+
+    // Изменение длины балки
+    connect(ui.pushButton_4, &QPushButton::clicked, this, [this]() {
+        QString lengthText = ui.textEdit_3->toPlainText();
+        bool ok;
+
+        qreal newLength = metersToQreal(lengthText.toDouble(&ok));
+   //     qreal newLength = lengthText.toDouble(&ok);
+
+        if (!ok || newLength <= 0) {
+            QMessageBox::warning(this, "Ошибка", "Введите корректное значение длины!");
+            return;
+        }
+
+        BeamItem* selectedBeam = nullptr;
+        for (auto item : m_scene->selectedItems()) {
+            if (auto beam = dynamic_cast<BeamItem*>(item)) {
+                if (!beam->isBeingDestroyed()) {
+                    selectedBeam = beam;
+                    break;
+                }
+            }
+        }
+
+        if (!selectedBeam) {
+            QMessageBox::warning(this, "Ошибка", "Не выбрана балка!");
+            return;
+        }
+        QVector<QTextEdit*> vec = { ui.textEdit_3, ui.textEdit_4, ui.textEdit_5, ui.textEdit_6 };
+        auto d = ui.textEdit_4->toPlainText().toDouble();
+        auto d1 = ui.textEdit_5->toPlainText().toDouble();
+        auto d2 = ui.textEdit_6->toPlainText().toDouble();
+        if (checkAllFilled(vec)) {
+            
+            if (d > 0 && d1 > 0 && d2 > 0) {
+                selectedBeam->setInfo(d, d1, d2);
+                changeBeamLength(selectedBeam, newLength);
+            }
+            else {
+                QMessageBox::information(this, "Info", "Какой-то параметр отрицательный");
+                return;
+            }
+            
+        }
+        else
+        {
+            QMessageBox::information(this, "Info", "не все поля заполнены");
+            return;
+        }
+
+        
+    });
+
+    // Применение параметров силы
+    connect(ui.pushButton_5, &QPushButton::clicked, this, [this]() {
+        ForceItem* forceM = nullptr;
+
+        for (auto item : m_scene->selectedItems()) {
+            if (auto forceTMP = dynamic_cast<ForceItem*>(item)) {
+                forceM = forceTMP;
+                break;
+            }
+        }
+
+        if (forceM) {
+            bool ok1, ok2;
+            int dig = ui.textEdit_7->toPlainText().toInt(&ok1);
+            qreal dig_forc = ui.textEdit_8->toPlainText().toDouble(&ok2);
+
+            int nodeCount = getNodeCount();
+            if (dig < 1 || dig > nodeCount) {
+                QMessageBox::warning(
+                    this,
+                    "Ошибка валидации",
+                    QString("Узел №%1 не существует!\nВсего узлов: %2\nДиапазон: 1-%2")
+                    .arg(dig)
+                    .arg(nodeCount)
+                );
+                return;
+            }
+
+            if (ok1 && ok2) {
+
+                auto [f_ox, f_oy] = getFirstPointBeam();
+                auto [_ox, _oy] = getPointBeam(dig);
+
+                if (dig_forc > 0) {
+                    
+                    forceM->changeDirection(ElementDirection::Right);
+                }
+                else
+                {
+                    forceM->changeDirection(ElementDirection::Left);
+                }
+                
+                forceM->set_Len_fr_beam(_ox - f_ox);
+                forceM->setForce_H(dig_forc, dig);
+            }
+            else {
+                QMessageBox::warning(this, "Ошибка", "Введите корректные числовые значения!");
+            }
+        }
+    });
+    // применение параметров погоннной нагрузки
+    connect(ui.pushButton_6, &QPushButton::clicked, this, [this]() {
+        
+        LineLoadItem* selectedLineLoad = nullptr;
+        for (auto item : m_scene->selectedItems()) {
+            if (auto l_load = dynamic_cast<LineLoadItem*>(item)) {
+                selectedLineLoad = l_load;
+            }
+        }
+        if (selectedLineLoad == nullptr) {
+            return;
+        }
+        bool ok1, ok3;
+        int dig_beam = ui.textEdit_9->toPlainText().toInt(&ok1);
+        qreal line_load = ui.textEdit_11->toPlainText().toDouble(&ok3);
+        
+        if (dig_beam < 1) {
+            QMessageBox::warning(this, "Предупреждение", "Не может быть отрицательным");
+            return;
+        }
+        int beamCount = getBeamCount();
+        if (dig_beam < 1 || dig_beam > beamCount) {
+            QMessageBox::warning(
+                this,
+                "Ошибка валидации",
+                QString("Стержень №%1 не существует!\nВсего стержней: %2\nДиапазон: 1-%2")
+                .arg(dig_beam)
+                .arg(beamCount)
+            );
+            return;
+        }
+        auto [_ox, _oy, _ox2, _oy2] = getPointsBeam(dig_beam);
+        selectedLineLoad->change_loc_joins(_ox, _oy, _ox2, _oy2);
+        selectedLineLoad->set_LineLoad(line_load, dig_beam);
+        if (line_load > 0) {
+            selectedLineLoad->change_direction(ElementDirection::Right);
+        }
+        else {
+            selectedLineLoad->change_direction(ElementDirection::Left);
+        }
+    });
+}
+
+void superBAR::centerWindowOnScreen()
+{ //Центрирование окна по экрану
+    QScreen* screen = QGuiApplication::primaryScreen();
+    if (screen) {
+        QRect screenGeometry = screen->geometry();
+        int x = (screenGeometry.width() - this->width()) / 2;
+        int y = (screenGeometry.height() - this->height()) / 2;
+        this->move(x, y);
+	}
+
+}
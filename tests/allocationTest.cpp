@@ -0,0 +1,144 @@
+// Повторный расчет той же модели не должен выделять память: первый вызов
+// calculateData заполняет буферы процессора, второй идет по ним. Считаются
+// new всех потоков программы; выделения внутри библиотек Qt (у DLL свой
+// operator new) не видны. Отчет строится после расчета в потоке интерфейса
+// (showCalculationResults) и сюда не входит
+#include <QApplication>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include "cProcessor.h"
+
+namespace {
+
+std::atomic<bool> g_counting{ false };
+std::atomic<long long> g_allocations{ 0 };
+
+void* countedAllocation(std::size_t size)
+{
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocation(size); }
+void* operator new[](std::size_t size) { return countedAllocation(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+class AllocationTest {
+public:
+    // Число выделений памяти во втором вызове calculateData для модели
+    static long long secondRunAllocations(std::vector<Core_of_Beam>& beams)
+    {
+        cProcessor processor(&beams);
+        processor.prepareRun();
+
+        processor.calculateData();
+        if (!processor.m_calculationSucceeded) {
+            throw std::runtime_error("first calculation failed");
+        }
+        g_allocations = 0;
+        g_counting = true;
+        processor.calculateData();
+        g_counting = false;
+        if (!processor.m_calculationSucceeded) {
+            throw std::runtime_error("second calculation failed");
+        }
+        return g_allocations;
+    }
+};
+
+namespace {
+
+Core_of_Beam makeBar(int index)
+{
+    Core_of_Beam beam{};
+    beam.Joint_left = { 0, 1000.0, 0.0 };
+    beam.Joint_right = { 0, 0.0, 0.0 };
+    beam.len_L = 1.0 + 0.1 * (index % 5);
+    beam.selectArea_A = 1e-3;
+    beam.maxVoltage = 2.5e8;
+    beam.mod_elasticity = 2e11;
+    // Сила в пролете удваивает точку сетки пост-процессора
+    if (index % 7 == 3) {
+        beam.pointLoads.push_back({ 0.5 * beam.len_L, 500.0 });
+    }
+    return beam;
+}
+
+// Цепочка из count стержней, левый конец закреплен, правый нагружен
+std::vector<Core_of_Beam> makeChain(int count)
+{
+    std::vector<Core_of_Beam> beams;
+    for (int i = 0; i < count; ++i) {
+        beams.push_back(makeBar(i));
+    }
+    beams.front().Joint_left.fixedSupport = 1;
+    beams.back().Joint_right.force_f = 1e4;
+    return beams;
+}
+
+// Стержни i–i+1 и i–i+2: матрица не трехдиагональна, решение — RCM и Холецкий
+std::vector<Core_of_Beam> makeBranched(int numNodes)
+{
+    std::vector<Core_of_Beam> beams;
+    for (int i = 0; i + 1 < numNodes; ++i) {
+        for (int span = 1; span <= 2 && i + span < numNodes; ++span) {
+            Core_of_Beam beam = makeBar(static_cast<int>(beams.size()));
+            beam.node_left = i;
+            beam.node_right = i + span;
+            beams.push_back(beam);
+        }
+    }
+    beams.front().Joint_left.fixedSupport = 1;
+    beams.back().Joint_right.force_f = 1e4;
+    return beams;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Окно процессора не показывается, оконная система не нужна
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    struct Model {
+        const char* name;
+        std::vector<Core_of_Beam> beams;
+    };
+    std::vector<Model> models;
+    models.push_back({ "fixed-size, 10 bars", makeChain(10) });
+    models.push_back({ "chain, 2000 bars", makeChain(2000) });
+    models.push_back({ "skyline, 500 nodes", makeBranched(500) });
+
+    int failures = 0;
+    for (Model& model : models) {
+        try {
+            long long allocations = AllocationTest::secondRunAllocations(model.beams);
+            std::cout << model.name << ": " << allocations << " allocations on the second run\n";
+            if (allocations != 0) {
+                failures++;
+            }
+        }
+        catch (const std::exception& e) {
+            g_counting = false;
+            std::cout << model.name << ": error " << e.what() << "\n";
+            failures++;
+        }
+    }
+    std::cout << (failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
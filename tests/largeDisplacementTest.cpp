@@ -0,0 +1,102 @@
+// Проверки расчета больших перемещений по точному решению: стержень с
+// логарифмической деформацией под силой F на свободном конце удлиняется до
+// l = L·e^(F/EA). Один стержень — точность и квадратичная сходимость
+// Ньютона на последнем шаге нагрузки, цепочка из 10^5 стержней — время расчета
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "geometricSolver.h"
+
+namespace {
+
+// Цепочка из bars одинаковых стержней, узел 0 закреплен, сила в последнем узле
+struct Chain {
+    SparseMatrix K;
+    std::vector<double> B;
+    std::vector<GeometricBar> bars;
+    std::vector<char> fixed;
+    std::vector<double> prescribed;
+};
+
+Chain makeChain(int bars, double stiffness, double length, double force)
+{
+    Chain chain;
+    SparseBuilder builder(bars + 1);
+    for (int i = 0; i < bars; ++i) {
+        builder.add(i, i, stiffness);
+        builder.add(i + 1, i + 1, stiffness);
+        builder.add(i, i + 1, -stiffness);
+        builder.add(i + 1, i, -stiffness);
+        chain.bars.push_back({ i, i + 1, stiffness, length, 0.0 });
+    }
+    chain.K = builder.toCSR();
+    chain.B.assign(bars + 1, 0.0);
+    chain.B[bars] = force;
+    chain.fixed.assign(bars + 1, 0);
+    chain.fixed[0] = 1;
+    chain.prescribed.assign(bars + 1, 0.0);
+    return chain;
+}
+
+std::vector<double> solve(const Chain& chain, GeometricReport& report)
+{
+    GeometricOptions options;
+    SkylineCholesky factor;
+    std::vector<int> perm;
+    return solveLargeDisplacement(chain.K, chain.B, chain.bars, chain.fixed,
+        chain.prescribed, options, factor, perm, report);
+}
+
+// Невязки последнего шага: каждая следующая не больше 10·r², пока
+// не достигнут уровень округления
+bool quadratic(const std::vector<double>& residuals)
+{
+    for (size_t i = 1; i < residuals.size(); ++i) {
+        if (residuals[i] < 1e-12) break;
+        if (residuals[i] > 10.0 * residuals[i - 1] * residuals[i - 1]) return false;
+    }
+    return residuals.size() >= 2;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+
+    // Один стержень L = 2, EA = 3: растяжение и сжатие, F/EA = ±0.5 и ±2
+    const double length = 2.0, stiffness = 1.5;
+    const double EA = stiffness * length;
+    for (double force : { 1.5, -1.5, 6.0, -6.0 }) {
+        Chain chain = makeChain(1, stiffness, length, force);
+        GeometricReport report;
+        std::vector<double> u = solve(chain, report);
+        double exact = length * (std::exp(force / EA) - 1.0);
+        const std::vector<double>& residuals = report.steps.back().residuals;
+        bool ok = std::abs(u[1] - exact) <= 1e-9 * std::abs(exact) && quadratic(residuals);
+        std::printf("bar F = %5.1f: u = %.12f, exact %.12f, residuals", force, u[1], exact);
+        for (double r : residuals) std::printf(" %.1e", r);
+        std::printf("  %s\n", ok ? "ok" : "FAILED");
+        if (!ok) failures++;
+    }
+
+    // Цепочка общей длины 1 и EA = 1 под F = 0.3. Время — для сравнения
+    // между сборками, не проверяется
+    const int bars = 100000;
+    Chain chain = makeChain(bars, 1.0 * bars, 1.0 / bars, 0.3);
+    GeometricReport report;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> u = solve(chain, report);
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    double exact = std::exp(0.3) - 1.0;
+    bool ok = std::abs(u[bars] - exact) <= 1e-8 * exact;
+    std::printf("chain of %d bars: u = %.10f, exact %.10f, %zu steps, %d iterations, "
+        "%d factorizations, %.0f ms  %s\n", bars, u[bars], exact, report.steps.size(),
+        report.iterations, report.factorizations, ms, ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
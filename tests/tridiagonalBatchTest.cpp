@@ -0,0 +1,211 @@
+// Пакетная прогонка: каждое доступное ядро (scalar, AVX2, AVX-512) сверяется
+// с solveThomas по каждой модели, вырожденная модель в любой дорожке дает
+// исключение. Время пакета сравнивается с K решениями по пути findDeltas
+// для цепочек: малые модели — solveFixedSize, остальные — extractTridiagonal
+// и solveTridiagonalParallel
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "fixedSolver.h"
+#include "tridiagSolver.h"
+
+namespace {
+
+struct Model {
+    SparseMatrix A;
+    TridiagonalMatrix T;
+    std::vector<double> b;
+};
+
+// Цепочка из size - 1 стержней со случайной жесткостью, узел 0 закреплен
+// исключением, как в applyBoundaryConditions; floating — без опоры
+Model makeModel(int size, std::mt19937& random, bool floating = false)
+{
+    std::uniform_real_distribution<double> stiffness(1e6, 1e9);
+    std::uniform_real_distribution<double> load(-1e4, 1e4);
+    SparseBuilder builder(size);
+    for (int i = 0; i + 1 < size; ++i) {
+        double k = stiffness(random);
+        builder.add(i, i, k);
+        builder.add(i + 1, i + 1, k);
+        builder.add(i, i + 1, -k);
+        builder.add(i + 1, i, -k);
+    }
+    Model model;
+    model.A = builder.toCSR();
+    model.b.resize(size);
+    for (double& value : model.b) value = load(random);
+    if (!floating) {
+        for (int k = model.A.rowPtr[0]; k < model.A.rowPtr[1]; ++k) {
+            model.A.values[k] = (model.A.colIdx[k] == 0) ? 1.0 : 0.0;
+        }
+        for (int k = model.A.rowPtr[1]; k < model.A.rowPtr[2]; ++k) {
+            if (model.A.colIdx[k] == 0) model.A.values[k] = 0.0;
+        }
+        model.b[0] = 0.0;
+    }
+    extractTridiagonal(model.A, model.T);
+    return model;
+}
+
+double relativeDifference(const std::vector<double>& x, const std::vector<double>& reference)
+{
+    double difference = 0.0, norm = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        difference = std::max(difference, std::abs(x[i] - reference[i]));
+        norm = std::max(norm, std::abs(reference[i]));
+    }
+    return difference / norm;
+}
+
+// ||b - T x||∞ / (||T||∞ ||x||∞ + ||b||∞)
+double backwardError(const Model& model, const std::vector<double>& x)
+{
+    const TridiagonalMatrix& T = model.T;
+    const int n = T.size();
+    double residual = 0.0, matrixNorm = 0.0, xNorm = 0.0, bNorm = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double row = T.diag[i] * x[i];
+        double rowNorm = std::abs(T.diag[i]);
+        if (i > 0) {
+            row += T.lower[i] * x[i - 1];
+            rowNorm += std::abs(T.lower[i]);
+        }
+        if (i + 1 < n) {
+            row += T.upper[i] * x[i + 1];
+            rowNorm += std::abs(T.upper[i]);
+        }
+        residual = std::max(residual, std::abs(model.b[i] - row));
+        matrixNorm = std::max(matrixNorm, rowNorm);
+        xNorm = std::max(xNorm, std::abs(x[i]));
+        bNorm = std::max(bNorm, std::abs(model.b[i]));
+    }
+    return residual / (matrixNorm * xNorm + bNorm);
+}
+
+const char* name(BatchInstructionSet set)
+{
+    switch (set) {
+    case BatchInstructionSet::Avx2: return "AVX2";
+    case BatchInstructionSet::Avx512: return "AVX-512";
+    default: return "scalar";
+    }
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 random(7);
+    int failures = 0;
+    const BatchInstructionSet sets[] = {
+        BatchInstructionSet::Scalar, BatchInstructionSet::Avx2, BatchInstructionSet::Avx512 };
+    std::printf("kernel selected at run time: %s\n", TridiagonalBatch::instructionSet());
+
+    // Сверка с solveThomas; число моделей не кратно 8, чтобы были пустые дорожки
+    for (int size : { 2, 12, 200 }) {
+        const int count = 37;
+        std::vector<Model> models;
+        for (int m = 0; m < count; ++m) models.push_back(makeModel(size, random));
+
+        for (BatchInstructionSet set : sets) {
+            if (!TridiagonalBatch::supports(set)) {
+                std::printf("size %3d, %-7s: not supported, skipped\n", size, name(set));
+                continue;
+            }
+            TridiagonalBatch batch(size, count);
+            for (int m = 0; m < count; ++m) batch.setModel(m, models[m].T, models[m].b);
+            batch.solve(set);
+            // Ядра отличаются от solveThomas округлением (AVX-512 — еще и FMA):
+            // расхождение ограничено обусловленностью, обратная ошибка — eps
+            double worstDifference = 0.0, worstResidual = 0.0;
+            for (int m = 0; m < count; ++m) {
+                std::vector<double> x = batch.solution(m);
+                worstDifference = std::max(worstDifference,
+                    relativeDifference(x, solveThomas(models[m].T, models[m].b)));
+                worstResidual = std::max(worstResidual, backwardError(models[m], x));
+            }
+            bool ok = worstDifference <= 1e-9 && worstResidual <= 1e-14;
+            std::printf("size %3d, %-7s: difference from Thomas %.1e, backward error %.1e  %s\n",
+                size, name(set), worstDifference, worstResidual, ok ? "ok" : "FAILED");
+            if (!ok) failures++;
+        }
+    }
+
+    // Модель без опор вырождена: исключение, в какой бы дорожке она ни стояла
+    for (BatchInstructionSet set : sets) {
+        if (!TridiagonalBatch::supports(set)) continue;
+        for (int lane : { 0, 5, 8, 18 }) {
+            const int size = 50, count = 19;
+            TridiagonalBatch batch(size, count);
+            for (int m = 0; m < count; ++m) {
+                Model model = makeModel(size, random, m == lane);
+                batch.setModel(m, model.T, model.b);
+            }
+            bool thrown = false;
+            try {
+                batch.solve(set);
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            std::printf("%-7s: floating model in lane %2d %s\n", name(set), lane,
+                thrown ? "detected  ok" : "not detected  FAILED");
+            if (!thrown) failures++;
+        }
+    }
+
+    // Пропускная способность: K моделей по одной, как в findDeltas, и пакетом.
+    // Пакет создается заранее — в серии расчетов он один на все прогоны; его
+    // заполнение берет диагонали из той же собранной матрицы. Время —
+    // лучшее из нескольких повторов, для сравнения между сборками, не проверяется
+    for (int size : { 12, 64, 1000 }) {
+        const int count = std::max(64, 1000000 / size);
+        std::vector<Model> models;
+        for (int m = 0; m < count; ++m) models.push_back(makeModel(size, random));
+        TridiagonalBatch batch(size, count);
+        TridiagonalMatrix chain;
+        std::vector<double> deltas, sweep;
+
+        double sequentialMs = 1e300, fillMs = 1e300, solveMs = 1e300;
+        for (int repeat = 0; repeat < 5; ++repeat) {
+            auto start = std::chrono::steady_clock::now();
+            for (const Model& model : models) {
+                if (size <= FixedSolverMaxSize) {
+                    solveFixedSize(model.A, model.b, deltas);
+                }
+                else {
+                    extractTridiagonal(model.A, chain);
+                    solveTridiagonalParallel(chain, model.b, deltas, sweep);
+                }
+            }
+            sequentialMs = std::min(sequentialMs, elapsedMs(start));
+
+            start = std::chrono::steady_clock::now();
+            for (int m = 0; m < count; ++m) {
+                batch.setModel(m, models[m].A, models[m].b);
+            }
+            fillMs = std::min(fillMs, elapsedMs(start));
+            start = std::chrono::steady_clock::now();
+            batch.solve();
+            solveMs = std::min(solveMs, elapsedMs(start));
+        }
+
+        std::printf("%6d models of %4d nodes: one by one %7.1f ms; batch (%s) fill %7.1f ms "
+            "+ solve %6.1f ms, speedup %.1f (solve alone %.1f)\n", count, size, sequentialMs,
+            TridiagonalBatch::instructionSet(), fillMs, solveMs,
+            sequentialMs / (fillMs + solveMs), sequentialMs / solveMs);
+    }
+
+    std::printf(failures ? "FAILED\n" : "OK\n");
+    return failures ? 1 : 0;
+}
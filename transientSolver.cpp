@@ -0,0 +1,323 @@
+#include "transientSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "tridiagSolver.h"
+
+namespace {
+
+// Произведение A·x: цепочка — по трем диагоналям (цикл векторизуется),
+// остальные топологии — по CSR
+class Operator {
+public:
+    explicit Operator(const SparseMatrix& A) : m_A(A), m_isChain(extractTridiagonal(A, m_chain)) {}
+
+    void apply(const std::vector<double>& x, std::vector<double>& y) const
+    {
+        if (!m_isChain) {
+            m_A.multiply(x, y);
+            return;
+        }
+        const int n = m_chain.size();
+        y.resize(n);
+        if (n == 1) {
+            y[0] = m_chain.diag[0] * x[0];
+            return;
+        }
+        const double* lower = m_chain.lower.data();
+        const double* diag = m_chain.diag.data();
+        const double* upper = m_chain.upper.data();
+        y[0] = diag[0] * x[0] + upper[0] * x[1];
+        for (int i = 1; i < n - 1; ++i) {
+            y[i] = lower[i] * x[i - 1] + diag[i] * x[i] + upper[i] * x[i + 1];
+        }
+        y[n - 1] = lower[n - 1] * x[n - 2] + diag[n - 1] * x[n - 1];
+    }
+
+private:
+    const SparseMatrix& m_A;
+    TridiagonalMatrix m_chain;
+    bool m_isChain;
+};
+
+// Значения узлов и стержней вывода на каждом шаге: пики — по всем шагам,
+// в файл — каждый outputEvery-й. Записи копятся в буфере и сбрасываются
+// в поток блоками
+class Recorder {
+public:
+    Recorder(std::ostream& out, const TransientOptions& options, double dt,
+        const std::vector<BarForceProbe>& bars, TransientReport& report)
+        : m_out(out), m_nodes(options.outputNodes), m_bars(bars),
+        m_every(std::max(1, options.outputEvery)), m_report(report)
+    {
+        m_report.peakDisplacement.assign(m_nodes.size(), 0.0);
+        m_report.peakDisplacementTime.assign(m_nodes.size(), 0.0);
+        m_report.peakForce.assign(m_bars.size(), 0.0);
+        m_report.peakForceTime.assign(m_bars.size(), 0.0);
+
+        m_out.write("SBTR", 4);
+        put<std::int32_t>(1);
+        put<std::int32_t>(static_cast<std::int32_t>(m_nodes.size()));
+        put<std::int32_t>(static_cast<std::int32_t>(m_bars.size()));
+        put<double>(dt);
+        put<std::int32_t>(m_every);
+        m_countPos = m_out.tellp();
+        put<std::int64_t>(0);
+        for (int node : m_nodes) put<std::int32_t>(node);
+        for (const BarForceProbe& bar : m_bars) put<std::int32_t>(bar.bar);
+        m_buffer.reserve(BufferSize + (1 + m_nodes.size() + m_bars.size()) * sizeof(double));
+    }
+
+    void record(long long step, double t, const std::vector<double>& u)
+    {
+        bool write = step % m_every == 0;
+        if (write) append(t);
+        for (size_t k = 0; k < m_nodes.size(); ++k) {
+            double value = u[m_nodes[k]];
+            if (write) append(value);
+            if (std::abs(value) > m_report.peakDisplacement[k]) {
+                m_report.peakDisplacement[k] = std::abs(value);
+                m_report.peakDisplacementTime[k] = t;
+            }
+        }
+        for (size_t k = 0; k < m_bars.size(); ++k) {
+            const BarForceProbe& bar = m_bars[k];
+            double N = bar.stiffness * (u[bar.nodeRight] - u[bar.nodeLeft]) + bar.offset;
+            if (write) append(N);
+            if (std::abs(N) > m_report.peakForce[k]) {
+                m_report.peakForce[k] = std::abs(N);
+                m_report.peakForceTime[k] = t;
+            }
+        }
+        if (write) {
+            ++m_report.records;
+            if (m_buffer.size() >= BufferSize) flush();
+        }
+    }
+
+    // Число записей известно только в конце: дописывается в заголовок
+    void finish()
+    {
+        flush();
+        std::streampos end = m_out.tellp();
+        if (m_countPos != std::streampos(-1) && end != std::streampos(-1)) {
+            m_out.seekp(m_countPos);
+            put<std::int64_t>(m_report.records);
+            m_out.seekp(end);
+        }
+        m_out.flush();
+        if (!m_out) {
+            throw std::runtime_error("Failed to write transient results");
+        }
+    }
+
+private:
+    static constexpr size_t BufferSize = 1 << 20;
+
+    std::ostream& m_out;
+    const std::vector<int>& m_nodes;
+    const std::vector<BarForceProbe>& m_bars;
+    int m_every;
+    TransientReport& m_report;
+    std::streampos m_countPos;
+    std::vector<char> m_buffer;
+
+    template <typename T>
+    void put(T value)
+    {
+        m_out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void append(double value)
+    {
+        size_t size = m_buffer.size();
+        m_buffer.resize(size + sizeof(double));
+        std::memcpy(m_buffer.data() + size, &value, sizeof(double));
+    }
+
+    void flush()
+    {
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+};
+
+// Исключение опорных узлов: строка и столбец обнуляются, на диагонали 1
+void eliminateFixed(SparseMatrix& A, const std::vector<char>& fixed)
+{
+    for (int i = 0; i < A.n; ++i) {
+        for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+            int j = A.colIdx[k];
+            if (fixed[i] || fixed[j]) {
+                A.values[k] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+}
+
+} // namespace
+
+double criticalTimeStep(const SparseMatrix& K, const std::vector<double>& lumpedMass,
+    const std::vector<char>& fixed)
+{
+    double omegaSquared = 0.0;
+    for (int i = 0; i < K.n; ++i) {
+        if (fixed[i] || !(lumpedMass[i] > 0.0)) continue;
+        double row = 0.0;
+        for (int k = K.rowPtr[i]; k < K.rowPtr[i + 1]; ++k) {
+            int j = K.colIdx[k];
+            if (j != i && (fixed[j] || !(lumpedMass[j] > 0.0))) continue;
+            row += std::abs(K.values[k]) / std::sqrt(lumpedMass[i] * lumpedMass[j]);
+        }
+        omegaSquared = std::max(omegaSquared, row);
+    }
+    return omegaSquared > 0.0 ? 2.0 / std::sqrt(omegaSquared) : std::numeric_limits<double>::infinity();
+}
+
+void runTransient(const SparseMatrix& K, const SparseMatrix& M, const std::vector<double>& loads,
+    const std::vector<NodalForceHistory>& histories, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const std::vector<BarForceProbe>& bars,
+    const TransientOptions& options, std::ostream& out, TransientReport& report)
+{
+    const int n = K.n;
+    if (M.n != n || static_cast<int>(loads.size()) != n) {
+        throw std::invalid_argument("Transient matrices and loads differ in size");
+    }
+    if (options.timeStep < 0.0 || options.steps < 0) {
+        throw std::invalid_argument("Time step and step count must not be negative");
+    }
+    for (int node : options.outputNodes) {
+        if (node < 0 || node >= n) throw std::invalid_argument("Output node is out of range");
+    }
+
+    // Сосредоточенная масса — суммы строк M
+    std::vector<double> lumped(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int k = M.rowPtr[i]; k < M.rowPtr[i + 1]; ++k) {
+            lumped[i] += M.values[k];
+        }
+        if (!fixed[i] && !(lumped[i] > 0.0)) {
+            throw std::runtime_error("Mass must be positive at every free node");
+        }
+    }
+
+    report = TransientReport();
+    report.criticalStep = criticalTimeStep(K, lumped, fixed);
+    const double dt = options.timeStep > 0.0 ? options.timeStep : 0.9 * report.criticalStep;
+    if (!std::isfinite(dt)) {
+        throw std::runtime_error("Time step cannot be derived: the model has no stiffness");
+    }
+    report.timeStep = dt;
+
+    std::vector<double> u(n, 0.0), v(n, 0.0), a(n, 0.0), f(n), r(n);
+    for (int i = 0; i < n; ++i) {
+        if (fixed[i]) u[i] = prescribed[i];
+    }
+    auto loadAt = [&](double t) {
+        std::copy(loads.begin(), loads.end(), f.begin());
+        for (const NodalForceHistory& history : histories) {
+            f[history.node] += history.force.at(t);
+        }
+    };
+
+    Recorder recorder(out, options, dt, bars, report);
+    recorder.record(0, 0.0, u);
+    const Operator stiffness(K);
+
+    if (options.integrator == TimeIntegrator::CentralDifference) {
+        if (dt > report.criticalStep) {
+            throw std::runtime_error("Time step exceeds the central difference stability limit");
+        }
+        std::vector<double> inverseMass(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            if (!fixed[i]) inverseMass[i] = 1.0 / lumped[i];
+        }
+
+        // Схема «чехарда»: v на полушагах, v(Δt/2) = v(0) + Δt/2 · a(0)
+        for (long long step = 0; step < options.steps; ++step) {
+            loadAt(step * dt);
+            stiffness.apply(u, r);
+            const double h = (step == 0) ? 0.5 * dt : dt;
+            for (int i = 0; i < n; ++i) {
+                v[i] += h * (f[i] - r[i]) * inverseMass[i];
+                u[i] += dt * v[i];
+            }
+            recorder.record(step + 1, (step + 1) * dt, u);
+        }
+    }
+    else {
+        const double beta = options.beta;
+        const double gamma = options.gamma;
+        const double c0 = 1.0 / (beta * dt * dt);
+        const double c1 = 1.0 / (beta * dt);
+        const double c2 = 1.0 / (2.0 * beta) - 1.0;
+
+        // K_eff = K + M / (β Δt²) раскладывается один раз. Вклад заданных
+        // перемещений опор постоянен и переносится в правую часть заранее
+        SparseBuilder builder(n);
+        builder.reserve(K.nonZeros() + M.nonZeros());
+        for (int i = 0; i < n; ++i) {
+            for (int k = K.rowPtr[i]; k < K.rowPtr[i + 1]; ++k) builder.add(i, K.colIdx[k], K.values[k]);
+            for (int k = M.rowPtr[i]; k < M.rowPtr[i + 1]; ++k) builder.add(i, M.colIdx[k], c0 * M.values[k]);
+        }
+        SparseMatrix effective = builder.toCSR();
+        std::vector<double> supports(n, 0.0), correction(n);
+        for (int i = 0; i < n; ++i) {
+            if (fixed[i]) supports[i] = prescribed[i];
+        }
+        effective.multiply(supports, correction);
+        eliminateFixed(effective, fixed);
+
+        std::vector<int> perm = reverseCuthillMcKee(effective);
+        SkylineCholesky factor;
+        factor.factorize(effective, perm);
+
+        // Начальное ускорение из M a(0) = F(0) - K u(0) по свободным узлам
+        {
+            SparseMatrix mass = M;
+            eliminateFixed(mass, fixed);
+            SkylineCholesky massFactor;
+            massFactor.factorize(mass, perm);
+            loadAt(0.0);
+            stiffness.apply(u, r);
+            for (int i = 0; i < n; ++i) {
+                r[i] = fixed[i] ? 0.0 : f[i] - r[i];
+            }
+            massFactor.solve(r, a);
+        }
+
+        const Operator mass(M);
+        std::vector<double> w(n), Mw(n), rhs(n), uNext(n);
+        for (long long step = 0; step < options.steps; ++step) {
+            const double t = (step + 1) * dt;
+            loadAt(t);
+            for (int i = 0; i < n; ++i) {
+                w[i] = c0 * u[i] + c1 * v[i] + c2 * a[i];
+            }
+            mass.apply(w, Mw);
+            for (int i = 0; i < n; ++i) {
+                rhs[i] = fixed[i] ? prescribed[i] : f[i] + Mw[i] - correction[i];
+            }
+            factor.solve(rhs, uNext);
+            for (int i = 0; i < n; ++i) {
+                if (fixed[i]) {
+                    uNext[i] = prescribed[i];
+                    a[i] = 0.0;
+                    v[i] = 0.0;
+                    continue;
+                }
+                double aNext = c0 * (uNext[i] - u[i]) - c1 * v[i] - c2 * a[i];
+                v[i] += dt * ((1.0 - gamma) * a[i] + gamma * aNext);
+                a[i] = aNext;
+            }
+            u.swap(uNext);
+            recorder.record(step + 1, t, u);
+        }
+    }
+
+    report.steps = options.steps;
+    recorder.finish();
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include "sparseSolver.h"
+#include "lineLoad.h"
+
+enum class TimeIntegrator {
+    CentralDifference,   // явная, сосредоточенная масса, шаг не больше критического
+    Newmark              // неявная, одно разложение K + M / (β Δt²) на весь расчет
+};
+
+// Узловая сила F(t), добавляется к постоянной нагрузке
+struct NodalForceHistory {
+    int node;
+    LoadHistory force;
+};
+
+// Стержень, усилие которого пишется в файл: среднее по длине
+// N = k·(u_right - u_left) + offset, offset — от пролетных нагрузок и ε_T
+struct BarForceProbe {
+    int bar;
+    int nodeLeft;
+    int nodeRight;
+    double stiffness;
+    double offset;
+};
+
+struct TransientOptions {
+    TimeIntegrator integrator = TimeIntegrator::Newmark;
+    double timeStep = 0.0;       // 0 — 0.9 критического шага центральных разностей
+    long long steps = 0;
+    double beta = 0.25;          // β = 1/4, γ = 1/2 — средние ускорения,
+    double gamma = 0.5;          // безусловно устойчива, без численного затухания
+    int outputEvery = 1;         // запись каждого k-го шага
+    std::vector<int> outputNodes;
+};
+
+struct TransientReport {
+    long long steps = 0;
+    long long records = 0;
+    double timeStep = 0.0;                   // фактический шаг
+    double criticalStep = 0.0;               // устойчивости центральных разностей
+    std::vector<double> peakDisplacement;    // max |u| по outputNodes
+    std::vector<double> peakDisplacementTime;
+    std::vector<double> peakForce;           // max |N| по стержням вывода
+    std::vector<double> peakForceTime;
+};
+
+// Критический шаг центральных разностей Δt = 2 / ω_max. ω_max² оценивается
+// сверху кругами Гершгорина для M^-1/2 K M^-1/2 по свободным узлам,
+// поэтому шаг получается с запасом
+double criticalTimeStep(const SparseMatrix& K, const std::vector<double>& lumpedMass,
+    const std::vector<char>& fixed);
+
+// Интегрирование M ü + K u = F(t) от покоя: u(0) = 0, в опорных узлах —
+// заданные перемещения, постоянная нагрузка loads действует с t = 0.
+// Результаты пишутся в out по мере счета, память не зависит от числа шагов.
+// Формат (little-endian):
+//   char[4] "SBTR", int32 версия = 1, int32 число узлов, int32 число стержней,
+//   double Δt, int32 шаг записи, int64 число записей,
+//   int32 номера узлов, int32 номера стержней,
+//   записи: double t, double u[узлы], double N[стержни]
+void runTransient(const SparseMatrix& K, const SparseMatrix& M, const std::vector<double>& loads,
+    const std::vector<NodalForceHistory>& histories, const std::vector<char>& fixed,
+    const std::vector<double>& prescribed, const std::vector<BarForceProbe>& bars,
+    const TransientOptions& options, std::ostream& out, TransientReport& report);
@@ -0,0 +1,505 @@
+#include "tridiagSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <QtConcurrent>
+
+// Ядра пакетной прогонки под AVX2 и AVX-512 собираются всегда, без /arch:
+// MSVC допускает их встроенные функции в любом коде, GCC и Clang — с атрибутом
+// target. Выбор — при запуске, по CPUID
+#if defined(_M_X64) || defined(__x86_64__)
+#define BATCH_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#else
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#else
+#define BATCH_SIMD 0
+#endif
+
+bool extractTridiagonal(const SparseMatrix& A, TridiagonalMatrix& T)
+{
+    const int n = A.n;
+    T.lower.assign(n, 0.0);
+    T.diag.assign(n, 0.0);
+    T.upper.assign(n, 0.0);
+
+    for (int i = 0; i < n; ++i) {
+        for (int k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+            int j = A.colIdx[k];
+            if (j == i - 1) T.lower[i] = A.values[k];
+            else if (j == i) T.diag[i] = A.values[k];
+            else if (j == i + 1) T.upper[i] = A.values[k];
+            else if (A.values[k] != 0.0) return false;
+        }
+    }
+    return true;
+}
+
+// Ведущий элемент проверяется относительно исходной диагонали, как в
+// разложении Холецкого: у вырожденной цепочки (нет опор) он выходит порядка
+// ошибки округления, а не нулем
+constexpr double RelativePivotTolerance = 1e-12;
+constexpr double TinyPivot = 1e-300;
+
+static void checkPivot(double pivot, double diagonal)
+{
+    double magnitude = std::abs(pivot);
+    if (!(magnitude > RelativePivotTolerance * std::abs(diagonal)) || magnitude < TinyPivot) {
+        throw std::runtime_error("Matrix is singular");
+    }
+}
+
+std::vector<double> solveThomas(const TridiagonalMatrix& T, const std::vector<double>& b)
+{
+    std::vector<double> x, sweep;
+    solveThomas(T, b, x, sweep);
+    return x;
+}
+
+void solveThomas(const TridiagonalMatrix& T, const std::vector<double>& b,
+    std::vector<double>& x, std::vector<double>& sweep)
+{
+    const int n = T.size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+    x.resize(n);
+    sweep.resize(n);
+    if (n == 0) return;
+
+    std::vector<double>& c = sweep;
+    double pivot = T.diag[0];
+    checkPivot(pivot, T.diag[0]);
+    c[0] = T.upper[0] / pivot;
+    x[0] = b[0] / pivot;
+
+    for (int i = 1; i < n; ++i) {
+        pivot = T.diag[i] - T.lower[i] * c[i - 1];
+        checkPivot(pivot, T.diag[i]);
+        c[i] = T.upper[i] / pivot;
+        x[i] = (b[i] - T.lower[i] * x[i - 1]) / pivot;
+    }
+    for (int i = n - 2; i >= 0; --i) {
+        x[i] -= c[i] * x[i + 1];
+    }
+}
+
+// Прогонка внутреннего блока [begin, end) сразу для трех правых частей:
+// g — от нагрузки, v — от единичного левого разделителя, w — от правого
+static void solveBlock(const TridiagonalMatrix& T, const std::vector<double>& b,
+    int begin, int end, std::vector<double>& c,
+    std::vector<double>& g, std::vector<double>& v, std::vector<double>& w)
+{
+    const int n = T.size();
+    const double leftCoupling = (begin > 0) ? -T.lower[begin] : 0.0;
+    const double rightCoupling = (end < n) ? -T.upper[end - 1] : 0.0;
+
+    double pivot = T.diag[begin];
+    checkPivot(pivot, T.diag[begin]);
+    c[begin] = T.upper[begin] / pivot;
+    g[begin] = b[begin] / pivot;
+    v[begin] = leftCoupling / pivot;
+    w[begin] = 0.0;
+
+    for (int i = begin + 1; i < end; ++i) {
+        pivot = T.diag[i] - T.lower[i] * c[i - 1];
+        checkPivot(pivot, T.diag[i]);
+        c[i] = T.upper[i] / pivot;
+        g[i] = (b[i] - T.lower[i] * g[i - 1]) / pivot;
+        v[i] = (-T.lower[i] * v[i - 1]) / pivot;
+        w[i] = ((i == end - 1 ? rightCoupling : 0.0) - T.lower[i] * w[i - 1]) / pivot;
+    }
+    for (int i = end - 2; i >= begin; --i) {
+        g[i] -= c[i] * g[i + 1];
+        v[i] -= c[i] * v[i + 1];
+        w[i] -= c[i] * w[i + 1];
+    }
+}
+
+std::vector<double> solveTridiagonalParallel(const TridiagonalMatrix& T,
+    const std::vector<double>& b, int threads)
+{
+    std::vector<double> x, sweep;
+    solveTridiagonalParallel(T, b, x, sweep, threads);
+    return x;
+}
+
+void solveTridiagonalParallel(const TridiagonalMatrix& T, const std::vector<double>& b,
+    std::vector<double>& x, std::vector<double>& sweep, int threads)
+{
+    const int n = T.size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+
+    if (threads <= 0) {
+        threads = QThreadPool::globalInstance()->maxThreadCount();
+    }
+    // Блоки короче нескольких тысяч узлов не окупают синхронизацию
+    const int minBlock = 4096;
+    const int blocks = std::min(threads, n / minBlock);
+    if (blocks < 2) {
+        solveThomas(T, b, x, sweep);
+        return;
+    }
+
+    // Разделитель k стоит между блоками k и k+1
+    std::vector<int> separator(blocks - 1);
+    for (int k = 0; k < blocks - 1; ++k) {
+        separator[k] = static_cast<int>(static_cast<long long>(n) * (k + 1) / blocks);
+    }
+    auto blockBegin = [&](int k) { return (k == 0) ? 0 : separator[k - 1] + 1; };
+    auto blockEnd = [&](int k) { return (k == blocks - 1) ? n : separator[k]; };
+
+    std::vector<double>& c = sweep;
+    c.resize(n);
+    std::vector<double> g(n), v(n), w(n);
+    std::vector<int> blockIds(blocks);
+    std::iota(blockIds.begin(), blockIds.end(), 0);
+
+    // 1. Независимые прогонки по блокам
+    QtConcurrent::blockingMap(blockIds, [&](int k) {
+        solveBlock(T, b, blockBegin(k), blockEnd(k), c, g, v, w);
+        });
+
+    // 2. Система разделителей: строка s связывает последний узел блока k
+    //    и первый узел блока k+1, каждый выражен через разделители
+    const int m = blocks - 1;
+    TridiagonalMatrix reduced;
+    reduced.lower.assign(m, 0.0);
+    reduced.diag.assign(m, 0.0);
+    reduced.upper.assign(m, 0.0);
+    std::vector<double> reducedRhs(m);
+
+    for (int k = 0; k < m; ++k) {
+        const int s = separator[k];
+        const int left = s - 1;    // последний узел блока k
+        const int right = s + 1;   // первый узел блока k+1
+        const double a = T.lower[s];
+        const double cs = T.upper[s];
+
+        reduced.diag[k] = T.diag[s] + a * w[left] + cs * v[right];
+        if (k > 0) reduced.lower[k] = a * v[left];
+        if (k < m - 1) reduced.upper[k] = cs * w[right];
+        reducedRhs[k] = b[s] - a * g[left] - cs * g[right];
+    }
+    std::vector<double> xs = solveThomas(reduced, reducedRhs);
+
+    // 3. Параллельная досборка решения по блокам
+    x.resize(n);
+    for (int k = 0; k < m; ++k) {
+        x[separator[k]] = xs[k];
+    }
+    QtConcurrent::blockingMap(blockIds, [&](int k) {
+        const double xl = (k > 0) ? xs[k - 1] : 0.0;
+        const double xr = (k < m) ? xs[k] : 0.0;
+        for (int i = blockBegin(k); i < blockEnd(k); ++i) {
+            x[i] = g[i] + v[i] * xl + w[i] * xr;
+        }
+        });
+}
+
+// ==================== ПАКЕТНАЯ ПРОГОНКА ====================
+
+namespace {
+
+// Дорожек в векторе AVX-512; stride кратен ей, подходит и для AVX2
+constexpr int BatchLanes = 8;
+
+// Модели прогоняются группами по столько дорожек: прямой и обратный ход
+// группы идут по ее строкам, пока они в кэше. Весь пакет разом не
+// помещается в кэш уже при нескольких тысячах моделей, и прогонка
+// упирается в память
+constexpr int BatchBlockBytes = 256 * 1024;
+constexpr int BatchMaxBlockLanes = 256;
+
+// Ядра прямого и обратного хода для одной строки группы из lanes моделей.
+// Прямой ход возвращает true, если хотя бы у одной модели ведущий элемент
+// мал относительно диагонали или не число. Деление одно на строку модели:
+// c и x умножаются на обратный ведущий элемент
+using ForwardRow = bool (*)(const double* a, const double* d, const double* u, const double* b,
+    const double* cPrev, const double* xPrev, double* c, double* x, int lanes);
+using BackwardRow = void (*)(const double* c, const double* xNext, double* x, int lanes);
+
+bool forwardRowScalar(const double* a, const double* d, const double* u, const double* b,
+    const double* cPrev, const double* xPrev, double* c, double* x, int lanes)
+{
+    bool bad = false;
+    for (int m = 0; m < lanes; ++m) {
+        double pivot = d[m] - a[m] * cPrev[m];
+        bad |= !(std::abs(pivot) > std::max(RelativePivotTolerance * std::abs(d[m]), TinyPivot));
+        double inverse = 1.0 / pivot;
+        c[m] = u[m] * inverse;
+        x[m] = (b[m] - a[m] * xPrev[m]) * inverse;
+    }
+    return bad;
+}
+
+// x -= c * xNext
+void backwardRowScalar(const double* c, const double* xNext, double* x, int lanes)
+{
+    for (int m = 0; m < lanes; ++m) {
+        x[m] -= c[m] * xNext[m];
+    }
+}
+
+#if BATCH_SIMD
+SIMD_TARGET_AVX2
+bool forwardRowAvx2(const double* a, const double* d, const double* u, const double* b,
+    const double* cPrev, const double* xPrev, double* c, double* x, int lanes)
+{
+    const __m256d tiny = _mm256_set1_pd(TinyPivot);
+    const __m256d relative = _mm256_set1_pd(RelativePivotTolerance);
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256d bad = _mm256_setzero_pd();
+    for (int m = 0; m < lanes; m += 4) {
+        __m256d av = _mm256_loadu_pd(a + m);
+        __m256d dv = _mm256_loadu_pd(d + m);
+        __m256d pivot = _mm256_sub_pd(dv, _mm256_mul_pd(av, _mm256_loadu_pd(cPrev + m)));
+        __m256d rhs = _mm256_sub_pd(_mm256_loadu_pd(b + m), _mm256_mul_pd(av, _mm256_loadu_pd(xPrev + m)));
+        __m256d threshold = _mm256_max_pd(_mm256_mul_pd(relative, _mm256_and_pd(dv, absMask)), tiny);
+        bad = _mm256_or_pd(bad, _mm256_cmp_pd(_mm256_and_pd(pivot, absMask), threshold, _CMP_NGT_UQ));
+        __m256d inverse = _mm256_div_pd(_mm256_set1_pd(1.0), pivot);
+        _mm256_storeu_pd(c + m, _mm256_mul_pd(_mm256_loadu_pd(u + m), inverse));
+        _mm256_storeu_pd(x + m, _mm256_mul_pd(rhs, inverse));
+    }
+    return _mm256_movemask_pd(bad) != 0;
+}
+
+SIMD_TARGET_AVX2
+void backwardRowAvx2(const double* c, const double* xNext, double* x, int lanes)
+{
+    for (int m = 0; m < lanes; m += 4) {
+        _mm256_storeu_pd(x + m, _mm256_sub_pd(_mm256_loadu_pd(x + m),
+            _mm256_mul_pd(_mm256_loadu_pd(c + m), _mm256_loadu_pd(xNext + m))));
+    }
+}
+
+SIMD_TARGET_AVX512
+bool forwardRowAvx512(const double* a, const double* d, const double* u, const double* b,
+    const double* cPrev, const double* xPrev, double* c, double* x, int lanes)
+{
+    const __m512d tiny = _mm512_set1_pd(TinyPivot);
+    const __m512d relative = _mm512_set1_pd(RelativePivotTolerance);
+    __mmask8 bad = 0;
+    for (int m = 0; m < lanes; m += 8) {
+        __m512d av = _mm512_loadu_pd(a + m);
+        __m512d dv = _mm512_loadu_pd(d + m);
+        __m512d pivot = _mm512_fnmadd_pd(av, _mm512_loadu_pd(cPrev + m), dv);
+        __m512d rhs = _mm512_fnmadd_pd(av, _mm512_loadu_pd(xPrev + m), _mm512_loadu_pd(b + m));
+        __m512d threshold = _mm512_max_pd(_mm512_mul_pd(relative, _mm512_abs_pd(dv)), tiny);
+        bad |= _mm512_cmp_pd_mask(_mm512_abs_pd(pivot), threshold, _CMP_NGT_UQ);
+        __m512d inverse = _mm512_div_pd(_mm512_set1_pd(1.0), pivot);
+        _mm512_storeu_pd(c + m, _mm512_mul_pd(_mm512_loadu_pd(u + m), inverse));
+        _mm512_storeu_pd(x + m, _mm512_mul_pd(rhs, inverse));
+    }
+    return bad != 0;
+}
+
+SIMD_TARGET_AVX512
+void backwardRowAvx512(const double* c, const double* xNext, double* x, int lanes)
+{
+    for (int m = 0; m < lanes; m += 8) {
+        _mm512_storeu_pd(x + m, _mm512_fnmadd_pd(_mm512_loadu_pd(c + m),
+            _mm512_loadu_pd(xNext + m), _mm512_loadu_pd(x + m)));
+    }
+}
+
+// Поддержка процессором и ОС: CPUID и сохранение регистров в XCR0
+bool cpuSupports(bool avx512)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (avx512) {
+        return (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    }
+    return (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+#else
+    return avx512 ? __builtin_cpu_supports("avx512f") : __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+struct BatchKernels {
+    ForwardRow forward;
+    BackwardRow backward;
+    const char* name;
+};
+
+// Поддержка наборов проверяется один раз, при первом обращении
+bool kernelsSupported(BatchInstructionSet set)
+{
+#if BATCH_SIMD
+    static const bool avx2 = cpuSupports(false);
+    static const bool avx512 = cpuSupports(true);
+    if (set == BatchInstructionSet::Avx2) return avx2;
+    if (set == BatchInstructionSet::Avx512) return avx512;
+#endif
+    return set == BatchInstructionSet::Scalar;
+}
+
+BatchKernels kernelsFor(BatchInstructionSet set)
+{
+    switch (set) {
+#if BATCH_SIMD
+    case BatchInstructionSet::Avx2:
+        return { forwardRowAvx2, backwardRowAvx2, "AVX2" };
+    case BatchInstructionSet::Avx512:
+        return { forwardRowAvx512, backwardRowAvx512, "AVX-512" };
+#endif
+    default:
+        return { forwardRowScalar, backwardRowScalar, "scalar" };
+    }
+}
+
+// Лучший набор процессора, на котором запущена программа
+BatchInstructionSet bestInstructionSet()
+{
+    if (kernelsSupported(BatchInstructionSet::Avx512)) return BatchInstructionSet::Avx512;
+    if (kernelsSupported(BatchInstructionSet::Avx2)) return BatchInstructionSet::Avx2;
+    return BatchInstructionSet::Scalar;
+}
+
+} // namespace
+
+TridiagonalBatch::TridiagonalBatch(int size, int count)
+    : m_size(size)
+    , m_count(count)
+    , m_stride((count + BatchLanes - 1) / BatchLanes * BatchLanes)
+{
+    if (size <= 0 || count <= 0) {
+        throw std::invalid_argument("Batch must contain at least one non-empty model");
+    }
+    const size_t total = static_cast<size_t>(m_size) * m_stride;
+    // Незаполненные дорожки — уравнения x = 0, они не мешают прогонке
+    m_lower.assign(total, 0.0);
+    m_diag.assign(total, 1.0);
+    m_upper.assign(total, 0.0);
+    m_rhs.assign(total, 0.0);
+    m_x.assign(total, 0.0);
+}
+
+void TridiagonalBatch::setModel(int model, const TridiagonalMatrix& T, const std::vector<double>& b)
+{
+    if (model < 0 || model >= m_count) {
+        throw std::out_of_range("Model index is out of batch range");
+    }
+    if (T.size() != m_size || static_cast<int>(b.size()) != m_size) {
+        throw std::invalid_argument("Model size does not match the batch");
+    }
+    for (int i = 0; i < m_size; ++i) {
+        size_t k = static_cast<size_t>(i) * m_stride + model;
+        m_lower[k] = (i > 0) ? T.lower[i] : 0.0;
+        m_diag[k] = T.diag[i];
+        m_upper[k] = (i < m_size - 1) ? T.upper[i] : 0.0;
+        m_rhs[k] = b[i];
+    }
+}
+
+bool TridiagonalBatch::setModel(int model, const SparseMatrix& A, const std::vector<double>& b)
+{
+    if (model < 0 || model >= m_count) {
+        throw std::out_of_range("Model index is out of batch range");
+    }
+    if (A.n != m_size || static_cast<int>(b.size()) != m_size) {
+        throw std::invalid_argument("Model size does not match the batch");
+    }
+    for (int i = 0; i < m_size; ++i) {
+        size_t k = static_cast<size_t>(i) * m_stride + model;
+        double lower = 0.0, diag = 0.0, upper = 0.0;
+        for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+            int j = A.colIdx[p];
+            if (j == i - 1) lower = A.values[p];
+            else if (j == i) diag = A.values[p];
+            else if (j == i + 1) upper = A.values[p];
+            else if (A.values[p] != 0.0) return false;
+        }
+        m_lower[k] = lower;
+        m_diag[k] = diag;
+        m_upper[k] = upper;
+        m_rhs[k] = b[i];
+    }
+    return true;
+}
+
+void TridiagonalBatch::solve()
+{
+    solve(bestInstructionSet());
+}
+
+void TridiagonalBatch::solve(BatchInstructionSet set)
+{
+    if (!kernelsSupported(set)) {
+        throw std::invalid_argument("Instruction set is not supported by this processor");
+    }
+    const BatchKernels kernels = kernelsFor(set);
+
+    // Группа — кратное BatchLanes число моделей, строки которой (шесть
+    // массивов) занимают около BatchBlockBytes
+    const size_t rowBytes = static_cast<size_t>(m_size) * 6 * sizeof(double);
+    const int fit = static_cast<int>(BatchBlockBytes / rowBytes) / BatchLanes * BatchLanes;
+    const int blockLanes = std::min({ std::max(fit, BatchLanes), BatchMaxBlockLanes, m_stride });
+
+    // Для первой строки предыдущей нет: lower = 0, подставляем нули.
+    // Прогоночные коэффициенты нужны только внутри группы: их строки — по blockLanes
+    std::vector<double> zeros(blockLanes, 0.0);
+    m_c.resize(static_cast<size_t>(m_size) * blockLanes);
+    bool singular = false;
+
+    for (int first = 0; first < m_stride; first += blockLanes) {
+        const int lanes = std::min(blockLanes, m_stride - first);
+        for (int i = 0; i < m_size; ++i) {
+            size_t row = static_cast<size_t>(i) * m_stride + first;
+            double* c = &m_c[static_cast<size_t>(i) * blockLanes];
+            const double* cPrev = (i > 0) ? c - blockLanes : zeros.data();
+            const double* xPrev = (i > 0) ? &m_x[row - m_stride] : zeros.data();
+            singular |= kernels.forward(&m_lower[row], &m_diag[row], &m_upper[row], &m_rhs[row],
+                cPrev, xPrev, c, &m_x[row], lanes);
+        }
+        for (int i = m_size - 2; i >= 0; --i) {
+            size_t row = static_cast<size_t>(i) * m_stride + first;
+            kernels.backward(&m_c[static_cast<size_t>(i) * blockLanes],
+                &m_x[row + m_stride], &m_x[row], lanes);
+        }
+    }
+    if (singular) {
+        throw std::runtime_error("Matrix is singular");
+    }
+}
+
+std::vector<double> TridiagonalBatch::solution(int model) const
+{
+    if (model < 0 || model >= m_count) {
+        throw std::out_of_range("Model index is out of batch range");
+    }
+    std::vector<double> x(m_size);
+    for (int i = 0; i < m_size; ++i) {
+        x[i] = m_x[static_cast<size_t>(i) * m_stride + model];
+    }
+    return x;
+}
+
+const char* TridiagonalBatch::instructionSet()
+{
+    return kernelsFor(bestInstructionSet()).name;
+}
+
+bool TridiagonalBatch::supports(BatchInstructionSet set)
+{
+    return kernelsSupported(set);
+}
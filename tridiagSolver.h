@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include "sparseSolver.h"
+
+// Трехдиагональная матрица цепочки стержней
+struct TridiagonalMatrix {
+    std::vector<double> lower;   // lower[i] = A(i, i-1), lower[0] не используется
+    std::vector<double> diag;    // diag[i]  = A(i, i)
+    std::vector<double> upper;   // upper[i] = A(i, i+1), последний не используется
+
+    int size() const { return static_cast<int>(diag.size()); }
+};
+
+// Копирует три диагонали; false, если в A есть элементы вне них
+bool extractTridiagonal(const SparseMatrix& A, TridiagonalMatrix& T);
+
+// Последовательная прогонка (алгоритм Томаса)
+std::vector<double> solveThomas(const TridiagonalMatrix& T, const std::vector<double>& b);
+// То же в готовые буферы: sweep — прогоночные коэффициенты
+void solveThomas(const TridiagonalMatrix& T, const std::vector<double>& b,
+    std::vector<double>& x, std::vector<double>& sweep);
+
+// Разбиение цепочки на блоки по потокам. Между блоками остаются узлы-разделители;
+// внутри блока решение выражается через соседние разделители
+//   x = g + v * x_левый + w * x_правый,
+// разделители связаны малой трехдиагональной системой, после нее блоки
+// досчитываются параллельно. threads = 0 — по числу потоков пула
+std::vector<double> solveTridiagonalParallel(const TridiagonalMatrix& T,
+    const std::vector<double>& b, int threads = 0);
+// Вариант с готовыми буферами: короткие цепочки решаются без выделения памяти
+void solveTridiagonalParallel(const TridiagonalMatrix& T, const std::vector<double>& b,
+    std::vector<double>& x, std::vector<double>& sweep, int threads = 0);
+
+// Наборы инструкций ядра пакетной прогонки
+enum class BatchInstructionSet { Scalar, Avx2, Avx512 };
+
+// Пакет из count независимых цепочек одинакового размера. Коэффициенты
+// чередуются по моделям (элемент строки i модели m лежит в [i * stride + m]),
+// поэтому прогонка идет сразу по всем моделям: одна SIMD-дорожка на модель.
+// Пакет — для моделей с разной жесткостью. Варианты нагрузки одной модели
+// (температурные и другие) через него не считаются: матрица у них общая, и
+// решение линейно по нагрузке — хватает одного разложения и суперпозиции
+class TridiagonalBatch {
+public:
+    TridiagonalBatch(int size, int count);
+
+    int size() const { return m_size; }
+    int count() const { return m_count; }
+
+    void setModel(int model, const TridiagonalMatrix& T, const std::vector<double>& b);
+    // Диагонали прямо из собранной матрицы, без промежуточной копии; false,
+    // если в A есть элементы вне трех диагоналей (дорожка тогда заполнена не вся)
+    bool setModel(int model, const SparseMatrix& A, const std::vector<double>& b);
+    void solve();
+    // То же заданным ядром — для сверки ядер между собой; набор должен
+    // поддерживаться процессором
+    void solve(BatchInstructionSet set);
+    std::vector<double> solution(int model) const;
+
+    // Набор инструкций ядра прогонки, выбранный по процессору при запуске
+    static const char* instructionSet();
+    static bool supports(BatchInstructionSet set);
+
+private:
+    int m_size;
+    int m_count;
+    int m_stride;   // count, округленный до 8 дорожек AVX-512; хвост — тождественные уравнения
+    std::vector<double> m_lower, m_diag, m_upper, m_rhs;
+    std::vector<double> m_x;
+    std::vector<double> m_c;   // прогоночные коэффициенты одной группы моделей
+};